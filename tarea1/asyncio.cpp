@@ -0,0 +1,926 @@
+#include "asyncio.h"
+#include "checkpoint.h"
+#include "tempstorage.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+// Este archivo se compila con -std=c++20 (corrutinas); asyncio.h se mantiene en C++17
+
+namespace {
+
+/**
+ * @brief Una lectura o escritura en vuelo
+ *
+ * Vive dentro del marco de la corrutina que la espera, así que su dirección es
+ * estable hasta que se completa.
+ */
+struct IoRequest {
+    int fd = -1;
+    bool write = false;
+    char* data = nullptr;
+    size_t bytes = 0;
+    uint64_t offset = 0;
+    int device = -1;
+    size_t done = 0;      ///< Bytes ya transferidos (una escritura parcial se reenvía)
+    long result = 0;      ///< Resultado de la última operación (negativo: -errno)
+    std::coroutine_handle<> waiter;
+};
+
+/**
+ * @brief Mecanismo que ejecuta las operaciones
+ */
+class Backend {
+public:
+    virtual ~Backend() = default;
+    /** @brief Envía la parte pendiente de una operación (data + done) */
+    virtual void submit(IoRequest* request) = 0;
+    /** @brief Bloquea hasta que se complete al menos una operación y las agrega a completed */
+    virtual void reap(std::vector<IoRequest*>& completed) = 0;
+};
+
+/**
+ * @brief pread/pwrite bloqueantes repartidos en un pool de hilos
+ */
+class ThreadPoolBackend : public Backend {
+public:
+    explicit ThreadPoolBackend(size_t threads) {
+        for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ThreadPoolBackend() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        pendingChanged.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void submit(IoRequest* request) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.push_back(request);
+        }
+        pendingChanged.notify_one();
+    }
+
+    void reap(std::vector<IoRequest*>& out) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        completedChanged.wait(lock, [this] { return !completed.empty(); });
+        out.insert(out.end(), completed.begin(), completed.end());
+        completed.clear();
+    }
+
+private:
+    void work() {
+        while (true) {
+            IoRequest* request;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                pendingChanged.wait(lock, [this] { return stopping || !pending.empty(); });
+                if (pending.empty()) return;
+                request = pending.front();
+                pending.pop_front();
+            }
+
+            char* data = request->data + request->done;
+            size_t bytes = request->bytes - request->done;
+            off_t offset = static_cast<off_t>(request->offset + request->done);
+            ssize_t result = request->write ? ::pwrite(request->fd, data, bytes, offset)
+                                            : ::pread(request->fd, data, bytes, offset);
+            request->result = result < 0 ? -errno : result;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                completed.push_back(request);
+            }
+            completedChanged.notify_one();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable pendingChanged;
+    std::condition_variable completedChanged;
+    std::deque<IoRequest*> pending;
+    std::vector<IoRequest*> completed;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
+
+#ifdef __linux__
+/**
+ * @brief io_uring con llamadas al sistema directas (sin liburing)
+ *
+ * Las operaciones se escriben en el anillo de envío y se entregan al kernel en la
+ * siguiente llamada a reap(), que además espera al menos una completación.
+ */
+class UringBackend : public Backend {
+public:
+    explicit UringBackend(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        ring = static_cast<int>(::syscall(__NR_io_uring_setup, std::max(entries, 2u), &params));
+        if (ring < 0) {
+            throw std::system_error(errno, std::generic_category(), "io_uring_setup");
+        }
+
+        sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) {
+            sqRingBytes = cqRingBytes = std::max(sqRingBytes, cqRingBytes);
+        }
+
+        sqRing = map(sqRingBytes, IORING_OFF_SQ_RING);
+        cqRing = single ? sqRing : map(cqRingBytes, IORING_OFF_CQ_RING);
+        sqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(map(sqesBytes, IORING_OFF_SQES));
+
+        char* sq = static_cast<char*>(sqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sqEntries = params.sq_entries;
+
+        char* cq = static_cast<char*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    }
+
+    ~UringBackend() override {
+        if (sqes) ::munmap(sqes, sqesBytes);
+        if (cqRing && cqRing != sqRing) ::munmap(cqRing, cqRingBytes);
+        if (sqRing) ::munmap(sqRing, sqRingBytes);
+        if (ring >= 0) ::close(ring);
+    }
+
+    void submit(IoRequest* request) override {
+        unsigned tail = *sqTail;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+            enter(0);
+        }
+
+        unsigned index = tail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = request->write ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe.fd = request->fd;
+        sqe.addr = reinterpret_cast<uint64_t>(request->data + request->done);
+        sqe.len = static_cast<unsigned>(request->bytes - request->done);
+        sqe.off = request->offset + request->done;
+        sqe.user_data = reinterpret_cast<uint64_t>(request);
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        toSubmit++;
+    }
+
+    void reap(std::vector<IoRequest*>& out) override {
+        size_t before = out.size();
+        while (out.size() == before) {
+            enter(1);
+
+            unsigned head = *cqHead;
+            unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                const io_uring_cqe& cqe = cqes[head & cqMask];
+                IoRequest* request = reinterpret_cast<IoRequest*>(cqe.user_data);
+                request->result = cqe.res;
+                out.push_back(request);
+            }
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        }
+    }
+
+private:
+    void* map(size_t bytes, off_t offset) {
+        void* address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, offset);
+        if (address == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "io_uring mmap");
+        }
+        return address;
+    }
+
+    /** @brief Entrega las operaciones escritas y espera minComplete completaciones */
+    void enter(unsigned minComplete) {
+        while (true) {
+            long submitted = ::syscall(__NR_io_uring_enter, ring, toSubmit, minComplete,
+                                       minComplete ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (submitted >= 0) {
+                toSubmit -= std::min<unsigned>(toSubmit, static_cast<unsigned>(submitted));
+                return;
+            }
+            if (errno != EINTR) {
+                throw std::system_error(errno, std::generic_category(), "io_uring_enter");
+            }
+        }
+    }
+
+    int ring = -1;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    size_t sqRingBytes = 0;
+    size_t cqRingBytes = 0;
+    size_t sqesBytes = 0;
+    io_uring_sqe* sqes = nullptr;
+    io_uring_cqe* cqes = nullptr;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned cqMask = 0;
+    unsigned sqEntries = 0;
+    unsigned toSubmit = 0;
+};
+#endif
+
+/**
+ * @brief Corrutina lanzada en un EventLoop
+ *
+ * Comienza suspendida (el bucle la reanuda) y queda suspendida al terminar, para
+ * que el bucle revise si terminó con una excepción antes de destruirla.
+ */
+struct Task {
+    struct promise_type {
+        std::exception_ptr error;
+
+        Task get_return_object() { return Task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+class EventLoop;
+
+/**
+ * @brief Evento que una corrutina puede esperar (p. ej. "bloque listo", "buffer libre")
+ *
+ * set() reanuda (a través del bucle) a la corrutina que lo espera; un evento ya
+ * marcado no suspende hasta que se llame a reset().
+ */
+class Event {
+public:
+    explicit Event(EventLoop& loop) : loop(&loop) {}
+
+    void set();
+    void reset() { signaled = false; }
+
+    /**
+     * @brief Espera del evento; guarda un puntero para que co_await nunca trabaje
+     *        sobre una copia del evento
+     */
+    struct Awaiter {
+        Event* event;
+
+        bool await_ready() const noexcept { return event->signaled; }
+        void await_suspend(std::coroutine_handle<> handle) noexcept { event->waiter = handle; }
+        void await_resume() const noexcept {}
+    };
+
+    Awaiter operator co_await() noexcept { return Awaiter{this}; }
+
+private:
+    EventLoop* loop;
+    bool signaled = false;
+    std::coroutine_handle<> waiter;
+};
+
+/**
+ * @brief Bucle de eventos de un solo hilo sobre un Backend
+ *
+ * Reanuda las corrutinas listas; cuando ninguna puede avanzar, espera
+ * completaciones del mecanismo y reanuda a quienes las esperaban. Cada dispositivo
+ * (índice de IOStats::devices, más una cola para los archivos fuera de ellos) tiene
+ * su propia cola: nunca hay más de queueDepth operaciones en vuelo por dispositivo,
+ * y las demás esperan turno en orden detrás de las de su mismo dispositivo.
+ */
+class EventLoop {
+public:
+    EventLoop(const AsyncIOOptions& options, IOStats& stats)
+        : queueDepth(std::max<size_t>(options.queueDepth, 1)), stats(stats), queues(stats.devices.size() + 1) {
+        for (size_t i = 0; i < queues.size(); ++i) {
+            queues[i].report.device = static_cast<int>(i) - 1;
+        }
+#ifdef __linux__
+        if (options.backend == AsyncBackend::IO_URING && ioUringAvailable()) {
+            size_t entries = std::min<size_t>(queueDepth * queues.size(), 4096);
+            backend = std::make_unique<UringBackend>(static_cast<unsigned>(entries));
+            report.backend = AsyncBackend::IO_URING;
+        }
+#endif
+        if (!backend) {
+            backend = std::make_unique<ThreadPoolBackend>(options.threads);
+            report.backend = AsyncBackend::THREAD_POOL;
+        }
+    }
+
+    ~EventLoop() {
+        backend.reset();
+        for (auto handle : tasks) {
+            handle.destroy();
+        }
+    }
+
+    /** @brief Agrega una corrutina; empieza a correr en run() */
+    void spawn(Task task) {
+        tasks.push_back(task.handle);
+        ready.push_back(task.handle);
+    }
+
+    /** @brief Marca una corrutina suspendida como lista */
+    void schedule(std::coroutine_handle<> handle) { ready.push_back(handle); }
+
+    /**
+     * @brief Operación que una corrutina espera con co_await
+     */
+    struct Operation {
+        EventLoop& loop;
+        IoRequest request;
+
+        bool await_ready() const noexcept { return request.bytes == 0; }
+        void await_suspend(std::coroutine_handle<> handle) {
+            request.waiter = handle;
+            loop.submit(&request);
+        }
+        size_t await_resume() const {
+            if (request.result < 0) {
+                throw std::system_error(static_cast<int>(-request.result), std::generic_category(),
+                                        request.write ? "escritura asíncrona" : "lectura asíncrona");
+            }
+            return request.done;
+        }
+    };
+
+    Operation read(int fd, void* data, size_t bytes, uint64_t offset, int device) {
+        return operation(fd, false, data, bytes, offset, device);
+    }
+
+    Operation write(int fd, const void* data, size_t bytes, uint64_t offset, int device) {
+        return operation(fd, true, const_cast<void*>(data), bytes, offset, device);
+    }
+
+    /**
+     * @brief Corre hasta que todas las corrutinas terminen
+     *
+     * @throw La primera excepción de una corrutina, o std::runtime_error si quedan
+     *        corrutinas esperando eventos que nadie marcará
+     */
+    void run() {
+        auto began = std::chrono::steady_clock::now();
+        std::vector<IoRequest*> completed;
+
+        while (true) {
+            while (!ready.empty()) {
+                std::coroutine_handle<> handle = ready.front();
+                ready.pop_front();
+                handle.resume();
+            }
+            if (inflight == 0) break;
+
+            completed.clear();
+            backend->reap(completed);
+            for (IoRequest* request : completed) {
+                inflight--;
+                queueOf(request).inflight--;
+                complete(request);
+            }
+            for (DeviceQueue& queue : queues) {
+                while (!queue.waiting.empty() && queue.inflight < queueDepth) {
+                    start(queue.waiting.front());
+                    queue.waiting.pop_front();
+                }
+            }
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - began;
+        report.seconds += elapsed.count();
+        report.queues.clear();
+        for (const DeviceQueue& queue : queues) {
+            if (queue.report.requests > 0) report.queues.push_back(queue.report);
+        }
+
+        for (auto handle : tasks) {
+            if (handle.promise().error) std::rethrow_exception(handle.promise().error);
+        }
+        for (auto handle : tasks) {
+            if (!handle.done()) throw std::runtime_error("I/O asíncrona bloqueada: corrutinas esperando eventos");
+        }
+    }
+
+    /**
+     * @brief Lanza SortCancelled si stats.cancel pidió cancelar
+     *
+     * Las corrutinas lectoras lo llaman antes de cada bloque. La excepción queda en
+     * la corrutina y run() la relanza cuando terminan las operaciones en vuelo.
+     */
+    void checkCancelled() const {
+        if (stats.cancel && stats.cancel->cancelled()) throw SortCancelled();
+    }
+
+    AsyncIOReport report;
+
+private:
+    friend struct Operation;
+
+    Operation operation(int fd, bool write, void* data, size_t bytes, uint64_t offset, int device) {
+        Operation op{*this, IoRequest()};
+        op.request.fd = fd;
+        op.request.write = write;
+        op.request.data = static_cast<char*>(data);
+        op.request.bytes = bytes;
+        op.request.offset = offset;
+        op.request.device = device;
+        return op;
+    }
+
+    /**
+     * @brief Cola de envío de un dispositivo
+     */
+    struct DeviceQueue {
+        size_t inflight = 0;
+        std::deque<IoRequest*> waiting;
+        AsyncQueueReport report;
+    };
+
+    DeviceQueue& queueOf(const IoRequest* request) {
+        size_t index = static_cast<size_t>(request->device + 1);
+        return queues[index < queues.size() ? index : 0];
+    }
+
+    void submit(IoRequest* request) {
+        DeviceQueue& queue = queueOf(request);
+        if (queue.inflight < queueDepth) {
+            start(request);
+        } else {
+            queue.waiting.push_back(request);
+        }
+    }
+
+    void start(IoRequest* request) {
+        DeviceQueue& queue = queueOf(request);
+        inflight++;
+        queue.inflight++;
+        report.requests++;
+        report.depthSum += inflight;
+        report.maxQueueDepth = std::max(report.maxQueueDepth, inflight);
+        queue.report.requests++;
+        queue.report.depthSum += queue.inflight;
+        queue.report.maxQueueDepth = std::max(queue.report.maxQueueDepth, queue.inflight);
+        backend->submit(request);
+    }
+
+    void complete(IoRequest* request) {
+        if (request->result > 0) {
+            size_t bytes = static_cast<size_t>(request->result);
+            request->done += bytes;
+            report.bytes += bytes;
+            if (stats.progress) stats.progress->add(bytes, request->write);
+
+            size_t blocks = (bytes + B - 1) / B;
+            (request->write ? stats.writes : stats.reads) += blocks;
+            if (request->device >= 0) {
+                DeviceStats& device = stats.devices[request->device];
+                (request->write ? device.writes : device.reads) += blocks;
+            }
+
+            // Una escritura parcial se reenvía por el resto
+            if (request->write && request->done < request->bytes) {
+                report.requests--;
+                queueOf(request).report.requests--;
+                start(request);
+                return;
+            }
+        } else if (request->result == 0 && request->write && request->done < request->bytes) {
+            request->result = -EIO;
+        }
+        schedule(request->waiter);
+    }
+
+    size_t queueDepth;
+    IOStats& stats;
+    std::vector<std::coroutine_handle<Task::promise_type>> tasks;
+    std::unique_ptr<Backend> backend;
+    std::deque<std::coroutine_handle<>> ready;
+    std::vector<DeviceQueue> queues;  ///< queues[device + 1]; la 0 es la de los archivos sin dispositivo
+    size_t inflight = 0;
+};
+
+void Event::set() {
+    signaled = true;
+    if (waiter) {
+        std::coroutine_handle<> handle = waiter;
+        waiter = nullptr;
+        loop->schedule(handle);
+    }
+}
+
+/**
+ * @brief Abre un archivo o lanza std::system_error
+ */
+int openFile(const std::string& path, int flags) {
+    int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "abrir " + path);
+    }
+    return fd;
+}
+
+/**
+ * @brief Archivo leído secuencialmente con dos buffers
+ */
+struct InputStream {
+    explicit InputStream(EventLoop& loop) : ready{Event(loop), Event(loop)}, free{Event(loop), Event(loop)} {
+        free[0].set();
+        free[1].set();
+    }
+
+    int fd = -1;
+    int device = -1;
+    uint64_t offset = 0;     ///< Próximo byte a leer
+    uint64_t consumed = 0;   ///< Bytes ya entregados a la mezcla
+    uint64_t released = 0;   ///< Bytes ya liberados con TempStorage::releaseRange
+    std::vector<int64_t> buffers[2];
+    size_t filled[2] = {0, 0};
+    Event ready[2];          ///< El buffer tiene datos (filled == 0: fin del archivo)
+    Event free[2];           ///< El buffer puede volver a llenarse
+};
+
+/**
+ * @brief Archivo escrito secuencialmente con dos buffers
+ */
+struct OutputStream {
+    explicit OutputStream(EventLoop& loop) : full{Event(loop), Event(loop)}, free{Event(loop), Event(loop)} {
+        free[0].set();
+        free[1].set();
+    }
+
+    int fd = -1;
+    int device = -1;
+    uint64_t offset = 0;
+    std::vector<int64_t> buffers[2];
+    Event full[2];           ///< El buffer debe escribirse (vacío: fin)
+    Event free[2];           ///< La escritura del buffer terminó
+};
+
+/**
+ * @brief Archivo de una partición: a lo más una escritura en vuelo
+ */
+struct PartitionStream {
+    explicit PartitionStream(EventLoop& loop) : full(loop), free(loop) { free.set(); }
+
+    int fd = -1;
+    int device = -1;
+    uint64_t offset = 0;
+    bool closing = false;
+    std::vector<int64_t> writing;
+    Event full;
+    Event free;
+};
+
+/**
+ * @brief Corrutina lectora: llena los dos buffers por turnos mientras estén libres
+ */
+Task readStream(EventLoop& loop, InputStream& input, size_t blockElements) {
+    for (size_t slot = 0;; slot ^= 1) {
+        co_await input.free[slot];
+        input.free[slot].reset();
+        loop.checkCancelled();
+
+        input.buffers[slot].resize(blockElements);
+        size_t bytes = co_await loop.read(input.fd, input.buffers[slot].data(), blockElements * sizeof(int64_t),
+                                          input.offset, input.device);
+        input.offset += bytes;
+        input.filled[slot] = bytes / sizeof(int64_t);
+        input.ready[slot].set();
+        if (bytes == 0) co_return;
+    }
+}
+
+/**
+ * @brief Corrutina escritora: escribe los buffers llenos en orden hasta recibir uno vacío
+ */
+Task writeStream(EventLoop& loop, OutputStream& output) {
+    for (size_t slot = 0;; slot ^= 1) {
+        co_await output.full[slot];
+        output.full[slot].reset();
+        if (output.buffers[slot].empty()) co_return;
+
+        size_t bytes = output.buffers[slot].size() * sizeof(int64_t);
+        co_await loop.write(output.fd, output.buffers[slot].data(), bytes, output.offset, output.device);
+        output.offset += bytes;
+        output.buffers[slot].clear();
+        output.free[slot].set();
+    }
+}
+
+/**
+ * @brief Corrutina de mezcla: espera "bloque listo" de cada run al agotar su buffer
+ */
+Task mergeStreams(std::vector<InputStream>& inputs, OutputStream& output, size_t outputCapacity,
+                  bool dropDuplicates, bool releaseInputs, uint64_t& checksum) {
+    using Node = std::pair<int64_t, size_t>;
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> heap;
+    std::vector<size_t> slots(inputs.size(), 0);
+    std::vector<size_t> positions(inputs.size(), 0);
+
+    for (size_t j = 0; j < inputs.size(); ++j) {
+        co_await inputs[j].ready[0];
+        if (inputs[j].filled[0] > 0) heap.push({inputs[j].buffers[0][0], j});
+    }
+
+    size_t current = 0;
+    co_await output.free[current];
+    output.free[current].reset();
+
+    bool hasLast = false;
+    int64_t last = 0;
+    while (!heap.empty()) {
+        auto [value, j] = heap.top();
+        heap.pop();
+
+        if (!dropDuplicates || !hasLast || value != last) {
+            output.buffers[current].push_back(value);
+            checksum = checksumValue(checksum, value);
+            hasLast = true;
+            last = value;
+
+            if (output.buffers[current].size() >= outputCapacity) {
+                output.full[current].set();
+                current ^= 1;
+                co_await output.free[current];
+                output.free[current].reset();
+            }
+        }
+
+        InputStream& input = inputs[j];
+        if (++positions[j] >= input.filled[slots[j]]) {
+            // Buffer agotado: se devuelve a la lectora y se espera el otro
+            input.consumed += input.filled[slots[j]] * sizeof(int64_t);
+            if (releaseInputs && TempStorage::releaseRange(input.fd, input.released, input.consumed - input.released)) {
+                input.released = input.consumed;
+            }
+            input.ready[slots[j]].reset();
+            input.free[slots[j]].set();
+            slots[j] ^= 1;
+            positions[j] = 0;
+
+            co_await input.ready[slots[j]];
+            if (input.filled[slots[j]] == 0) continue;
+        }
+        heap.push({input.buffers[slots[j]][positions[j]], j});
+    }
+
+    // Último buffer parcial y luego uno vacío para terminar la escritora
+    if (!output.buffers[current].empty()) {
+        output.full[current].set();
+        current ^= 1;
+        co_await output.free[current];
+        output.free[current].reset();
+    }
+    output.full[current].set();
+}
+
+/**
+ * @brief Corrutina escritora de una partición
+ */
+Task writePartition(EventLoop& loop, PartitionStream& partition) {
+    while (true) {
+        co_await partition.full;
+        partition.full.reset();
+        if (partition.closing) co_return;
+
+        size_t bytes = partition.writing.size() * sizeof(int64_t);
+        co_await loop.write(partition.fd, partition.writing.data(), bytes, partition.offset, partition.device);
+        partition.offset += bytes;
+        partition.writing.clear();
+        partition.free.set();
+    }
+}
+
+/**
+ * @brief Corrutina de distribución: clasifica cada bloque y entrega cada parte a su escritora
+ */
+Task distributeStream(InputStream& input, std::vector<PartitionStream>& partitions,
+                      const std::function<void(const std::vector<int64_t>&, std::vector<std::vector<int64_t>>&)>& classify) {
+    std::vector<std::vector<int64_t>> staging(partitions.size());
+
+    for (size_t slot = 0;; slot ^= 1) {
+        co_await input.ready[slot];
+        input.ready[slot].reset();
+        if (input.filled[slot] == 0) break;
+
+        input.buffers[slot].resize(input.filled[slot]);
+        classify(input.buffers[slot], staging);
+        input.free[slot].set();
+
+        for (size_t i = 0; i < partitions.size(); ++i) {
+            if (staging[i].empty()) continue;
+            co_await partitions[i].free;
+            partitions[i].free.reset();
+            std::swap(partitions[i].writing, staging[i]);
+            staging[i].clear();
+            partitions[i].full.set();
+        }
+    }
+
+    for (auto& partition : partitions) {
+        co_await partition.free;
+        partition.closing = true;
+        partition.full.set();
+    }
+}
+
+/**
+ * @brief Cierra los descriptores al salir (también si hubo una excepción)
+ */
+struct FdGuard {
+    std::vector<int> fds;
+    ~FdGuard() {
+        for (int fd : fds) {
+            if (fd >= 0) ::close(fd);
+        }
+    }
+};
+
+}  // namespace
+
+bool ioUringAvailable() {
+#ifdef __linux__
+    static const bool available = [] {
+        try {
+            UringBackend probe(2);
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }();
+    return available;
+#else
+    return false;
+#endif
+}
+
+AsyncBackend defaultAsyncBackend() {
+    return ioUringAvailable() ? AsyncBackend::IO_URING : AsyncBackend::THREAD_POOL;
+}
+
+const char* asyncBackendName(AsyncBackend backend) {
+    return backend == AsyncBackend::IO_URING ? "io_uring" : "thread-pool";
+}
+
+void AsyncIOReport::add(const AsyncIOReport& other) {
+    backend = other.backend;
+    streams = std::max(streams, other.streams);
+    requests += other.requests;
+    bytes += other.bytes;
+    maxQueueDepth = std::max(maxQueueDepth, other.maxQueueDepth);
+    depthSum += other.depthSum;
+    seconds += other.seconds;
+
+    for (const AsyncQueueReport& otherQueue : other.queues) {
+        auto it = std::find_if(queues.begin(), queues.end(),
+                               [&](const AsyncQueueReport& queue) { return queue.device == otherQueue.device; });
+        if (it == queues.end()) {
+            queues.push_back(otherQueue);
+            continue;
+        }
+        it->requests += otherQueue.requests;
+        it->maxQueueDepth = std::max(it->maxQueueDepth, otherQueue.maxQueueDepth);
+        it->depthSum += otherQueue.depthSum;
+    }
+}
+
+const AsyncQueueReport* AsyncIOReport::queue(int device) const {
+    for (const AsyncQueueReport& q : queues) {
+        if (q.device == device) return &q;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Mezcla archivos ordenados con lecturas y escrituras asíncronas
+ *
+ * @param runFiles Archivos ordenados a mezclar
+ * @param outputFilename Archivo de salida
+ * @param bufferSize Elementos por run y para la salida (se dividen en dos buffers)
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param dropDuplicates Si es true, cada clave se escribe una sola vez
+ * @param releaseInputs Si es true, libera los bloques de las entradas a medida que se mezclan
+ * @param options Mecanismo y profundidad de cola
+ * @param report Si no es nulo, acumula throughput y profundidad de cola
+ * @return uint64_t Checksum de lo escrito
+ */
+uint64_t asyncMergeRuns(const std::vector<std::string>& runFiles, const std::string& outputFilename,
+                        size_t bufferSize, IOStats& stats, bool dropDuplicates, bool releaseInputs,
+                        const AsyncIOOptions& options, AsyncIOReport* report) {
+    size_t blockElements = std::max<size_t>(bufferSize / 2, 1);
+    EventLoop loop(options, stats);
+    FdGuard guard;
+
+    std::vector<InputStream> inputs;
+    inputs.reserve(runFiles.size());
+    for (const auto& file : runFiles) {
+        inputs.emplace_back(loop);
+        inputs.back().fd = openFile(file, releaseInputs ? O_RDWR : O_RDONLY);
+        inputs.back().device = stats.deviceOf(file);
+        guard.fds.push_back(inputs.back().fd);
+    }
+
+    OutputStream output(loop);
+    output.fd = openFile(outputFilename, O_WRONLY | O_CREAT | O_TRUNC);
+    output.device = stats.deviceOf(outputFilename);
+    guard.fds.push_back(output.fd);
+    output.buffers[0].reserve(blockElements);
+    output.buffers[1].reserve(blockElements);
+
+    uint64_t checksum = CHECKSUM_SEED;
+    for (auto& input : inputs) {
+        loop.spawn(readStream(loop, input, blockElements));
+    }
+    loop.spawn(mergeStreams(inputs, output, blockElements, dropDuplicates, releaseInputs, checksum));
+    loop.spawn(writeStream(loop, output));
+    loop.run();
+
+    if (report) {
+        loop.report.streams = runFiles.size();
+        report->add(loop.report);
+    }
+    return checksum;
+}
+
+/**
+ * @brief Reparte un archivo entre varios de salida con lecturas y escrituras asíncronas
+ *
+ * @param inputFilename Archivo de entrada
+ * @param outputFilenames Archivos de salida (se truncan)
+ * @param bufferSize Elementos de memoria disponibles
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param options Mecanismo y profundidad de cola
+ * @param classify Agrega cada elemento de un bloque al buffer de su salida
+ * @param report Si no es nulo, acumula throughput y profundidad de cola
+ */
+void asyncDistribute(const std::string& inputFilename, const std::vector<std::string>& outputFilenames,
+                     size_t bufferSize, IOStats& stats, const AsyncIOOptions& options,
+                     const std::function<void(const std::vector<int64_t>&, std::vector<std::vector<int64_t>>&)>& classify,
+                     AsyncIOReport* report) {
+    // Dos bloques de entrada, lo clasificado y lo que está en vuelo caben en bufferSize
+    size_t blockElements = std::max<size_t>(bufferSize / 4, 1);
+    EventLoop loop(options, stats);
+    FdGuard guard;
+
+    InputStream input(loop);
+    input.fd = openFile(inputFilename, O_RDONLY);
+    input.device = stats.deviceOf(inputFilename);
+    guard.fds.push_back(input.fd);
+
+    std::vector<PartitionStream> partitions;
+    partitions.reserve(outputFilenames.size());
+    for (const auto& file : outputFilenames) {
+        partitions.emplace_back(loop);
+        partitions.back().fd = openFile(file, O_WRONLY | O_CREAT | O_TRUNC);
+        partitions.back().device = stats.deviceOf(file);
+        guard.fds.push_back(partitions.back().fd);
+    }
+
+    loop.spawn(readStream(loop, input, blockElements));
+    loop.spawn(distributeStream(input, partitions, classify));
+    for (auto& partition : partitions) {
+        loop.spawn(writePartition(loop, partition));
+    }
+    loop.run();
+
+    if (report) {
+        loop.report.streams = outputFilenames.size();
+        report->add(loop.report);
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef ASYNCIO_H
+#define ASYNCIO_H
+
+#include "iostats.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Mecanismo que ejecuta las lecturas y escrituras asíncronas
+ */
+enum class AsyncBackend {
+    THREAD_POOL,  ///< pread/pwrite bloqueantes en un pool de hilos
+    IO_URING      ///< io_uring de Linux (llamadas al sistema directas, sin liburing)
+};
+
+/**
+ * @brief true si el kernel permite crear un anillo de io_uring
+ *
+ * @note Se comprueba una sola vez, en la primera llamada
+ */
+bool ioUringAvailable();
+
+/**
+ * @brief Mejor mecanismo disponible: io_uring si existe, si no el pool de hilos
+ */
+AsyncBackend defaultAsyncBackend();
+
+/**
+ * @brief Nombre legible de un mecanismo
+ */
+const char* asyncBackendName(AsyncBackend backend);
+
+/**
+ * @brief Opciones de la capa de I/O asíncrona
+ */
+struct AsyncIOOptions {
+    bool enabled = false;                           ///< Usar la capa asíncrona en las mezclas y particiones
+    AsyncBackend backend = defaultAsyncBackend();   ///< Si io_uring no está disponible se usa el pool de hilos
+    size_t threads = 4;                             ///< Hilos del pool (THREAD_POOL)
+    size_t queueDepth = 256;                        ///< Máximo de operaciones en vuelo por dispositivo
+};
+
+/**
+ * @brief Cola de envío de un dispositivo (directorio temporal de IOStats::devices)
+ */
+struct AsyncQueueReport {
+    int device = -1;           ///< Índice en IOStats::devices (-1: archivos fuera de los directorios registrados)
+    size_t requests = 0;       ///< Lecturas y escrituras enviadas desde esta cola
+    size_t maxQueueDepth = 0;  ///< Máximo de operaciones en vuelo del dispositivo
+    size_t depthSum = 0;       ///< Suma de las profundidades medidas (para el promedio)
+
+    /** @brief Profundidad de cola promedio */
+    double meanQueueDepth() const { return requests ? static_cast<double>(depthSum) / requests : 0; }
+};
+
+/**
+ * @brief Throughput y profundidad de cola observados por la capa asíncrona
+ *
+ * La profundidad se mide cada vez que se envía una operación (cuántas quedan en
+ * vuelo contando la nueva): en total y en la cola de su dispositivo.
+ */
+struct AsyncIOReport {
+    AsyncBackend backend = AsyncBackend::THREAD_POOL;  ///< Mecanismo usado
+    size_t streams = 0;        ///< Mayor cantidad de flujos (runs o particiones) de una operación
+    size_t requests = 0;       ///< Lecturas y escrituras enviadas
+    size_t bytes = 0;          ///< Bytes transferidos
+    size_t maxQueueDepth = 0;  ///< Máximo de operaciones en vuelo, sumando todos los dispositivos
+    size_t depthSum = 0;       ///< Suma de las profundidades medidas (para el promedio)
+    double seconds = 0;        ///< Tiempo dentro de las operaciones asíncronas
+    std::vector<AsyncQueueReport> queues;  ///< Una entrada por dispositivo usado, en orden de aparición
+
+    /**
+     * @brief Cola de un dispositivo
+     * @return nullptr si ninguna operación usó ese dispositivo
+     */
+    const AsyncQueueReport* queue(int device) const;
+
+    /** @brief Profundidad de cola promedio */
+    double meanQueueDepth() const { return requests ? static_cast<double>(depthSum) / requests : 0; }
+
+    /** @brief MB/s transferidos */
+    double megabytesPerSecond() const { return seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0; }
+
+    /** @brief Acumula el reporte de otra operación */
+    void add(const AsyncIOReport& other);
+};
+
+/**
+ * @brief Mezcla archivos ordenados con lecturas y escrituras asíncronas
+ *
+ * Equivalente a mergeRuns (mergesort.h). Cada run tiene una corrutina lectora con
+ * dos buffers: mientras la mezcla consume uno, la lectura del siguiente bloque ya
+ * está en vuelo. La mezcla es otra corrutina que espera el evento "bloque listo"
+ * del run que agotó su buffer, y una corrutina escritora vacía la salida, también
+ * con dos buffers. Un único bucle de eventos reanuda las corrutinas a medida que
+ * el mecanismo (pool de hilos o io_uring) completa operaciones. Cada dispositivo
+ * (directorio de IOStats::devices) tiene su propia cola de envío, así que las
+ * lecturas de un disco no esperan detrás de las escrituras a otro.
+ *
+ * @param runFiles Archivos ordenados a mezclar
+ * @param outputFilename Archivo de salida
+ * @param bufferSize Elementos por run (y para la salida); se dividen en dos buffers
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param dropDuplicates Si es true, cada clave se escribe una sola vez
+ * @param releaseInputs Si es true, libera los bloques de las entradas a medida que se mezclan
+ * @param options Mecanismo y profundidad de cola
+ * @param report Si no es nulo, acumula throughput y profundidad de cola
+ * @return uint64_t Checksum (ver checkpoint.h) de lo escrito
+ *
+ * @throw std::system_error si una lectura o escritura falla
+ * @throw SortCancelled si stats.cancel pidió cancelar (tras terminar las operaciones en vuelo)
+ */
+uint64_t asyncMergeRuns(const std::vector<std::string>& runFiles, const std::string& outputFilename,
+                        size_t bufferSize, IOStats& stats, bool dropDuplicates, bool releaseInputs,
+                        const AsyncIOOptions& options, AsyncIOReport* report = nullptr);
+
+/**
+ * @brief Reparte un archivo entre varios de salida con lecturas y escrituras asíncronas
+ *
+ * Una corrutina lectora mantiene el siguiente bloque de la entrada en vuelo mientras
+ * se clasifica el actual, y cada archivo de salida tiene una corrutina escritora con
+ * a lo más una escritura pendiente; la clasificación solo espera a la escritora de
+ * una partición si su escritura anterior aún no termina.
+ *
+ * @param inputFilename Archivo de entrada
+ * @param outputFilenames Archivos de salida (se truncan)
+ * @param bufferSize Elementos de memoria disponibles; la entrada se lee en bloques
+ *                   de bufferSize / 4 para que los buffers en vuelo quepan en ella
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param options Mecanismo y profundidad de cola
+ * @param classify Recibe cada bloque de la entrada y agrega cada elemento al buffer
+ *                 de su archivo de salida
+ * @param report Si no es nulo, acumula throughput y profundidad de cola
+ *
+ * @throw std::system_error si una lectura o escritura falla
+ * @throw SortCancelled si stats.cancel pidió cancelar (tras terminar las operaciones en vuelo)
+ */
+void asyncDistribute(const std::string& inputFilename, const std::vector<std::string>& outputFilenames,
+                     size_t bufferSize, IOStats& stats, const AsyncIOOptions& options,
+                     const std::function<void(const std::vector<int64_t>&, std::vector<std::vector<int64_t>>&)>& classify,
+                     AsyncIOReport* report = nullptr);
+
+#endif
@@ -0,0 +1,228 @@
+#include "checkpoint.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Agrega un bloque de elementos a un checksum acumulado
+ *
+ * @param checksum Checksum acumulado hasta ahora
+ * @param data Elementos en el orden en que se escriben
+ * @return uint64_t Checksum actualizado
+ */
+uint64_t checksumBlock(uint64_t checksum, const std::vector<int64_t>& data) {
+    for (int64_t value : data) {
+        checksum = checksumValue(checksum, value);
+    }
+    return checksum;
+}
+
+/**
+ * @brief Firma que identifica un ordenamiento reanudable
+ *
+ * @param algorithm Nombre del algoritmo
+ * @param inputFilename Archivo de entrada
+ * @param arity Aridad
+ * @param memoryLimit Límite de memoria en bytes
+ * @param options Opciones que afectan a los archivos temporales
+ * @return std::string Firma (ruta, tamaño y fecha de la entrada junto a los parámetros)
+ */
+std::string sortSignature(const std::string& algorithm, const std::string& inputFilename,
+                          size_t arity, size_t memoryLimit, const SortOptions& options) {
+    std::error_code error;
+    auto size = fs::file_size(inputFilename, error);
+    auto time = fs::last_write_time(inputFilename, error).time_since_epoch().count();
+
+    std::ostringstream out;
+    out << algorithm << " " << size << " " << time << " " << arity << " " << memoryLimit << " "
+        << static_cast<int>(options.op) << " " << options.adaptive << " " << inputFilename;
+    for (const auto& root : options.tempDirs) {
+        out << " " << root;
+    }
+    return out.str();
+}
+
+/**
+ * @brief Fuerza a disco el contenido de un archivo
+ *
+ * @param path Archivo a sincronizar
+ */
+static void syncFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+/**
+ * @brief Abre (o crea) el manifiesto del directorio temporal
+ *
+ * @param tempDir Directorio temporal del ordenamiento
+ * @param signature Firma de la entrada y los parámetros
+ * @param enabled Si es false el manifiesto no hace nada
+ * @param stopAfterSteps Si es mayor que 0, commit() lanza SortInterrupted tras ese número de commits
+ */
+SortManifest::SortManifest(const std::string& tempDir, const std::string& signature,
+                           bool enabled, size_t stopAfterSteps)
+    : manifestPath(tempDir + "/manifest.txt"), signature(signature),
+      active(enabled), stopAfterSteps(stopAfterSteps) {
+    if (!active) return;
+
+    std::ifstream file(manifestPath);
+    if (!file) return;
+
+    std::string line;
+    if (!std::getline(file, line) || line != "signature " + signature) {
+        std::cout << "Manifiesto de otra ejecución en " << tempDir << ", se descarta" << std::endl;
+        return;
+    }
+
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        std::string type;
+        in >> type;
+
+        if (type == "key") {
+            std::string key, value;
+            in >> key;
+            std::getline(in >> std::ws, value);
+            values[key] = value;
+        } else if (type == "file") {
+            FileRecord record;
+            in >> record.bytes >> record.checksum >> record.source;
+            std::getline(in >> std::ws, record.path);
+            files[record.path] = record;
+        }
+    }
+    loaded = true;
+}
+
+std::string SortManifest::get(const std::string& key, const std::string& fallback) const {
+    auto it = values.find(key);
+    return it == values.end() ? fallback : it->second;
+}
+
+void SortManifest::set(const std::string& key, const std::string& value) {
+    if (active) values[key] = value;
+}
+
+void SortManifest::erase(const std::string& key) {
+    values.erase(key);
+}
+
+/**
+ * @brief Registra bytes escritos al final de un archivo
+ *
+ * @param path Archivo escrito
+ * @param data Elementos agregados
+ * @param source Checksum del archivo del que se deriva
+ */
+void SortManifest::recordWrite(const std::string& path, const std::vector<int64_t>& data, uint64_t source) {
+    if (!active) return;
+
+    FileRecord& record = files[path];
+    record.path = path;
+    record.bytes += data.size() * sizeof(int64_t);
+    record.checksum = checksumBlock(record.checksum, data);
+    record.source = source;
+}
+
+void SortManifest::recordFile(const std::string& path, uint64_t bytes, uint64_t checksum, uint64_t source) {
+    if (!active) return;
+    files[path] = {path, bytes, checksum, source};
+}
+
+const FileRecord* SortManifest::record(const std::string& path) const {
+    auto it = files.find(path);
+    return it == files.end() ? nullptr : &it->second;
+}
+
+void SortManifest::forget(const std::string& path) {
+    files.erase(path);
+}
+
+/**
+ * @brief Comprueba que un archivo registrado esté intacto
+ *
+ * @param path Archivo a verificar
+ * @param bufferSize Elementos por lectura
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return true si el archivo existe y su checksum coincide
+ */
+bool SortManifest::verify(const std::string& path, size_t bufferSize, IOStats& stats) {
+    const FileRecord* rec = record(path);
+    if (!rec || !fs::exists(path) || fs::file_size(path) < rec->bytes) return false;
+
+    if (fs::file_size(path) > rec->bytes) {
+        fs::resize_file(path, rec->bytes);
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<int64_t> buffer;
+    uint64_t checksum = CHECKSUM_SEED;
+    while (readBlock(file, buffer, bufferSize, stats) > 0) {
+        checksum = checksumBlock(checksum, buffer);
+    }
+
+    return checksum == rec->checksum;
+}
+
+/**
+ * @brief Sincroniza también este archivo en cada commit()
+ *
+ * @param path Archivo a sincronizar
+ */
+void SortManifest::watch(const std::string& path) {
+    if (!active) return;
+    watched.push_back(path);
+}
+
+/**
+ * @brief Persiste el estado actual de forma atómica
+ *
+ * @note Antes del manifiesto se sincronizan los archivos registrados, de modo que
+ *       un registro nunca apunta a datos que no llegaron a disco
+ */
+void SortManifest::commit() {
+    if (!active) return;
+
+    for (const auto& [path, rec] : files) {
+        syncFile(path);
+    }
+    for (const auto& path : watched) {
+        syncFile(path);
+    }
+
+    std::string tmpPath = manifestPath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        out << "signature " << signature << "\n";
+        for (const auto& [key, value] : values) {
+            out << "key " << key << " " << value << "\n";
+        }
+        for (const auto& [path, rec] : files) {
+            out << "file " << rec.bytes << " " << rec.checksum << " " << rec.source << " " << path << "\n";
+        }
+    }
+    syncFile(tmpPath);
+    fs::rename(tmpPath, manifestPath);
+
+    steps++;
+    if (stopAfterSteps > 0 && steps >= stopAfterSteps) {
+        throw SortInterrupted("interrumpido tras " + std::to_string(steps) + " checkpoints");
+    }
+}
+
+/**
+ * @brief Descarta todo el estado (claves y registros)
+ */
+void SortManifest::clear() {
+    values.clear();
+    files.clear();
+    loaded = false;
+}
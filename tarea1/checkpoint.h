@@ -0,0 +1,175 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "iostats.h"
+#include "sortoptions.h"
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Valor inicial de los checksums (FNV-1a de 64 bits)
+ */
+constexpr uint64_t CHECKSUM_SEED = 1469598103934665603ULL;
+
+/**
+ * @brief Agrega un elemento a un checksum acumulado
+ *
+ * @param checksum Checksum acumulado hasta ahora
+ * @param value Elemento siguiente
+ * @return uint64_t Checksum actualizado
+ */
+inline uint64_t checksumValue(uint64_t checksum, int64_t value) {
+    return (checksum ^ static_cast<uint64_t>(value)) * 1099511628211ULL;
+}
+
+/**
+ * @brief Agrega un bloque de elementos a un checksum acumulado
+ *
+ * @param checksum Checksum acumulado hasta ahora
+ * @param data Elementos en el orden en que se escriben
+ * @return uint64_t Checksum actualizado
+ */
+uint64_t checksumBlock(uint64_t checksum, const std::vector<int64_t>& data);
+
+/**
+ * @brief Firma que identifica un ordenamiento reanudable
+ *
+ * @param algorithm Nombre del algoritmo
+ * @param inputFilename Archivo de entrada
+ * @param arity Aridad
+ * @param memoryLimit Límite de memoria en bytes
+ * @param options Opciones que afectan a los archivos temporales
+ * @return std::string Firma (ruta, tamaño y fecha de la entrada junto a los parámetros)
+ */
+std::string sortSignature(const std::string& algorithm, const std::string& inputFilename,
+                          size_t arity, size_t memoryLimit, const SortOptions& options);
+
+/**
+ * @brief Excepción usada para detener un ordenamiento dejando su estado temporal intacto
+ *
+ * La lanza SortManifest::commit() al alcanzar SortOptions::stopAfterSteps, lo que
+ * simula que el proceso murió justo después de ese checkpoint.
+ */
+class SortInterrupted : public std::runtime_error {
+public:
+    explicit SortInterrupted(const std::string& message) : std::runtime_error(message) {}
+};
+
+/**
+ * @brief Registro de un archivo temporal completo (o de su prefijo confirmado)
+ */
+struct FileRecord {
+    std::string path;               ///< Ruta del archivo
+    uint64_t bytes = 0;             ///< Bytes confirmados
+    uint64_t checksum = CHECKSUM_SEED;  ///< Checksum de esos bytes
+    uint64_t source = 0;            ///< Checksum del archivo del que se derivó (0 si es la entrada)
+};
+
+/**
+ * @brief Manifiesto durable del avance de un ordenamiento externo
+ *
+ * Guarda en [tempDir]/manifest.txt pares clave/valor con el estado del algoritmo
+ * y un FileRecord por cada archivo temporal confirmado. Cada commit() reescribe
+ * el manifiesto de forma atómica (archivo temporal + fsync + rename), de modo
+ * que tras una caída siempre queda el último estado consistente.
+ *
+ * Si el manifiesto existente fue creado para otra entrada u otros parámetros
+ * (firma distinta) se descarta y el ordenamiento comienza desde cero.
+ *
+ * @note Con enabled = false todas las operaciones son no-op y resumed() es false
+ */
+class SortManifest {
+public:
+    /**
+     * @brief Abre (o crea) el manifiesto del directorio temporal
+     *
+     * @param tempDir Directorio temporal del ordenamiento
+     * @param signature Firma de la entrada y los parámetros
+     * @param enabled Si es false el manifiesto no hace nada
+     * @param stopAfterSteps Si es mayor que 0, commit() lanza SortInterrupted tras ese número de commits
+     */
+    SortManifest(const std::string& tempDir, const std::string& signature,
+                 bool enabled, size_t stopAfterSteps = 0);
+
+    /** @brief true si se cargó un manifiesto previo con la misma firma */
+    bool resumed() const { return loaded; }
+
+    /** @brief true si el manifiesto está activo */
+    bool enabled() const { return active; }
+
+    /** @brief Obtiene el valor de una clave, o `fallback` si no existe */
+    std::string get(const std::string& key, const std::string& fallback = "") const;
+
+    /** @brief Asigna el valor de una clave (se persiste en el siguiente commit) */
+    void set(const std::string& key, const std::string& value);
+
+    /** @brief Elimina una clave */
+    void erase(const std::string& key);
+
+    /**
+     * @brief Registra bytes escritos al final de un archivo
+     *
+     * @param path Archivo escrito
+     * @param data Elementos agregados
+     * @param source Checksum del archivo del que se deriva
+     */
+    void recordWrite(const std::string& path, const std::vector<int64_t>& data, uint64_t source = 0);
+
+    /**
+     * @brief Registra un archivo completo cuyo checksum ya se conoce
+     */
+    void recordFile(const std::string& path, uint64_t bytes, uint64_t checksum, uint64_t source = 0);
+
+    /** @brief Registro de un archivo, o nullptr si no está registrado */
+    const FileRecord* record(const std::string& path) const;
+
+    /** @brief Elimina el registro de un archivo */
+    void forget(const std::string& path);
+
+    /**
+     * @brief Sincroniza también este archivo en cada commit()
+     *
+     * Para archivos que se escriben por tramos en distintas posiciones (la salida
+     * de Quicksort), cuyo avance se guarda en claves y no en un FileRecord.
+     */
+    void watch(const std::string& path);
+
+    /**
+     * @brief Comprueba que un archivo registrado esté intacto
+     *
+     * Si el archivo es más largo que lo confirmado (la caída ocurrió a mitad de
+     * una escritura) se trunca al largo registrado antes de calcular el checksum.
+     *
+     * @param path Archivo a verificar
+     * @param bufferSize Elementos por lectura
+     * @param stats Objeto para registrar estadísticas de I/O
+     * @return true si el archivo existe y su checksum coincide
+     */
+    bool verify(const std::string& path, size_t bufferSize, IOStats& stats);
+
+    /**
+     * @brief Persiste el estado actual de forma atómica
+     *
+     * @throws SortInterrupted si se alcanzó stopAfterSteps
+     */
+    void commit();
+
+    /** @brief Descarta todo el estado (claves y registros) */
+    void clear();
+
+private:
+    std::string manifestPath;
+    std::string signature;
+    bool active;
+    bool loaded = false;
+    size_t stopAfterSteps;
+    size_t steps = 0;
+    std::map<std::string, std::string> values;
+    std::map<std::string, FileRecord> files;
+    std::vector<std::string> watched;
+};
+
+#endif
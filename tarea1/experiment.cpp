@@ -1,4 +1,6 @@
 #include "experiment.h"
+#include <random>
+#include <sstream>
 
 namespace fs = std::filesystem;
 
@@ -9,6 +11,8 @@ namespace fs = std::filesystem;
  * 
  * Esta función genera datos aleatorios para diferentes tamaños de entrada, ejecuta ambos algoritmos,
  * mide sus tiempos y operaciones de I/O, y guarda los resultados promediados en un archivo CSV.
+ * También registra contadores de hardware (PerfProfile) por fase de cada algoritmo: sus
+ * totales se agregan como columnas del CSV y el desglose por fase va a comparison_phases.csv.
  */
 void runExperiments(size_t optimalArity) {
     std::cout << "\n=== Iniciando experimentos de comparación ===" << std::endl;
@@ -34,6 +38,10 @@ void runExperiments(size_t optimalArity) {
     std::map<int64_t, std::vector<Result>> mergeSortResults;
     std::map<int64_t, std::vector<Result>> quickSortResults;
     
+    // Contadores de hardware por tamaño, separados por fase de cada algoritmo
+    // ("MergeSort/división", "QuickSort/hojas", ...)
+    std::map<int64_t, PerfProfile> profiles;
+    
     // Crear directorios para datos y resultados
     fs::path dataPath("./dataExp");
     fs::path resultsPath("./results");
@@ -50,6 +58,7 @@ void runExperiments(size_t optimalArity) {
         std::cout << "\nEvaluando tamaño: " << N << "M elementos" << std::endl;
         
         int64_t actualSize = N * 1000000; // Convertir a millones
+        PerfProfile& profile = profiles[N];
         
         for (int rep = 0; rep < REPETITIONS; ++rep) {
             std::cout << "Repetición " << (rep + 1) << "/" << REPETITIONS << std::endl;
@@ -64,8 +73,12 @@ void runExperiments(size_t optimalArity) {
             
             // Ejecutar MergeSort
             IOStats mergeStats;
+            SortOptions mergeOptions;
+            SortProgress mergeProgress;
+            mergeProgress.setPhaseListener(profile.phaseListener("MergeSort/"));
+            mergeOptions.progress = &mergeProgress;
             auto mergeStart = std::chrono::high_resolution_clock::now();
-            externalMergeSort(inputFile, mergeSortOutput, optimalArity, MEMORY_LIMIT, mergeStats);
+            externalMergeSort(inputFile, mergeSortOutput, optimalArity, MEMORY_LIMIT, mergeStats, mergeOptions);
             auto mergeEnd = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double> mergeDuration = mergeEnd - mergeStart;
             
@@ -77,8 +90,12 @@ void runExperiments(size_t optimalArity) {
             
             // Ejecutar QuickSort
             IOStats quickStats;
+            SortOptions quickOptions;
+            SortProgress quickProgress;
+            quickProgress.setPhaseListener(profile.phaseListener("QuickSort/"));
+            quickOptions.progress = &quickProgress;
             auto quickStart = std::chrono::high_resolution_clock::now();
-            externalQuickSort(inputFile, quickSortOutput, optimalArity, MEMORY_LIMIT, quickStats);
+            externalQuickSort(inputFile, quickSortOutput, optimalArity, MEMORY_LIMIT, quickStats, quickOptions);
             auto quickEnd = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double> quickDuration = quickEnd - quickStart;
             
@@ -107,7 +124,10 @@ void runExperiments(size_t optimalArity) {
     
     // Calcular y guardar promedios
     std::ofstream resultsFile("./results/comparison_results.csv");
-    resultsFile << "Size(M),MergeSort_Time(s),MergeSort_IO,QuickSort_Time(s),QuickSort_IO\n";
+    resultsFile << "Size(M),MergeSort_Time(s),MergeSort_IO,QuickSort_Time(s),QuickSort_IO,"
+                << PerfSample::csvHeader("MergeSort_") << "," << PerfSample::csvHeader("QuickSort_") << "\n";
+    std::ofstream phasesFile("./results/comparison_phases.csv");
+    phasesFile << "Size(M),Algorithm,Phase,Time(s)," << PerfSample::csvHeader("") << "\n";
     
     std::cout << "\n=== Resultados promedio ===" << std::endl;
     std::cout << "Tamaño(M),MergeSort_Tiempo(s),MergeSort_IO,QuickSort_Tiempo(s),QuickSort_IO" << std::endl;
@@ -138,7 +158,16 @@ void runExperiments(size_t optimalArity) {
                    << avgMergeTime << "," 
                    << avgMergeIO << "," 
                    << avgQuickTime << "," 
-                   << avgQuickIO << "\n";
+                   << avgQuickIO << ","
+                   << profiles[N].total("MergeSort/").csvRow(REPETITIONS) << ","
+                   << profiles[N].total("QuickSort/").csvRow(REPETITIONS) << "\n";
+        
+        // Una fila por fase: nombre "Algoritmo/fase"
+        for (const auto& entry : profiles[N].phases()) {
+            size_t slash = entry.first.find('/');
+            phasesFile << N << "," << entry.first.substr(0, slash) << "," << entry.first.substr(slash + 1) << ","
+                       << entry.second.seconds / REPETITIONS << "," << entry.second.csvRow(REPETITIONS) << "\n";
+        }
         
         // Mostrar en consola
         std::cout << N << "," 
@@ -149,7 +178,789 @@ void runExperiments(size_t optimalArity) {
     }
     
     resultsFile.close();
-    std::cout << "\nResultados guardados en ./results/comparison_results.csv" << std::endl;
+    phasesFile.close();
+    std::cout << "\nResultados guardados en ./results/comparison_results.csv y ./results/comparison_phases.csv"
+              << std::endl;
+    if (!profiles.empty() && !profiles.begin()->second.counters().hardwareAvailable()) {
+        std::cout << "Contadores de hardware no disponibles (perf_event_open): esas columnas quedan en NA" << std::endl;
+    }
+}
+
+/**
+ * @brief Compara el costo de top-k, ordenamiento parcial y selección contra un ordenamiento completo.
+ * 
+ * @param optimalArity Aridad usada por Quicksort externo y por las particiones del ordenamiento parcial.
+ * 
+ * Para un mismo archivo ejecuta externalQuickSort completo y luego cada operación parcial,
+ * reportando sus operaciones de I/O y el ahorro porcentual respecto al ordenamiento completo.
+ */
+void runTopKExperiments(size_t optimalArity) {
+    std::cout << "\n=== Iniciando experimentos de top-k y ordenamiento parcial ===" << std::endl;
+    
+    const int64_t N = 20;
+    const int64_t actualSize = N * 1000000;
+    const size_t MEMORY_LIMIT = 50 * 1024 * 1024;
+    
+    fs::create_directories("./dataExp");
+    fs::create_directories("./results");
+    
+    std::string inputFile = "./dataExp/input_topk_" + std::to_string(N) + "M.bin";
+    std::string fullOutput = "./results/topk_full_sort.bin";
+    std::string partialOutput = "./results/topk_partial_sort.bin";
+    generateData(inputFile, actualSize);
+    
+    std::ofstream resultsFile("./results/topk_results.csv");
+    resultsFile << "Operation,k,Time(s),IO,IO_Savings(%)\n";
+    
+    // Referencia: ordenamiento completo
+    IOStats fullStats;
+    auto fullStart = std::chrono::high_resolution_clock::now();
+    externalQuickSort(inputFile, fullOutput, optimalArity, MEMORY_LIMIT, fullStats);
+    std::chrono::duration<double> fullDuration = std::chrono::high_resolution_clock::now() - fullStart;
+    size_t fullIO = fullStats.total();
+    resultsFile << "FullSort," << actualSize << "," << fullDuration.count() << "," << fullIO << ",0\n";
+    
+    auto report = [&](const std::string& name, size_t k, double time, const IOStats& stats) {
+        double savings = 100.0 * (1.0 - static_cast<double>(stats.total()) / fullIO);
+        resultsFile << name << "," << k << "," << time << "," << stats.total() << "," << savings << "\n";
+        std::cout << name << " (k = " << k << "): " << time << "s, " << stats.total() 
+                  << " I/Os, ahorro " << savings << "%" << std::endl;
+    };
+    
+    // Top-k en una pasada (k cabe en memoria)
+    for (size_t k : {size_t(1000), size_t(1000000)}) {
+        IOStats stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        externalTopK(inputFile, k, MEMORY_LIMIT, stats);
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        report("TopK", k, duration.count(), stats);
+    }
+    
+    // Ordenamiento parcial (k mayor que la memoria)
+    for (double fraction : {0.01, 0.1, 0.5}) {
+        size_t k = static_cast<size_t>(fraction * actualSize);
+        IOStats stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        externalPartialSort(inputFile, partialOutput, k, optimalArity, MEMORY_LIMIT, stats);
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        report("PartialSort", k, duration.count(), stats);
+    }
+    
+    // Selección de la mediana
+    {
+        IOStats stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        externalSelect(inputFile, actualSize / 2, optimalArity, MEMORY_LIMIT, stats);
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        report("Select", actualSize / 2, duration.count(), stats);
+    }
+    
+    resultsFile.close();
+    
+    if (fs::exists(inputFile)) fs::remove(inputFile);
+    if (fs::exists(fullOutput)) fs::remove(fullOutput);
+    if (fs::exists(partialOutput)) fs::remove(partialOutput);
+    
+    std::cout << "\nResultados guardados en ./results/topk_results.csv" << std::endl;
+}
+
+/**
+ * @brief Genera un archivo con un grado de orden previo dado.
+ * 
+ * @param filename Ruta del archivo a generar
+ * @param size Cantidad de números a generar
+ * @param kind "sorted", "reversed", "nearly" (ordenado con desorden local) o "random"
+ */
+static void generatePresortedData(const std::string& filename, int64_t size, const std::string& kind) {
+    if (kind == "random") {
+        generateData(filename, size);
+        return;
+    }
+    
+    std::ofstream file(filename, std::ios::binary);
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<int64_t> jitter(-50000, 50000);
+    
+    std::vector<int64_t> buffer;
+    buffer.reserve(b);
+    for (int64_t i = 0; i < size; ++i) {
+        int64_t position = (kind == "reversed") ? size - 1 - i : i;
+        int64_t value = position * 1000;
+        if (kind == "nearly") {
+            value += jitter(gen);
+        }
+        buffer.push_back(value);
+        
+        if (buffer.size() == b) {
+            file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(int64_t));
+            buffer.clear();
+        }
+    }
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(int64_t));
+    file.close();
+}
+
+/**
+ * @brief Mide el efecto de la detección de orden previo sobre entradas con distinto grado de orden.
+ * 
+ * @param optimalArity Aridad usada por ambos algoritmos.
+ */
+void runPresortExperiments(size_t optimalArity) {
+    std::cout << "\n=== Iniciando experimentos de orden previo ===" << std::endl;
+    
+    const int64_t N = 20;
+    const int64_t actualSize = N * 1000000;
+    const size_t MEMORY_LIMIT = 50 * 1024 * 1024;
+    
+    fs::create_directories("./dataExp");
+    fs::create_directories("./results");
+    
+    std::ofstream resultsFile("./results/presort_results.csv");
+    resultsFile << "Input,Algorithm,Adaptive,Time(s),IO,AscendingRuns,DescendingRuns,MergeInputs,Strategy\n";
+    
+    for (const std::string kind : {"random", "sorted", "reversed", "nearly"}) {
+        std::string inputFile = "./dataExp/input_presort_" + kind + ".bin";
+        std::string outputFile = "./results/presort_" + kind + ".bin";
+        generatePresortedData(inputFile, actualSize, kind);
+        
+        for (bool adaptive : {false, true}) {
+            for (const std::string algorithm : {"MergeSort", "QuickSort"}) {
+                IOStats stats;
+                PresortInfo presort;
+                SortOptions options;
+                options.adaptive = adaptive;
+                options.presortInfo = &presort;
+                
+                auto start = std::chrono::high_resolution_clock::now();
+                if (algorithm == "MergeSort") {
+                    externalMergeSort(inputFile, outputFile, optimalArity, MEMORY_LIMIT, stats, options);
+                } else {
+                    externalQuickSort(inputFile, outputFile, optimalArity, MEMORY_LIMIT, stats, options);
+                }
+                std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+                
+                IOStats verifyStats;
+                if (!verifySort(outputFile, verifyStats)) {
+                    std::cerr << "¡Error! " << algorithm << " no ordenó correctamente." << std::endl;
+                }
+                
+                resultsFile << kind << "," << algorithm << "," << adaptive << "," << duration.count() << ","
+                            << stats.total() << "," << presort.ascendingRuns << "," << presort.descendingRuns << ","
+                            << presort.mergeInputs << "," << presortStrategyName(presort.strategy) << "\n";
+                std::cout << kind << " / " << algorithm << (adaptive ? " (adaptativo)" : "") << ": " 
+                          << duration.count() << "s, " << stats.total() << " I/Os" << std::endl;
+                
+                if (fs::exists(outputFile)) fs::remove(outputFile);
+            }
+        }
+        
+        if (fs::exists(inputFile)) fs::remove(inputFile);
+    }
+    
+    resultsFile.close();
+    std::cout << "\nResultados guardados en ./results/presort_results.csv" << std::endl;
+}
+
+/**
+ * @brief Mide cuánto trabajo se ahorra al reanudar un ordenamiento interrumpido.
+ * 
+ * Usa aridad 4 y poca memoria: con la aridad óptima no hay pasadas intermedias que interrumpir.
+ */
+void runResumeExperiments() {
+    std::cout << "\n=== Iniciando experimentos de reanudación ===" << std::endl;
+    
+    const int64_t actualSize = 20 * 1000000;
+    const size_t MEMORY_LIMIT = 8 * 1024 * 1024;
+    const size_t ARITY = 4;
+    
+    fs::create_directories("./dataExp");
+    fs::create_directories("./results");
+    
+    std::string inputFile = "./dataExp/input_resume.bin";
+    std::string outputFile = "./results/resume_sorted.bin";
+    generateData(inputFile, actualSize);
+    
+    std::ofstream resultsFile("./results/resume_results.csv");
+    resultsFile << "Algorithm,StopAfterSteps,PlainTime(s),PlainIO,CheckpointTime(s),CheckpointIO,"
+                << "InterruptedTime(s),InterruptedIO,ResumeTime(s),ResumeIO\n";
+    
+    auto runSort = [&](const std::string& algorithm, const SortOptions& options, IOStats& stats) {
+        auto start = std::chrono::high_resolution_clock::now();
+        if (algorithm == "MergeSort") {
+            externalMergeSort(inputFile, outputFile, ARITY, MEMORY_LIMIT, stats, options);
+        } else {
+            externalQuickSort(inputFile, outputFile, ARITY, MEMORY_LIMIT, stats, options);
+        }
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        return duration.count();
+    };
+    
+    for (const std::string algorithm : {"MergeSort", "QuickSort"}) {
+        // Referencias: sin checkpoints y con checkpoints sin interrupción
+        IOStats plainStats;
+        double plainTime = runSort(algorithm, SortOptions(), plainStats);
+        
+        SortOptions checkpointOptions;
+        checkpointOptions.checkpoint = true;
+        IOStats checkpointStats;
+        double checkpointTime = runSort(algorithm, checkpointOptions, checkpointStats);
+        
+        for (size_t stopAfter : {5, 15, 25}) {
+            if (fs::exists(outputFile)) fs::remove(outputFile);
+            
+            SortOptions interrupted = checkpointOptions;
+            interrupted.stopAfterSteps = stopAfter;
+            IOStats interruptedStats;
+            double interruptedTime = runSort(algorithm, interrupted, interruptedStats);
+            
+            IOStats resumeStats;
+            double resumeTime = runSort(algorithm, checkpointOptions, resumeStats);
+            
+            IOStats verifyStats;
+            if (!verifySort(outputFile, verifyStats)) {
+                std::cerr << "¡Error! " << algorithm << " no ordenó correctamente al reanudar." << std::endl;
+            }
+            
+            resultsFile << algorithm << "," << stopAfter << "," << plainTime << "," << plainStats.total() << ","
+                        << checkpointTime << "," << checkpointStats.total() << ","
+                        << interruptedTime << "," << interruptedStats.total() << ","
+                        << resumeTime << "," << resumeStats.total() << "\n";
+            std::cout << algorithm << " interrumpido tras " << stopAfter << " checkpoints: reanudar tomó "
+                      << resumeTime << "s y " << resumeStats.total() << " I/Os (completo: " 
+                      << checkpointTime << "s, " << checkpointStats.total() << " I/Os)" << std::endl;
+        }
+        
+        if (fs::exists(outputFile)) fs::remove(outputFile);
+    }
+    
+    if (fs::exists(inputFile)) fs::remove(inputFile);
+    resultsFile.close();
+    std::cout << "\nResultados guardados en ./results/resume_results.csv" << std::endl;
+}
+
+/**
+ * @brief Compara los ordenamientos con un solo directorio temporal contra varios.
+ * 
+ * @param optimalArity Aridad usada por ambos algoritmos.
+ * @param tempDirs Directorios temporales (idealmente en discos distintos).
+ */
+void runStripedExperiments(size_t optimalArity, const std::vector<std::string>& tempDirs) {
+    std::cout << "\n=== Iniciando experimentos de directorios temporales ===" << std::endl;
+    
+    const int64_t actualSize = 20 * 1000000;
+    const size_t MEMORY_LIMIT = 50 * 1024 * 1024;
+    
+    fs::create_directories("./dataExp");
+    fs::create_directories("./results");
+    
+    std::string inputFile = "./dataExp/input_striped.bin";
+    std::string outputFile = "./results/striped_sorted.bin";
+    generateData(inputFile, actualSize);
+    
+    std::ofstream resultsFile("./results/striped_results.csv");
+    resultsFile << "Algorithm,Directories,Placement,Async,Time(s),IO,Device,DeviceReads,DeviceWrites,DeviceMBps,"
+                << "QueueMeanDepth,QueueMaxDepth\n";
+    
+    struct Setup {
+        std::vector<std::string> dirs;
+        TempPlacement placement;
+        const char* name;
+        bool async;
+    };
+    std::vector<Setup> setups = {
+        {{tempDirs.front()}, TempPlacement::ROUND_ROBIN, "round-robin", false},
+        {tempDirs, TempPlacement::ROUND_ROBIN, "round-robin", false},
+        {tempDirs, TempPlacement::FREE_SPACE, "free-space", false},
+        {tempDirs, TempPlacement::ROUND_ROBIN, "round-robin", true}
+    };
+    
+    for (const std::string algorithm : {"MergeSort", "QuickSort"}) {
+        for (const Setup& setup : setups) {
+            IOStats stats;
+            SortOptions options;
+            AsyncIOReport asyncReport;
+            options.tempDirs = setup.dirs;
+            options.placement = setup.placement;
+            options.asyncIO.enabled = setup.async;
+            options.asyncReport = &asyncReport;
+            
+            auto start = std::chrono::high_resolution_clock::now();
+            if (algorithm == "MergeSort") {
+                externalMergeSort(inputFile, outputFile, optimalArity, MEMORY_LIMIT, stats, options);
+            } else {
+                externalQuickSort(inputFile, outputFile, optimalArity, MEMORY_LIMIT, stats, options);
+            }
+            std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+            
+            IOStats verifyStats;
+            if (!verifySort(outputFile, verifyStats)) {
+                std::cerr << "¡Error! " << algorithm << " no ordenó correctamente." << std::endl;
+            }
+            
+            // Con I/O asíncrona cada directorio tiene su propia cola de envío
+            for (size_t i = 0; i < stats.devices.size(); ++i) {
+                const DeviceStats& device = stats.devices[i];
+                const AsyncQueueReport* queue = asyncReport.queue(static_cast<int>(i));
+                resultsFile << algorithm << "," << setup.dirs.size() << "," << setup.name << "," << setup.async << ","
+                            << duration.count() << "," << stats.total() << "," << device.directory << ","
+                            << device.reads << "," << device.writes << "," << device.bandwidth() << ","
+                            << (queue ? queue->meanQueueDepth() : 0) << "," << (queue ? queue->maxQueueDepth : 0) << "\n";
+            }
+            std::cout << algorithm << " con " << setup.dirs.size() << " directorio(s), " << setup.name
+                      << (setup.async ? ", asíncrono" : "") << ": " << duration.count() << "s" << std::endl;
+            
+            if (fs::exists(outputFile)) fs::remove(outputFile);
+        }
+    }
+    
+    if (fs::exists(inputFile)) fs::remove(inputFile);
+    resultsFile.close();
+    std::cout << "\nResultados guardados en ./results/striped_results.csv" << std::endl;
+}
+
+/**
+ * @brief Elementos por segundo de una operación sobre n elementos.
+ */
+static double elementsPerSecond(size_t n, std::chrono::high_resolution_clock::time_point start) {
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+    return n / duration.count();
+}
+
+/**
+ * @brief Mide en elementos/s los kernels de mezcla y ordenamiento en memoria.
+ *
+ * Los kernels y las referencias (heap y std::sort) están en simdmerge.cpp, compilado con
+ * -O2: las razones comparan algoritmos y no niveles de optimización. La comparación
+ * principal es cada kernel vectorial contra el kernel escalar.
+ */
+void runSimdExperiments() {
+    std::cout << "\n=== Iniciando experimentos de kernels SIMD ===" << std::endl;
+    std::cout << "Nivel detectado: " << simdLevelName(simdLevel()) << std::endl;
+    std::cout << "Kernels y referencias compilados con -O2; razones respecto del kernel Scalar" << std::endl;
+    
+    const size_t TOTAL = 8 * 1000000;
+    std::mt19937_64 gen(42);
+    std::vector<SimdLevel> levels = {SimdLevel::SCALAR};
+    if (simdLevel() != SimdLevel::SCALAR) levels.push_back(SimdLevel::AVX2);
+    if (simdLevel() == SimdLevel::AVX512) levels.push_back(SimdLevel::AVX512);
+    
+    fs::create_directories("./results");
+    std::ofstream resultsFile("./results/simd_results.csv");
+    resultsFile << "Operation,Runs,Kernel,OptLevel,Elements,ElementsPerSecond,SpeedupVsScalar\n";
+    
+    for (size_t k : {2, 4, 16, 64}) {
+        // k runs ordenados que suman TOTAL elementos
+        std::vector<std::vector<int64_t>> runs(k, std::vector<int64_t>(TOTAL / k));
+        for (auto& run : runs) {
+            for (auto& value : run) value = static_cast<int64_t>(gen() >> 1);
+            std::sort(run.begin(), run.end());
+        }
+        size_t n = (TOTAL / k) * k;
+        
+        // Referencia: el mismo heap de RunMerger, sobre memoria
+        std::vector<int64_t> heapOutput;
+        auto start = std::chrono::high_resolution_clock::now();
+        heapMergeKWay(runs, heapOutput);
+        double heapRate = elementsPerSecond(n, start);
+        
+        double scalarRate = 0;
+        for (SimdLevel level : levels) {
+            std::vector<int64_t> output;
+            start = std::chrono::high_resolution_clock::now();
+            mergeKWay(runs, output, level);
+            double rate = elementsPerSecond(n, start);
+            if (level == SimdLevel::SCALAR) scalarRate = rate;
+            if (output != heapOutput) {
+                std::cerr << "¡Error! mergeKWay (" << simdLevelName(level) << ") no coincide con el heap." << std::endl;
+            }
+            resultsFile << "merge," << k << "," << simdLevelName(level) << ",O2," << n << "," << rate << ","
+                        << rate / scalarRate << "\n";
+            std::cout << "Mezcla de " << k << " runs con " << simdLevelName(level) << ": " << rate / 1e6
+                      << " M elementos/s (" << rate / scalarRate << "x)" << std::endl;
+        }
+        resultsFile << "merge," << k << ",heap,O2," << n << "," << heapRate << "," << heapRate / scalarRate << "\n";
+        std::cout << "Mezcla de " << k << " runs con heap: " << heapRate / 1e6 << " M elementos/s ("
+                  << heapRate / scalarRate << "x)" << std::endl;
+    }
+    
+    // Ordenamiento en memoria de un chunk
+    std::vector<int64_t> data(TOTAL);
+    for (auto& value : data) value = static_cast<int64_t>(gen() >> 1);
+    std::vector<int64_t> expected = data;
+    auto start = std::chrono::high_resolution_clock::now();
+    referenceSort(expected);
+    double sortRate = elementsPerSecond(TOTAL, start);
+    
+    double scalarRate = 0;
+    for (SimdLevel level : levels) {
+        std::vector<int64_t> sorted = data;
+        start = std::chrono::high_resolution_clock::now();
+        simdSort(sorted, level);
+        double rate = elementsPerSecond(TOTAL, start);
+        if (level == SimdLevel::SCALAR) scalarRate = rate;
+        if (sorted != expected) {
+            std::cerr << "¡Error! simdSort (" << simdLevelName(level) << ") no ordenó correctamente." << std::endl;
+        }
+        resultsFile << "sort,1," << simdLevelName(level) << ",O2," << TOTAL << "," << rate << "," << rate / scalarRate << "\n";
+        std::cout << "simdSort con " << simdLevelName(level) << ": " << rate / 1e6 << " M elementos/s ("
+                  << rate / scalarRate << "x)" << std::endl;
+    }
+    resultsFile << "sort,1,std::sort,O2," << TOTAL << "," << sortRate << "," << sortRate / scalarRate << "\n";
+    std::cout << "std::sort: " << sortRate / 1e6 << " M elementos/s (" << sortRate / scalarRate << "x)" << std::endl;
+    
+    resultsFile.close();
+    std::cout << "\nResultados guardados en ./results/simd_results.csv" << std::endl;
+}
+
+/**
+ * @brief Mide el espacio temporal máximo de MergeSort con y sin SortOptions::reclaimSpace.
+ */
+void runReclaimExperiments() {
+    std::cout << "\n=== Iniciando experimentos de espacio temporal ===" << std::endl;
+    
+    const int64_t actualSize = 20 * 1000000;
+    const size_t MEMORY_LIMIT = 8 * 1024 * 1024;
+    const size_t ARITY = 4;
+    
+    fs::create_directories("./dataExp");
+    fs::create_directories("./results");
+    
+    std::string inputFile = "./dataExp/input_reclaim.bin";
+    std::string outputFile = "./results/reclaim_sorted.bin";
+    generateData(inputFile, actualSize);
+    double inputMB = fs::file_size(inputFile) / (1024.0 * 1024.0);
+    
+    std::ofstream resultsFile("./results/reclaim_results.csv");
+    resultsFile << "Mode,Time(s),IO,PeakTempMB,PeakRatio\n";
+    
+    struct Setup {
+        bool reclaim;
+        bool checkpoint;
+        const char* name;
+    };
+    for (const Setup& setup : {Setup{false, false, "normal"}, Setup{true, false, "reclaim"},
+                               Setup{true, true, "reclaim+checkpoint"}}) {
+        IOStats stats;
+        SortOptions options;
+        options.reclaimSpace = setup.reclaim;
+        options.checkpoint = setup.checkpoint;
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        externalMergeSort(inputFile, outputFile, ARITY, MEMORY_LIMIT, stats, options);
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        
+        double peakMB = stats.peakTempBytes / (1024.0 * 1024.0);
+        resultsFile << setup.name << "," << duration.count() << "," << stats.total() << "," << peakMB << ","
+                    << peakMB / inputMB << "\n";
+        std::cout << "MergeSort " << setup.name << ": " << duration.count() << "s, " << stats.total()
+                  << " I/O, espacio temporal máximo " << peakMB << " MB (" << peakMB / inputMB
+                  << " veces la entrada)" << std::endl;
+    }
+    
+    resultsFile.close();
+    fs::remove(inputFile);
+    fs::remove(outputFile);
+    std::cout << "\nResultados guardados en ./results/reclaim_results.csv" << std::endl;
+}
+
+/**
+ * @brief Imprime el resumen de una ejecución del servicio
+ */
+static void printServiceReport(const ServiceReport& report) {
+    std::cout << "Trabajos: " << report.jobs << " (" << report.failed << " fallidos) en " << report.seconds
+              << " s, " << report.jobsPerHour << " trabajos/hora" << std::endl;
+    std::cout << "Latencia p50/p95/p99/máx: " << report.p50 << " / " << report.p95 << " / " << report.p99
+              << " / " << report.maxLatency << " s, espera promedio " << report.meanWait << " s" << std::endl;
+    std::cout << "Total operaciones I/O: " << report.io << std::endl;
+}
+
+/**
+ * @brief Lee un archivo de trabajos (`cola algoritmo entrada salida [aridad] [memoriaMB]`)
+ */
+static std::vector<SortJob> readJobs(const std::string& filename, size_t optimalArity) {
+    std::vector<SortJob> jobs;
+    std::ifstream file(filename);
+    if (!file) {
+        std::cerr << "Error al abrir archivo de trabajos: " << filename << std::endl;
+        return jobs;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        SortJob job;
+        std::string algorithm;
+        if (!(fields >> job.queue >> algorithm >> job.input >> job.output)) {
+            continue;
+        }
+        job.algorithm = algorithm == "quicksort" ? SortAlgorithm::QUICKSORT : SortAlgorithm::MERGESORT;
+        job.arity = optimalArity;
+        size_t megabytes = 0;
+        if (fields >> job.arity >> megabytes) {
+            job.memoryRequest = megabytes * 1024 * 1024;
+        }
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+/**
+ * @brief Ejecuta lotes de ordenamientos con SortService.
+ */
+void runServiceExperiments(size_t optimalArity, const std::string& jobsFile) {
+    std::cout << "\n=== Iniciando experimentos del servicio de ordenamiento ===" << std::endl;
+    
+    const size_t MEMORY_BUDGET = 64 * 1024 * 1024;
+    
+    if (!jobsFile.empty()) {
+        ServiceConfig config;
+        config.memoryBudget = MEMORY_BUDGET;
+        SortService service(config);
+        for (const SortJob& job : readJobs(jobsFile, optimalArity)) {
+            service.submit(job);
+        }
+        service.run();
+        
+        for (const JobResult& result : service.results()) {
+            std::cout << "#" << result.id << " [" << result.queue << "] " << sortAlgorithmName(result.algorithm)
+                      << " " << result.input << ": ";
+            if (result.ok) {
+                std::cout << result.memory / (1024 * 1024) << " MB, espera " << result.waitSeconds
+                          << " s, ejecución " << result.runSeconds << " s, " << result.io << " I/O" << std::endl;
+            } else {
+                std::cout << "falló (" << result.error << ")" << std::endl;
+            }
+        }
+        printServiceReport(service.report());
+        return;
+    }
+    
+    // Lote sintético: trabajos grandes en una cola y pequeños en otra
+    const size_t JOBS = 12;
+    fs::create_directories("./dataExp/service");
+    fs::create_directories("./results");
+    std::vector<SortJob> jobs;
+    for (size_t i = 0; i < JOBS; ++i) {
+        SortJob job;
+        bool large = i % 3 == 0;
+        job.queue = large ? "batch" : "interactive";
+        job.algorithm = i % 2 == 0 ? SortAlgorithm::MERGESORT : SortAlgorithm::QUICKSORT;
+        job.input = "./dataExp/service/input_" + std::to_string(i) + ".bin";
+        job.output = "./dataExp/service/sorted_" + std::to_string(i) + ".bin";
+        job.arity = optimalArity;
+        generateData(job.input, large ? 8 * 1000000 : 2 * 1000000);
+        jobs.push_back(job);
+    }
+    
+    std::ofstream resultsFile("./results/service_results.csv");
+    resultsFile << "Concurrency,Jobs,Failed,Time(s),JobsPerHour,MeanWait(s),P50(s),P95(s),P99(s),IO\n";
+    
+    for (size_t concurrency : {1, 2, 4}) {
+        ServiceConfig config;
+        config.memoryBudget = MEMORY_BUDGET;
+        config.maxConcurrent = concurrency;
+        SortService service(config);
+        for (const SortJob& job : jobs) {
+            service.submit(job);
+        }
+        service.run();
+        
+        ServiceReport report = service.report();
+        std::cout << "\nConcurrencia " << concurrency << ":" << std::endl;
+        printServiceReport(report);
+        resultsFile << concurrency << "," << report.jobs << "," << report.failed << "," << report.seconds << ","
+                    << report.jobsPerHour << "," << report.meanWait << "," << report.p50 << "," << report.p95
+                    << "," << report.p99 << "," << report.io << "\n";
+    }
+    
+    resultsFile.close();
+    fs::remove_all("./dataExp/service");
+    std::cout << "\nResultados guardados en ./results/service_results.csv" << std::endl;
+}
+
+/**
+ * @brief Compara la mezcla síncrona (mergeRuns) con asyncMergeRuns.
+ */
+void runAsyncExperiments() {
+    std::cout << "\n=== Iniciando experimentos de I/O asíncrona ===" << std::endl;
+    
+    const size_t TOTAL = 4 * 1000000;
+    const size_t MEMORY_LIMIT = 16 * 1024 * 1024;
+    
+    fs::create_directories("./dataExp/async");
+    fs::create_directories("./results");
+    std::string outputFile = "./dataExp/async/merged.bin";
+    
+    std::ofstream resultsFile("./results/async_results.csv");
+    resultsFile << "Streams,Backend,Time(s),MB/s,IO,MeanQueueDepth,MaxQueueDepth\n";
+    
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<int64_t> dist;
+    
+    std::vector<AsyncBackend> backends = {AsyncBackend::THREAD_POOL};
+    if (ioUringAvailable()) {
+        backends.push_back(AsyncBackend::IO_URING);
+    } else {
+        std::cout << "io_uring no está disponible; solo se mide el pool de hilos" << std::endl;
+    }
+    
+    for (size_t streams : {16, 64, 256, 1024}) {
+        // Runs ordenados del mismo tamaño que suman TOTAL elementos
+        std::vector<std::string> runFiles;
+        size_t perRun = TOTAL / streams;
+        for (size_t i = 0; i < streams; i++) {
+            std::vector<int64_t> run(perRun);
+            for (auto& value : run) {
+                value = dist(gen);
+            }
+            std::sort(run.begin(), run.end());
+            std::string name = "./dataExp/async/run_" + std::to_string(i) + ".bin";
+            std::ofstream file(name, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(run.data()), run.size() * sizeof(int64_t));
+            runFiles.push_back(name);
+        }
+        size_t bufferSize = std::max<size_t>(MEMORY_LIMIT / (streams + 1) / sizeof(int64_t), b);
+        double megabytes = 2.0 * perRun * streams * sizeof(int64_t) / (1024.0 * 1024.0);
+        
+        IOStats stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        mergeRuns(runFiles, outputFile, bufferSize, stats);
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        resultsFile << streams << ",sync," << duration.count() << "," << megabytes / duration.count() << ","
+                    << stats.total() << ",1,1\n";
+        std::cout << streams << " runs, síncrono: " << duration.count() << "s, "
+                  << megabytes / duration.count() << " MB/s, " << stats.total() << " I/O" << std::endl;
+        
+        for (AsyncBackend backend : backends) {
+            AsyncIOOptions options;
+            options.enabled = true;
+            options.backend = backend;
+            AsyncIOReport report;
+            IOStats asyncStats;
+            
+            start = std::chrono::high_resolution_clock::now();
+            asyncMergeRuns(runFiles, outputFile, bufferSize, asyncStats, false, false, options, &report);
+            duration = std::chrono::high_resolution_clock::now() - start;
+            resultsFile << streams << "," << asyncBackendName(backend) << "," << duration.count() << ","
+                        << report.megabytesPerSecond() << "," << asyncStats.total() << ","
+                        << report.meanQueueDepth() << "," << report.maxQueueDepth << "\n";
+            std::cout << streams << " runs, " << asyncBackendName(backend) << ": " << duration.count() << "s, "
+                      << report.megabytesPerSecond() << " MB/s, " << asyncStats.total()
+                      << " I/O, profundidad de cola promedio " << report.meanQueueDepth() << " (máx "
+                      << report.maxQueueDepth << ")" << std::endl;
+        }
+        
+        for (const auto& name : runFiles) {
+            fs::remove(name);
+        }
+    }
+    
+    resultsFile.close();
+    fs::remove_all("./dataExp/async");
+    std::cout << "\nResultados guardados en ./results/async_results.csv" << std::endl;
+}
+
+/**
+ * @brief Mide el costo de SortProgress y CancellationToken y la latencia de cancelación.
+ */
+void runProgressExperiments() {
+    std::cout << "\n=== Iniciando experimentos de progreso y cancelación ===" << std::endl;
+    
+    const int64_t actualSize = 10 * 1000000;
+    const size_t MEMORY_LIMIT = 8 * 1024 * 1024;
+    const size_t ARITY = 4;
+    const int REPETITIONS = 3;
+    
+    fs::create_directories("./dataExp");
+    fs::create_directories("./results");
+    
+    std::string inputFile = "./dataExp/input_progress.bin";
+    std::string outputFile = "./results/progress_sorted.bin";
+    generateData(inputFile, actualSize);
+    
+    std::ofstream resultsFile("./results/progress_results.csv");
+    resultsFile << "Mode,MedianTime(s),IO,Overhead(%)\n";
+    
+    // Sin contadores, con contadores y token (sin reportero), y con reportero cada 100ms.
+    // Las repeticiones se alternan para que la caché afecte a todos por igual
+    const char* names[] = {"sin progreso", "contadores+token", "reportero"};
+    std::vector<double> times[3];
+    size_t io[3] = {0, 0, 0};
+    size_t reports = 0;
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        for (int mode = 0; mode < 3; ++mode) {
+            IOStats stats;
+            SortOptions options;
+            SortProgress counters;
+            SortProgress reporter([&reports](const ProgressSnapshot&) { reports++; }, 0.1);
+            CancellationToken token;
+            if (mode > 0) {
+                options.progress = mode == 1 ? &counters : &reporter;
+                options.cancel = &token;
+            }
+            
+            auto start = std::chrono::high_resolution_clock::now();
+            externalMergeSort(inputFile, outputFile, ARITY, MEMORY_LIMIT, stats, options);
+            std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+            times[mode].push_back(duration.count());
+            io[mode] = stats.total();
+        }
+    }
+    
+    std::vector<double> medians;
+    for (int mode = 0; mode < 3; ++mode) {
+        std::sort(times[mode].begin(), times[mode].end());
+        medians.push_back(times[mode][times[mode].size() / 2]);
+    }
+    for (int mode = 0; mode < 3; ++mode) {
+        double overhead = (medians[mode] / medians[0] - 1) * 100;
+        resultsFile << names[mode] << "," << medians[mode] << "," << io[mode] << "," << overhead << "\n";
+        std::cout << "MergeSort " << names[mode] << ": mediana " << medians[mode] << "s, " << io[mode]
+                  << " I/O, " << overhead << "% respecto a sin progreso" << std::endl;
+    }
+    std::cout << "Instantáneas entregadas por el reportero: " << reports << std::endl;
+    
+    // Latencia de cancelación: desde cancel() hasta que el ordenamiento lanza SortCancelled
+    for (int quick = 0; quick < 2; ++quick) {
+        IOStats stats;
+        SortOptions options;
+        CancellationToken token;
+        options.cancel = &token;
+        std::chrono::high_resolution_clock::time_point requested;
+        std::thread canceller([&token, &requested]() {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            requested = std::chrono::high_resolution_clock::now();
+            token.cancel();
+        });
+        
+        bool cancelled = false;
+        try {
+            if (quick) {
+                externalQuickSort(inputFile, outputFile, ARITY, MEMORY_LIMIT, stats, options);
+            } else {
+                externalMergeSort(inputFile, outputFile, ARITY, MEMORY_LIMIT, stats, options);
+            }
+        } catch (const SortCancelled&) {
+            cancelled = true;
+        }
+        auto stopped = std::chrono::high_resolution_clock::now();
+        canceller.join();
+        
+        std::string tempDir = quick ? "./temp_quick_" + std::to_string(ARITY) : "./temp_" + std::to_string(ARITY);
+        std::chrono::duration<double, std::milli> latency = stopped - requested;
+        const char* name = quick ? "QuickSort" : "MergeSort";
+        resultsFile << name << " cancelado," << (cancelled ? latency.count() / 1000 : -1) << "," << stats.total()
+                    << ",\n";
+        std::cout << name << (cancelled ? " cancelado " : " terminó antes de cancelarse ")
+                  << (cancelled ? latency.count() : 0) << " ms después del pedido; temporales "
+                  << (fs::exists(tempDir) ? "presentes" : "eliminados") << std::endl;
+    }
+    
+    resultsFile.close();
+    fs::remove(inputFile);
+    fs::remove(outputFile);
+    std::cout << "\nResultados guardados en ./results/progress_results.csv" << std::endl;
 }
 
 /**
@@ -159,8 +970,18 @@ void runExperiments(size_t optimalArity) {
  * 
  * Configura los parámetros iniciales (tamaño de bloque, memoria disponible),
  * calcula la aridad óptima para los algoritmos y ejecuta los experimentos.
+ * Con un primer argumento ejecuta en su lugar un solo experimento:
+ * - `topk`: runTopKExperiments
+ * - `presort`: runPresortExperiments
+ * - `resume`: runResumeExperiments
+ * - `simd`: runSimdExperiments
+ * - `reclaim`: runReclaimExperiments
+ * - `async`: runAsyncExperiments
+ * - `progress`: runProgressExperiments
+ * - `service [jobs.txt]`: runServiceExperiments
+ * - `striped dir1 dir2 ...`: runStripedExperiments
  */
-int main() {
+int main(int argc, char* argv[]) {
     // Nombre de archivos
     std::string inputFilename = "./dataExp/input_array.bin";
     std::string outputFilename = "./dataExp/sorted_array";
@@ -181,6 +1002,47 @@ int main() {
     std::cout << "La aridad óptima para Mergesort externo es: " << optimalArity << std::endl;
     std::cout << "Esta aridad también define la cantidad de subarreglos para Quicksort externo" << std::endl;
     
+    // Modos opcionales: ./experiment topk | presort | resume | simd | reclaim | async | progress | service [jobs.txt] | striped dir1 dir2 ...
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "topk") {
+        runTopKExperiments(optimalArity);
+        return 0;
+    }
+    if (mode == "presort") {
+        runPresortExperiments(optimalArity);
+        return 0;
+    }
+    if (mode == "resume") {
+        runResumeExperiments();
+        return 0;
+    }
+    if (mode == "simd") {
+        runSimdExperiments();
+        return 0;
+    }
+    if (mode == "reclaim") {
+        runReclaimExperiments();
+        return 0;
+    }
+    if (mode == "async") {
+        runAsyncExperiments();
+        return 0;
+    }
+    if (mode == "progress") {
+        runProgressExperiments();
+        return 0;
+    }
+    if (mode == "service") {
+        runServiceExperiments(optimalArity, argc > 2 ? argv[2] : "");
+        return 0;
+    }
+    if (mode == "striped") {
+        std::vector<std::string> tempDirs(argv + 2, argv + argc);
+        if (tempDirs.empty()) tempDirs.push_back(".");
+        runStripedExperiments(optimalArity, tempDirs);
+        return 0;
+    }
+    
     // Ejecutar experimentos comparativos
     runExperiments(optimalArity);
     
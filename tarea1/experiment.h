@@ -3,6 +3,10 @@
 
 #include "mergesort.h"
 #include "quicksort.h"
+#include "topk.h"
+#include "simdmerge.h"
+#include "sortservice.h"
+#include "perfcounters.h"
 #include "iostats.h"
 #include "constants.h"
 #include <map>
@@ -17,9 +21,106 @@ namespace fs = std::filesystem;
  * 
  * Esta función genera datos aleatorios para diferentes tamaños de entrada, ejecuta ambos algoritmos,
  * mide sus tiempos y operaciones de I/O, y guarda los resultados promediados en un archivo CSV.
+ * También registra contadores de hardware (PerfProfile) por fase de cada algoritmo: sus
+ * totales se agregan como columnas del CSV y el desglose por fase va a comparison_phases.csv.
  */
 void runExperiments(size_t optimalArity);
 
+/**
+ * @brief Compara el costo de top-k, ordenamiento parcial y selección contra un ordenamiento completo.
+ * 
+ * @param optimalArity Aridad usada por Quicksort externo y por las particiones del ordenamiento parcial.
+ * 
+ * Para un mismo archivo ejecuta externalQuickSort completo y luego cada operación parcial,
+ * reportando sus operaciones de I/O y el ahorro porcentual respecto al ordenamiento completo.
+ * Los resultados se guardan en ./results/topk_results.csv.
+ */
+void runTopKExperiments(size_t optimalArity);
+
+/**
+ * @brief Mide el efecto de la detección de orden previo sobre entradas con distinto grado de orden.
+ * 
+ * @param optimalArity Aridad usada por ambos algoritmos.
+ * 
+ * Genera entradas aleatorias, ordenadas, descendentes y casi ordenadas, y ejecuta ambos
+ * algoritmos con y sin `SortOptions::adaptive`, guardando tiempo, I/O, runs detectados y
+ * estrategia elegida en ./results/presort_results.csv.
+ */
+void runPresortExperiments(size_t optimalArity);
+
+/**
+ * @brief Mide cuánto trabajo se ahorra al reanudar un ordenamiento interrumpido.
+ * 
+ * Para cada algoritmo ejecuta un ordenamiento sin checkpoints, uno con checkpoints, y
+ * luego varios interrumpidos con `SortOptions::stopAfterSteps` y reanudados, guardando
+ * tiempo e I/O de cada etapa en ./results/resume_results.csv.
+ */
+void runResumeExperiments();
+
+/**
+ * @brief Compara los ordenamientos con un solo directorio temporal contra varios.
+ * 
+ * @param optimalArity Aridad usada por ambos algoritmos.
+ * @param tempDirs Directorios temporales (idealmente en discos distintos).
+ * 
+ * Ejecuta ambos algoritmos con el primer directorio solo y con todos (por turnos y por
+ * espacio libre), guardando tiempo, I/O y el desglose por directorio en
+ * ./results/striped_results.csv.
+ */
+void runStripedExperiments(size_t optimalArity, const std::vector<std::string>& tempDirs);
+
+/**
+ * @brief Mide en elementos/s los kernels de mezcla y ordenamiento en memoria.
+ * 
+ * Compara, sobre runs ordenados en memoria, el ciclo con `priority_queue<HeapNode>`
+ * usado por la mezcla k-vías contra mergeKWay con cada kernel (escalar, AVX2,
+ * AVX-512) para varios k, y std::sort contra simdSort. Los resultados se guardan
+ * en ./results/simd_results.csv.
+ */
+void runSimdExperiments();
+
+/**
+ * @brief Mide el espacio temporal máximo de MergeSort con y sin SortOptions::reclaimSpace.
+ * 
+ * Ordena una entrada con poca memoria y aridad 4 (varias pasadas de mezcla) de forma
+ * normal, liberando los runs consumidos, y liberándolos con checkpoints activos, y
+ * guarda tiempo, I/O y espacio máximo en ./results/reclaim_results.csv.
+ */
+void runReclaimExperiments();
+
+/**
+ * @brief Ejecuta lotes de ordenamientos con SortService.
+ * 
+ * @param optimalArity Aridad de los trabajos generados.
+ * @param jobsFile Archivo de trabajos (vacío: lote sintético). Una línea por trabajo:
+ *                 `cola algoritmo entrada salida [aridad] [memoriaMB]`; `#` inicia un comentario.
+ * 
+ * Sin archivo genera un lote de entradas en dos colas y lo ejecuta con 1, 2 y 4 trabajos
+ * concurrentes bajo el mismo presupuesto de memoria, guardando trabajos/hora y latencias
+ * p50/p95/p99 en ./results/service_results.csv. Con archivo ejecuta esos trabajos una vez
+ * e imprime el resultado de cada uno.
+ */
+void runServiceExperiments(size_t optimalArity, const std::string& jobsFile);
+
+/**
+ * @brief Compara la mezcla síncrona (mergeRuns) con asyncMergeRuns.
+ * 
+ * Mezcla 16, 64, 256 y 1024 runs ordenados con la misma memoria total, de forma
+ * síncrona y con cada mecanismo asíncrono disponible (pool de hilos, io_uring), y
+ * guarda tiempo, MB/s, I/O y profundidad de cola en ./results/async_results.csv.
+ */
+void runAsyncExperiments();
+
+/**
+ * @brief Mide el costo de SortProgress y CancellationToken y la latencia de cancelación.
+ * 
+ * Ordena la misma entrada con MergeSort sin progreso, con contadores y token, y con
+ * un reportero cada 100ms (mediana de 3 repeticiones alternadas), y luego cancela un
+ * MergeSort y un QuickSort al segundo de empezar. Guarda tiempos, sobrecosto y
+ * latencia de cancelación en ./results/progress_results.csv.
+ */
+void runProgressExperiments();
+
 /**
  * @brief Función principal del programa.
  * 
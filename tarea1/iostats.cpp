@@ -1,4 +1,5 @@
 #include "iostats.h"
+#include <chrono>
 
 /**
  * @brief Calcula el total de operaciones de I/O realizadas (lecturas + escrituras).
@@ -15,6 +16,49 @@ size_t IOStats::total() const {
 void IOStats::reset() {
     reads = 0;
     writes = 0;
+    devices.clear();
+    peakTempBytes = 0;
+}
+
+/**
+ * @brief Registra un directorio para desglosar sus operaciones.
+ * 
+ * @param directory Directorio temporal.
+ * @return int Índice del dispositivo (el existente si ya estaba registrado).
+ */
+int IOStats::addDevice(const std::string& directory) {
+    for (size_t i = 0; i < devices.size(); ++i) {
+        if (devices[i].directory == directory) return static_cast<int>(i);
+    }
+    devices.push_back({directory});
+    return static_cast<int>(devices.size() - 1);
+}
+
+/**
+ * @brief Busca el dispositivo registrado que contiene un archivo.
+ * 
+ * @param path Ruta del archivo.
+ * @return int Índice del dispositivo, o -1 si no está en ningún directorio registrado.
+ */
+int IOStats::deviceOf(const std::string& path) const {
+    for (size_t i = 0; i < devices.size(); ++i) {
+        const std::string& directory = devices[i].directory;
+        if (path.size() > directory.size() && path.compare(0, directory.size(), directory) == 0 &&
+            path[directory.size()] == '/') {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Ancho de banda observado, en MB/s.
+ * 
+ * @return double Bloques transferidos por segundo de I/O, convertidos a MB/s (0 sin tiempo medido).
+ */
+double DeviceStats::bandwidth() const {
+    if (seconds <= 0) return 0;
+    return (reads + writes) * static_cast<double>(B) / (1024.0 * 1024.0) / seconds;
 }
 
 /**
@@ -25,12 +69,18 @@ void IOStats::reset() {
  * @param buffer Vector donde se almacenarán los datos leídos.
  * @param count Número máximo de elementos a leer.
  * @param stats Objeto IOStats para registrar las operaciones de I/O.
+ * @param device Índice en stats.devices al que se atribuye la lectura (-1: ninguno).
  * @return size_t Número de elementos leídos efectivamente.
  * 
  * @note El tamaño de bloque (B) se utiliza para calcular las operaciones de I/O en bloques completos.
+ * @note El tiempo de la lectura solo se mide si se indica un dispositivo.
+ * @throws SortCancelled si stats.cancel pidió cancelar (después de contar la lectura)
  */
 template<typename T>
-size_t readBlock(std::ifstream& file, std::vector<T>& buffer, size_t count, IOStats& stats) {
+size_t readBlock(std::ifstream& file, std::vector<T>& buffer, size_t count, IOStats& stats, int device) {
+    std::chrono::steady_clock::time_point start;
+    if (device >= 0) start = std::chrono::steady_clock::now();
+    
     std::streampos posBefore = file.tellg();
     buffer.resize(count);
     file.read(reinterpret_cast<char*>(buffer.data()), count * sizeof(T));
@@ -41,6 +91,13 @@ size_t readBlock(std::ifstream& file, std::vector<T>& buffer, size_t count, IOSt
         size_t bytesRead = itemsRead * sizeof(T);
         size_t blocksRead = (bytesRead + B - 1) / B;  // Usa la constante B
         stats.reads += blocksRead;
+        
+        if (device >= 0) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            stats.devices[device].reads += blocksRead;
+            stats.devices[device].seconds += elapsed.count();
+        }
+        stats.observe(bytesRead, false);
     }
     
     return itemsRead;
@@ -53,22 +110,34 @@ size_t readBlock(std::ifstream& file, std::vector<T>& buffer, size_t count, IOSt
  * @param file Archivo de salida abierto en modo binario.
  * @param buffer Vector con los elementos a escribir.
  * @param stats Objeto IOStats para registrar las operaciones de I/O.
+ * @param device Índice en stats.devices al que se atribuye la escritura (-1: ninguno).
  * 
  * @note Si el buffer está vacío, no se realiza ninguna operación.
  * @note El tamaño de bloque (B) se utiliza para calcular las operaciones de I/O en bloques completos.
+ * @throws SortCancelled si stats.cancel pidió cancelar (después de contar la escritura)
  */
 template<typename T>
-void writeBlock(std::ofstream& file, const std::vector<T>& buffer, IOStats& stats) {
+void writeBlock(std::ofstream& file, const std::vector<T>& buffer, IOStats& stats, int device) {
     if (buffer.empty()) return;
     
+    std::chrono::steady_clock::time_point start;
+    if (device >= 0) start = std::chrono::steady_clock::now();
+    
     std::streampos posBefore = file.tellp();
     file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(T));
     
     size_t bytesWritten = buffer.size() * sizeof(T);
     size_t blocksWritten = (bytesWritten + B - 1) / B;  // Usa la constante B
     stats.writes += blocksWritten;
+    
+    if (device >= 0) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        stats.devices[device].writes += blocksWritten;
+        stats.devices[device].seconds += elapsed.count();
+    }
+    stats.observe(bytesWritten, true);
 }
 
 // Instanciaciones explícitas
-template size_t readBlock<int64_t>(std::ifstream&, std::vector<int64_t>&, size_t, IOStats&);
-template void writeBlock<int64_t>(std::ofstream&, const std::vector<int64_t>&, IOStats&);
\ No newline at end of file
+template size_t readBlock<int64_t>(std::ifstream&, std::vector<int64_t>&, size_t, IOStats&, int);
+template void writeBlock<int64_t>(std::ofstream&, const std::vector<int64_t>&, IOStats&, int);
\ No newline at end of file
@@ -2,9 +2,27 @@
 #define IOSTATS_H
 
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <fstream>
 #include "constants.h"
+#include "progress.h"
+
+/**
+ * @brief Operaciones de E/S sobre un directorio temporal (normalmente, un dispositivo).
+ */
+struct DeviceStats {
+    std::string directory;   ///< Directorio registrado
+    size_t reads = 0;        ///< Bloques leídos
+    size_t writes = 0;       ///< Bloques escritos
+    double seconds = 0;      ///< Tiempo pasado dentro de lecturas y escrituras
+    
+    /**
+     * @brief Ancho de banda observado (bloques de B bytes por segundo de I/O), en MB/s.
+     */
+    double bandwidth() const;
+};
 
 /**
  * @brief Estructura para registrar estadísticas de operaciones de E/S en memoria externa.
@@ -15,6 +33,10 @@
 struct IOStats {
     size_t reads = 0;
     size_t writes = 0;
+    std::vector<DeviceStats> devices;  ///< Desglose por directorio temporal registrado
+    uintmax_t peakTempBytes = 0;       ///< Máximo espacio temporal medido (ver TempStorage::sampleUsage)
+    SortProgress* progress = nullptr;  ///< Si no es nulo, recibe los bytes de cada bloque (ver ProgressScope)
+    const CancellationToken* cancel = nullptr;  ///< Si no es nulo, se consulta en cada bloque (ver ProgressScope)
     
     /**
      * @brief Obtiene el total de operaciones de E/S realizadas.
@@ -22,9 +44,33 @@ struct IOStats {
      */
     size_t total() const;
     /**
-     * @brief Reinicia los contadores de lecturas y escrituras a cero.
+     * @brief Reinicia los contadores de lecturas y escrituras a cero y olvida los dispositivos y el espacio máximo.
+     * 
+     * No toca progress ni cancel.
      */
     void reset();
+    /**
+     * @brief Registra un directorio para desglosar sus operaciones.
+     * @param directory Directorio temporal.
+     * @return int Índice del dispositivo (el existente si ya estaba registrado).
+     */
+    int addDevice(const std::string& directory);
+    /**
+     * @brief Busca el dispositivo registrado que contiene un archivo.
+     * @param path Ruta del archivo.
+     * @return int Índice del dispositivo, o -1 si no está en ningún directorio registrado.
+     */
+    int deviceOf(const std::string& path) const;
+    /**
+     * @brief Informa un bloque transferido a progress y atiende la cancelación.
+     * @param bytes Bytes leídos o escritos.
+     * @param write true para una escritura.
+     * @throws SortCancelled si cancel pidió cancelar.
+     */
+    void observe(size_t bytes, bool write) {
+        if (progress) progress->add(bytes, write);
+        if (cancel && cancel->cancelled()) throw SortCancelled();
+    }
 };
 
 /**
@@ -35,12 +81,13 @@ struct IOStats {
  * @param buffer Vector donde se almacenarán los elementos leídos.
  * @param count Número máximo de elementos a leer.
  * @param stats Objeto IOStats para registrar las operaciones de I/O.
+ * @param device Índice en stats.devices al que se atribuye la lectura (-1: ninguno).
  * @return size_t Número de elementos leídos efectivamente.
  * 
  * @note El tamaño de bloque (B) se utiliza para calcular las operaciones de I/O en bloques completos.
  */
 template<typename T>
-size_t readBlock(std::ifstream& file, std::vector<T>& buffer, size_t count, IOStats& stats);
+size_t readBlock(std::ifstream& file, std::vector<T>& buffer, size_t count, IOStats& stats, int device = -1);
 
 /**
  * @brief Escribe un bloque de datos en un archivo y actualiza las estadísticas de I/O.
@@ -49,11 +96,12 @@ size_t readBlock(std::ifstream& file, std::vector<T>& buffer, size_t count, IOSt
  * @param file Archivo de salida en modo binario.
  * @param buffer Vector con los elementos a escribir.
  * @param stats Objeto IOStats para registrar las operaciones.
+ * @param device Índice en stats.devices al que se atribuye la escritura (-1: ninguno).
  * 
  * @note Si el buffer está vacío, no se realiza ninguna operación.
  * @note El tamaño de bloque (B) se utiliza para calcular las operaciones de I/O en bloques completos.
  */
 template<typename T>
-void writeBlock(std::ofstream& file, const std::vector<T>& buffer, IOStats& stats);
+void writeBlock(std::ofstream& file, const std::vector<T>& buffer, IOStats& stats, int device = -1);
 
 #endif
\ No newline at end of file
@@ -1,4 +1,8 @@
 #include "mergesort.h"
+#include "operators.h"
+#include "checkpoint.h"
+#include "simdmerge.h"
+#include "asyncio.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -8,28 +12,222 @@
 #include <utility>
 #include <cmath>
 #include <filesystem>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace fs = std::filesystem;
 
 /**
- * @brief Nodo para la cola de prioridad usada en la mezcla
+ * @brief Abre los archivos de entrada y carga el primer bloque de cada uno
  * 
- * Almacena un valor y el índice del archivo del cual proviene,
- * permitiendo comparar valores de diferentes archivos durante la mezcla.
+ * @param runFiles Archivos ordenados a mezclar
+ * @param bufferSize Cantidad de elementos por buffer de lectura
+ * @param stats Objeto para registrar estadísticas de I/O
+ */
+RunMerger::RunMerger(const std::vector<std::string>& runFiles, size_t bufferSize, IOStats& stats,
+                     bool releaseConsumed)
+    : inputStreams(runFiles.size()), buffers(runFiles.size()), positions(runFiles.size(), 0),
+      devices(runFiles.size()), releaseFds(runFiles.size(), -1), consumed(runFiles.size(), 0),
+      released(runFiles.size(), 0), bufferSize(bufferSize), stats(stats) {
+    for (size_t j = 0; j < runFiles.size(); ++j) {
+        inputStreams[j].open(runFiles[j], std::ios::binary);
+        devices[j] = stats.deviceOf(runFiles[j]);
+        if (releaseConsumed) {
+            releaseFds[j] = ::open(runFiles[j].c_str(), O_WRONLY);
+        }
+        readBlock(inputStreams[j], buffers[j], bufferSize, stats, devices[j]);
+        
+        if (!buffers[j].empty()) {
+            minHeap.push({buffers[j][0], j});
+        }
+    }
+}
+
+/**
+ * @brief Cierra los descriptores usados para liberar bloques
  */
-struct HeapNode {
+RunMerger::~RunMerger() {
+    for (int fd : releaseFds) {
+        if (fd >= 0) ::close(fd);
+    }
+}
+
+/**
+ * @brief Extrae el siguiente elemento del resultado mezclado
+ * 
+ * @param value Variable donde se deja el elemento extraído
+ * @return true si se extrajo un elemento, false si ya no quedan
+ * 
+ * @note Cuando el buffer de un archivo se agota se lee su siguiente bloque; con
+ *       releaseConsumed, antes se liberan en disco los bytes ya entregados
+ */
+bool RunMerger::next(int64_t& value) {
+    if (minHeap.empty()) return false;
+    
+    HeapNode top = minHeap.top();
+    minHeap.pop();
+    value = top.value;
+    
+    positions[top.fileIndex]++;
+    
+    if (positions[top.fileIndex] >= buffers[top.fileIndex].size()) {
+        consumed[top.fileIndex] += buffers[top.fileIndex].size() * sizeof(int64_t);
+        if (releaseFds[top.fileIndex] >= 0 &&
+            TempStorage::releaseRange(releaseFds[top.fileIndex], released[top.fileIndex],
+                                      consumed[top.fileIndex] - released[top.fileIndex])) {
+            released[top.fileIndex] = consumed[top.fileIndex];
+        }
+        buffers[top.fileIndex].clear();
+        readBlock(inputStreams[top.fileIndex], buffers[top.fileIndex], bufferSize, stats, devices[top.fileIndex]);
+        positions[top.fileIndex] = 0;
+    }
+    
+    if (positions[top.fileIndex] < buffers[top.fileIndex].size()) {
+        minHeap.push({buffers[top.fileIndex][positions[top.fileIndex]], top.fileIndex});
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Mezcla un conjunto de archivos ordenados en un único archivo de salida
+ * 
+ * @param runFiles Archivos ordenados a mezclar
+ * @param outputFilename Archivo de salida
+ * @param bufferSize Cantidad de elementos por buffer (entrada y salida)
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param dropDuplicates Si es true, cada clave se escribe una sola vez
+ * @param releaseInputs Si es true, libera los bloques de las entradas a medida que se mezclan
+ * @return uint64_t Checksum de lo escrito
+ */
+uint64_t mergeRuns(const std::vector<std::string>& runFiles, const std::string& outputFilename,
+                   size_t bufferSize, IOStats& stats, bool dropDuplicates, bool releaseInputs) {
+    RunMerger merger(runFiles, bufferSize, stats, releaseInputs);
+    
+    std::ofstream outputStream(outputFilename, std::ios::binary);
+    OperatorSink sink(outputStream, dropDuplicates ? SortOperator::DISTINCT : SortOperator::NONE,
+                      bufferSize, stats, stats.deviceOf(outputFilename));
+    
     int64_t value;
-    size_t fileIndex;
+    while (merger.next(value)) {
+        sink.push(value);
+    }
     
-    /**
-     * @brief Operador de comparación para ordenar el min-heap
-     * @param other Otro nodo a comparar
-     * @return true si este nodo es mayor que el otro
-     */
-    bool operator>(const HeapNode& other) const {
-        return value > other.value;
+    sink.finish();
+    outputStream.close();
+    return sink.checksum();
+}
+
+/**
+ * @brief Ejecuta una pasada de mezcla agrupando los archivos de a `arity`
+ * 
+ * @param runFiles Archivos ordenados de la pasada actual
+ * @param storage Directorios temporales donde se crean los archivos mezclados
+ * @param pass Número de pasada
+ * @param arity Número de archivos a mezclar simultáneamente
+ * @param bufferSize Cantidad de elementos por buffer
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param dropDuplicates Si es true, los duplicados se eliminan durante la pasada
+ * @param manifest Si no es nulo, cada grupo se confirma al terminar y los grupos
+ *                 ya confirmados en una ejecución anterior se reutilizan
+ * @param reclaim Si es true, las entradas de cada grupo se eliminan al confirmar su
+ *                salida; sin manifiesto además se liberan sus bloques durante la mezcla
+ * @param async Si no es nulo y está habilitado, cada grupo se mezcla con asyncMergeRuns
+ * @param asyncReport Si no es nulo, acumula el reporte de la I/O asíncrona
+ * @return std::vector<std::string> Archivos generados por la pasada
+ * 
+ * @note El número de pasada se incluye en el nombre del archivo: con un solo
+ *       nombre merged_[i].bin la segunda pasada truncaba merged_0.bin mientras
+ *       aún lo estaba leyendo
+ * @note Con varios directorios, cada salida va al que tiene menos entradas de su
+ *       grupo, para no escribir en el mismo disco del que se está leyendo
+ */
+std::vector<std::string> mergePass(const std::vector<std::string>& runFiles, TempStorage& storage,
+                                   size_t pass, size_t arity, size_t bufferSize, IOStats& stats,
+                                   bool dropDuplicates, SortManifest* manifest, bool reclaim,
+                                   const AsyncIOOptions* async, AsyncIOReport* asyncReport) {
+    std::vector<std::string> newChunkFiles;
+    
+    for (size_t i = 0; i < runFiles.size(); i += arity) {
+        size_t filesCount = std::min(arity, runFiles.size() - i);
+        std::vector<std::string> group(runFiles.begin() + i, runFiles.begin() + i + filesCount);
+        std::string outputName = "merged_" + std::to_string(pass) + "_" + 
+                                 std::to_string(newChunkFiles.size()) + ".bin";
+        
+        if (manifest) {
+            std::string previous = storage.find(outputName);
+            if (!previous.empty() && manifest->verify(previous, bufferSize, stats)) {
+                newChunkFiles.push_back(previous);
+                continue;
+            }
+        }
+        
+        std::string outputChunk = storage.placeAwayFrom(outputName, group);
+        newChunkFiles.push_back(outputChunk);
+        // Con manifiesto no se liberan bloques: una caída a mitad del grupo
+        // necesita sus entradas intactas para repetirlo
+        bool release = reclaim && !(manifest && manifest->enabled());
+        uint64_t checksum = async && async->enabled
+            ? asyncMergeRuns(group, outputChunk, bufferSize, stats, dropDuplicates, release, *async, asyncReport)
+            : mergeRuns(group, outputChunk, bufferSize, stats, dropDuplicates, release);
+        storage.sampleUsage();
+        
+        if (manifest) {
+            manifest->recordFile(outputChunk, fs::file_size(outputChunk), checksum);
+            if (reclaim) {
+                manifest->set("merge.consumed", std::to_string(i + filesCount));
+                for (const auto& file : group) {
+                    manifest->forget(file);
+                }
+            }
+            manifest->commit();
+        }
+        if (reclaim) {
+            for (const auto& file : group) {
+                fs::remove(file);
+            }
+        }
+    }
+    
+    return newChunkFiles;
+}
+
+/**
+ * @brief Une una lista de archivos en una sola línea (para el manifiesto)
+ */
+static std::string joinFiles(const std::vector<std::string>& files) {
+    std::string joined;
+    for (const auto& file : files) {
+        if (!joined.empty()) joined += " ";
+        joined += file;
+    }
+    return joined;
+}
+
+/**
+ * @brief Separa una lista producida por joinFiles
+ */
+static std::vector<std::string> splitFiles(const std::string& joined) {
+    std::vector<std::string> files;
+    std::istringstream in(joined);
+    std::string file;
+    while (in >> file) {
+        files.push_back(file);
+    }
+    return files;
+}
+
+/**
+ * @brief Pasadas de mezcla (incluida la final) que necesitan `runs` runs con aridad `arity`
+ */
+static size_t mergePassesFor(size_t runs, size_t arity) {
+    size_t passes = 0;
+    for (size_t remaining = runs; remaining > 1; remaining = (remaining + arity - 1) / arity) {
+        passes++;
     }
-};
+    return passes;
+}
 
 /**
  * @brief Implementa el algoritmo de MergeSort externo
@@ -39,29 +237,61 @@ struct HeapNode {
  * @param arity Número de archivos a mezclar simultáneamente
  * @param memoryLimit Límite de memoria en bytes
  * @param stats Objeto para registrar estadísticas de I/O
+ * @param options Opciones adicionales (operador sobre la salida, detección de orden previo, checkpoints)
  * 
  * @note Opera en dos fases principales:
  *   1. División: Divide el archivo en chunks ordenados
  *   2. Mezcla: Mezcla recursiva los chunks usando una cola de prioridad
+ * @note La última mezcla (a lo más `arity` archivos) escribe directamente en
+ *       outputFilename aplicando options.op; con DISTINCT los duplicados también
+ *       se eliminan al formar los chunks y en las pasadas intermedias
+ * @note Con options.adaptive la división detecta runs naturales: una entrada
+ *       ordenada termina tras una sola pasada de lectura/escritura, una
+ *       descendente se invierte y los chunks que continúan un run se unen a él
+ *       (dejando los pocos elementos rezagados en un run secundario)
+ * @note Con options.checkpoint se confirma el estado tras cada chunk y cada grupo
+ *       de mezcla. Al reanudar se verifican los checksums de los archivos
+ *       confirmados (truncando lo escrito después del último checkpoint) y se
+ *       continúa desde ahí; si algo no coincide se comienza desde cero
+ * @note Con varios options.tempDirs los runs se reparten entre ellos según
+ *       options.placement y cada salida de mezcla se escribe lejos de sus entradas
+ * @note Con options.reclaimSpace cada grupo se elimina al terminar su mezcla y, sin
+ *       checkpoints, los bloques ya mezclados de cada run se liberan durante la
+ *       mezcla, de modo que el espacio temporal se acerca a 1 vez la entrada en vez
+ *       de 2 (el máximo medido queda en stats.peakTempBytes)
+ * @note Con options.asyncIO.enabled las mezclas usan asyncMergeRuns (corrutinas
+ *       sobre un pool de hilos o io_uring); GROUP_COUNT mantiene la mezcla final síncrona
+ * @note options.progress recibe los bytes de cada fase; options.cancel se consulta
+ *       en cada bloque y, si se pidió cancelar, se eliminan los temporales (salvo
+ *       con checkpoints, que quedan para reanudar) y se relanza SortCancelled
  * 
- * @warning Crea y elimina archivos temporales en el directorio ./temp_[arity]
+ * @warning Crea y elimina archivos temporales en ./temp_[arity] (o en
+ *          [raíz]/temp_[arity] para cada raíz de options.tempDirs, con el sufijo
+ *          _[options.tempNamespace] si lo hay)
  */
 void externalMergeSort(const std::string& inputFilename, const std::string& outputFilename, 
-                      size_t arity, size_t memoryLimit, IOStats& stats) {
+                      size_t arity, size_t memoryLimit, IOStats& stats, const SortOptions& options) {
     auto startTime = std::chrono::high_resolution_clock::now();
     stats.reset();
+    ProgressScope progressScope(stats, options.progress, options.cancel);
     
-    std::string tempDir = "./temp_" + std::to_string(arity);
-    if (!fs::exists(tempDir)) {
-        fs::create_directories(tempDir);
-    }
+    std::string tempName = "temp_" + std::to_string(arity) +
+                           (options.tempNamespace.empty() ? "" : "_" + options.tempNamespace);
+    TempStorage storage(TempStorage::directoriesFor(options.tempDirs, tempName),
+                        options.placement, stats);
+    const std::string& tempDir = storage.primary();
     
     size_t numbersInMemory = memoryLimit / sizeof(int64_t);
+    size_t bufferSize = (memoryLimit / (arity + 1)) / sizeof(int64_t);
+    if (bufferSize < 1) bufferSize = 1;
     
     // Fase de división
     std::vector<std::string> chunkFiles;
     int64_t fileSize = fs::file_size(inputFilename);
     int64_t totalChunks = std::ceil(static_cast<double>(fileSize) / (numbersInMemory * sizeof(int64_t)));
+    if (options.progress) {
+        options.progress->expect(2 * fileSize * (1 + mergePassesFor(totalChunks, arity)));
+    }
     
     std::ifstream inputFile(inputFilename, std::ios::binary);
     if (!inputFile) {
@@ -69,114 +299,314 @@ void externalMergeSort(const std::string& inputFilename, const std::string& outp
         return;
     }
     
-    for (int64_t chunk = 0; chunk < totalChunks; ++chunk) {
-        std::vector<int64_t> buffer;
-        readBlock(inputFile, buffer, numbersInMemory, stats);
-        std::sort(buffer.begin(), buffer.end());
+    // Con options.adaptive cada chunk se analiza antes de ordenarlo: los chunks
+    // monótonos no se ordenan, y la parte de un chunk ordenado que no es menor
+    // que el último valor escrito continúa el run anterior en vez de abrir un
+    // archivo nuevo. Si lo que queda fuera es poco (desorden local, típico de
+    // logs casi ordenados) se escribe en un run secundario de "rezagados"
+    PresortScanner scanner;
+    std::ofstream chunkFile;
+    std::ofstream spillFile;
+    std::string chunkPath;
+    std::string spillPath;
+    int64_t runLast = 0;
+    int64_t spillLast = 0;
+    bool eachChunkOwnRun = true;
+    int64_t firstChunk = 0;
+    size_t pass = 0;
+    size_t formedRuns = 0;
+    bool runsFormed = false;
+    PresortInfo presort;
+    
+    SortManifest manifest(tempDir, sortSignature("mergesort", inputFilename, arity, memoryLimit, options),
+                          options.checkpoint, options.stopAfterSteps);
+    
+    // Reanudación: el manifiesto guarda la fase ("runs" o "merge"), los archivos
+    // vivos de esa fase y lo necesario para continuar la división donde quedó
+    if (manifest.resumed()) {
+        std::string phase = manifest.get("phase");
+        std::vector<std::string> files = splitFiles(manifest.get("runs"));
+        bool consistent = phase == "runs" || phase == "merge";
         
-        std::string chunkFilename = tempDir + "/chunk_" + std::to_string(chunk) + ".bin";
-        std::ofstream chunkFile(chunkFilename, std::ios::binary);
-        writeBlock(chunkFile, buffer, stats);
-        chunkFile.close();
+        // Con reclaimSpace las entradas de los grupos ya mezclados se eliminaron;
+        // en su lugar deben estar las salidas confirmadas de esos grupos
+        size_t consumed = phase == "merge" ? std::stoull(manifest.get("merge.consumed", "0")) : 0;
+        for (size_t i = consumed; i < files.size(); ++i) {
+            consistent = consistent && manifest.verify(files[i], bufferSize, stats);
+        }
+        for (size_t group = 0; consistent && group * arity < consumed; ++group) {
+            std::string merged = storage.find("merged_" + manifest.get("merge.pass", "0") + "_" +
+                                              std::to_string(group) + ".bin");
+            consistent = !merged.empty() && manifest.verify(merged, bufferSize, stats);
+        }
+        consistent = consistent && scanner.restore(manifest.get("runs.scanner"));
         
-        chunkFiles.push_back(chunkFilename);
+        if (consistent) {
+            chunkFiles = files;
+            eachChunkOwnRun = manifest.get("runs.ownRun") == "1";
+            
+            if (phase == "runs") {
+                firstChunk = std::stoll(manifest.get("runs.next", "0"));
+                runLast = std::stoll(manifest.get("runs.last", "0"));
+                spillLast = std::stoll(manifest.get("runs.spillLast", "0"));
+                chunkPath = manifest.get("runs.open", "-");
+                spillPath = manifest.get("runs.spill", "-");
+                if (chunkPath != "-") chunkFile.open(chunkPath, std::ios::binary | std::ios::app);
+                if (spillPath != "-") spillFile.open(spillPath, std::ios::binary | std::ios::app);
+                inputFile.seekg(firstChunk * numbersInMemory * sizeof(int64_t));
+            } else {
+                firstChunk = totalChunks;
+                runsFormed = true;
+                pass = std::stoull(manifest.get("merge.pass", "0"));
+                formedRuns = std::stoull(manifest.get("runs.formed", "0"));
+            }
+            std::cout << "Reanudando desde checkpoint: fase " << phase << ", " << chunkFiles.size()
+                      << " archivos, chunk " << firstChunk << ", pasada " << pass << std::endl;
+        } else {
+            std::cout << "Checkpoint inconsistente en " << tempDir << ", se comienza desde cero" << std::endl;
+            manifest.clear();
+        }
     }
-    inputFile.close();
     
-    // Fase de mezcla
-    size_t bufferSize = (memoryLimit / (arity + 1)) / sizeof(int64_t);
-    if (bufferSize < 1) bufferSize = 1;
+    auto appendToRun = [&](std::ofstream& run, std::string& path, int64_t& last, const std::string& prefix,
+                           int64_t chunk, const std::vector<int64_t>& data, bool extend) {
+        if (!extend) {
+            if (run.is_open()) run.close();
+            
+            path = storage.place(prefix + "_" + std::to_string(chunk) + ".bin");
+            run.open(path, std::ios::binary);
+            chunkFiles.push_back(path);
+        }
+        writeBlock(run, data, stats, stats.deviceOf(path));
+        manifest.recordWrite(path, data);
+        last = data.back();
+    };
     
-    while (chunkFiles.size() > 1) {
-        std::vector<std::string> newChunkFiles;
+    // Confirma el estado de la división tras procesar un chunk
+    auto saveRunState = [&](int64_t nextChunk) {
+        if (!manifest.enabled()) return;
         
-        for (size_t i = 0; i < chunkFiles.size(); i += arity) {
-            size_t filesCount = std::min(arity, chunkFiles.size() - i);
-            std::string outputChunk = tempDir + "/merged_" + std::to_string(newChunkFiles.size()) + ".bin";
-            
-            std::vector<std::ifstream> inputStreams(filesCount);
-            std::vector<std::vector<int64_t>> buffers(filesCount);
-            std::vector<size_t> positions(filesCount, 0);
-            std::priority_queue<HeapNode, std::vector<HeapNode>, std::greater<HeapNode>> minHeap;
+        if (chunkFile.is_open()) chunkFile.flush();
+        if (spillFile.is_open()) spillFile.flush();
+        manifest.set("phase", "runs");
+        manifest.set("runs", joinFiles(chunkFiles));
+        manifest.set("runs.next", std::to_string(nextChunk));
+        manifest.set("runs.last", std::to_string(runLast));
+        manifest.set("runs.spillLast", std::to_string(spillLast));
+        manifest.set("runs.open", chunkFile.is_open() ? chunkPath : "-");
+        manifest.set("runs.spill", spillFile.is_open() ? spillPath : "-");
+        manifest.set("runs.ownRun", eachChunkOwnRun ? "1" : "0");
+        manifest.set("runs.scanner", scanner.state());
+        manifest.commit();
+    };
+    
+    // Confirma la lista de archivos de la pasada de mezcla siguiente
+    auto saveMergeState = [&]() {
+        if (!manifest.enabled()) return;
+        
+        manifest.set("phase", "merge");
+        manifest.set("runs", joinFiles(chunkFiles));
+        manifest.set("merge.pass", std::to_string(pass));
+        manifest.set("merge.consumed", "0");
+        manifest.set("runs.formed", std::to_string(formedRuns));
+        manifest.set("runs.ownRun", eachChunkOwnRun ? "1" : "0");
+        manifest.set("runs.scanner", scanner.state());
+        manifest.commit();
+    };
+    
+    bool outputStarted = false;
+    try {
+        if (options.progress) options.progress->setPhase(SortPhase::RUN_FORMATION);
+        for (int64_t chunk = firstChunk; chunk < totalChunks; ++chunk) {
+            std::vector<int64_t> buffer;
+            readBlock(inputFile, buffer, numbersInMemory, stats);
             
-            for (size_t j = 0; j < filesCount; ++j) {
-                inputStreams[j].open(chunkFiles[i + j], std::ios::binary);
-                readBlock(inputStreams[j], buffers[j], bufferSize, stats);
-                
-                if (!buffers[j].empty()) {
-                    minHeap.push({buffers[j][0], j});
-                    positions[j] = 0;
+            if (options.adaptive) {
+                PresortInfo chunkInfo = scanner.scan(buffer);
+                if (chunkInfo.descending() && !chunkInfo.ascending()) {
+                    std::reverse(buffer.begin(), buffer.end());
+                } else if (!chunkInfo.ascending()) {
+                    simdSort(buffer);
                 }
+            } else {
+                simdSort(buffer);
             }
             
-            std::ofstream outputStream(outputChunk, std::ios::binary);
-            std::vector<int64_t> outputBuffer;
-            outputBuffer.reserve(bufferSize);
+            if (options.op == SortOperator::DISTINCT) {
+                buffer.erase(std::unique(buffer.begin(), buffer.end()), buffer.end());
+            }
+            if (buffer.empty()) continue;
             
-            while (!minHeap.empty()) {
-                HeapNode top = minHeap.top();
-                minHeap.pop();
-                
-                outputBuffer.push_back(top.value);
-                
-                if (outputBuffer.size() >= bufferSize) {
-                    writeBlock(outputStream, outputBuffer, stats);
-                    outputBuffer.clear();
+            // Elementos del chunk menores que el final del run abierto
+            size_t behind = buffer.size();
+            if (options.adaptive && chunkFile.is_open()) {
+                behind = std::lower_bound(buffer.begin(), buffer.end(), runLast) - buffer.begin();
+            }
+            
+            if (behind == 0) {
+                if (options.op == SortOperator::DISTINCT && buffer.front() == runLast) {
+                    buffer.erase(buffer.begin());
                 }
-                
-                positions[top.fileIndex]++;
-                
-                if (positions[top.fileIndex] >= buffers[top.fileIndex].size()) {
-                    buffers[top.fileIndex].clear();
-                    readBlock(inputStreams[top.fileIndex], buffers[top.fileIndex], bufferSize, stats);
-                    positions[top.fileIndex] = 0;
+                if (!buffer.empty()) {
+                    appendToRun(chunkFile, chunkPath, runLast, "chunk", chunk, buffer, true);
                 }
+                eachChunkOwnRun = false;
+            } else if (behind * 8 <= buffer.size()) {
+                std::vector<int64_t> spill(buffer.begin(), buffer.begin() + behind);
+                buffer.erase(buffer.begin(), buffer.begin() + behind);
                 
-                if (positions[top.fileIndex] < buffers[top.fileIndex].size()) {
-                    minHeap.push({buffers[top.fileIndex][positions[top.fileIndex]], top.fileIndex});
-                }
+                bool extendSpill = spillFile.is_open() && spill.front() >= spillLast;
+                appendToRun(spillFile, spillPath, spillLast, "spill", chunk, spill, extendSpill);
+                appendToRun(chunkFile, chunkPath, runLast, "chunk", chunk, buffer, true);
+                eachChunkOwnRun = false;
+            } else {
+                appendToRun(chunkFile, chunkPath, runLast, "chunk", chunk, buffer, false);
             }
             
-            if (!outputBuffer.empty()) {
-                writeBlock(outputStream, outputBuffer, stats);
+            saveRunState(chunk + 1);
+        }
+        if (chunkFile.is_open()) chunkFile.close();
+        if (spillFile.is_open()) spillFile.close();
+        inputFile.close();
+        
+        if (!runsFormed) {
+            formedRuns = chunkFiles.size();
+            saveMergeState();
+        }
+        storage.sampleUsage();
+        
+        // Planificación según el orden previo detectado
+        presort = scanner.info();
+        presort.mergeInputs = formedRuns;
+        if (!options.adaptive) {
+            presort.strategy = PresortStrategy::STANDARD;
+        } else if (presort.ascending()) {
+            presort.strategy = PresortStrategy::ALREADY_SORTED;
+        } else if (presort.descending() && eachChunkOwnRun) {
+            presort.strategy = PresortStrategy::REVERSE;
+        } else if (static_cast<int64_t>(formedRuns) < totalChunks) {
+            presort.strategy = PresortStrategy::NATURAL_RUNS;
+        } else {
+            presort.strategy = PresortStrategy::STANDARD;
+        }
+        
+        // Con los runs ya formados se sabe cuántas pasadas faltan
+        if (options.progress) {
+            size_t remaining = presort.strategy == PresortStrategy::REVERSE ? 1
+                             : chunkFiles.size() == 1 && options.op == SortOperator::NONE ? 0
+                             : mergePassesFor(chunkFiles.size(), arity);
+            options.progress->expect(options.progress->snapshot().bytes() + 2 * fileSize * remaining);
+            options.progress->setPhase(SortPhase::MERGE, pass);
+        }
+        
+        // Fase de mezcla
+        outputStarted = true;
+        if (chunkFiles.size() == 1 && options.op == SortOperator::NONE) {
+            // Un único run (entrada ordenada, invertida o que cabe en memoria) ya es la salida
+            std::error_code error;
+            fs::rename(chunkFiles[0], outputFilename, error);
+            if (error) {
+                fs::copy_file(chunkFiles[0], outputFilename, fs::copy_options::overwrite_existing);
             }
+        } else if (presort.strategy == PresortStrategy::REVERSE) {
+            // Entrada descendente: cada run invertido tiene claves menores que el
+            // anterior, así que basta concatenarlos en orden inverso
+            std::ofstream outputFile(outputFilename, std::ios::binary);
+            OperatorSink sink(outputFile, options.op, bufferSize, stats);
             
-            for (auto& stream : inputStreams) {
-                stream.close();
+            for (auto it = chunkFiles.rbegin(); it != chunkFiles.rend(); ++it) {
+                std::ifstream runFile(*it, std::ios::binary);
+                std::vector<int64_t> buffer;
+                while (readBlock(runFile, buffer, bufferSize, stats, stats.deviceOf(*it)) > 0) {
+                    sink.push(buffer);
+                }
             }
-            outputStream.close();
             
-            newChunkFiles.push_back(outputChunk);
-        }
-        
-        chunkFiles = newChunkFiles;
-    }
-    
-    if (!chunkFiles.empty()) {
-        std::ifstream finalFile(chunkFiles[0], std::ios::binary);
-        std::ofstream outputFile(outputFilename, std::ios::binary);
-        
-        std::vector<int64_t> copyBuffer;
-        while (finalFile) {
-            size_t read = readBlock(finalFile, copyBuffer, numbersInMemory, stats);
-            if (read > 0) {
-                writeBlock(outputFile, copyBuffer, stats);
+            sink.finish();
+            outputFile.close();
+        } else {
+            bool dropDuplicates = options.op == SortOperator::DISTINCT;
+            while (chunkFiles.size() > arity) {
+                if (options.progress) options.progress->setPhase(SortPhase::MERGE, pass);
+                std::vector<std::string> merged = mergePass(chunkFiles, storage, pass, arity, bufferSize,
+                                                            stats, dropDuplicates, &manifest,
+                                                            options.reclaimSpace, &options.asyncIO,
+                                                            options.asyncReport);
+                
+                // La pasada terminó: sus entradas se eliminan después de confirmar sus salidas
+                for (const auto& file : chunkFiles) {
+                    manifest.forget(file);
+                }
+                std::swap(chunkFiles, merged);
+                pass++;
+                saveMergeState();
+                
+                for (const auto& file : merged) {
+                    fs::remove(file);
+                }
+            }
+            
+            // Mezcla final: escribe directo en el archivo de salida aplicando el operador.
+            // Sin checkpoints nada vuelve a leer los runs, así que con reclaimSpace
+            // sus bloques se liberan a medida que pasan a la salida
+            bool release = options.reclaimSpace && !options.checkpoint;
+            if (options.progress) options.progress->setPhase(SortPhase::MERGE, pass);
+            if (options.asyncIO.enabled && options.op != SortOperator::GROUP_COUNT) {
+                asyncMergeRuns(chunkFiles, outputFilename, bufferSize, stats, options.op == SortOperator::DISTINCT,
+                               release, options.asyncIO, options.asyncReport);
             } else {
-                break;
+                RunMerger merger(chunkFiles, bufferSize, stats, release);
+                std::ofstream outputFile(outputFilename, std::ios::binary);
+                OperatorSink sink(outputFile, options.op, bufferSize, stats);
+                
+                int64_t value;
+                while (merger.next(value)) {
+                    sink.push(value);
+                }
+                
+                sink.finish();
+                outputFile.close();
             }
         }
-        
-        finalFile.close();
-        outputFile.close();
+    } catch (const SortInterrupted& interrupted) {
+        // El estado queda en tempDir para que la siguiente llamada lo reanude
+        std::cout << "MergeSort externo " << interrupted.what() << "; estado en " << tempDir << std::endl;
+        return;
+    } catch (const SortCancelled& cancelled) {
+        // Con checkpoints el estado se conserva para reanudar; sin ellos no sirve de nada
+        progressScope.cancelled();
+        if (chunkFile.is_open()) chunkFile.close();
+        if (spillFile.is_open()) spillFile.close();
+        if (manifest.enabled()) {
+            std::cout << "MergeSort externo " << cancelled.what() << "; estado en " << tempDir << std::endl;
+        } else {
+            storage.remove();
+            if (outputStarted) fs::remove(outputFilename);
+            std::cout << "MergeSort externo " << cancelled.what() << "; archivos temporales eliminados" << std::endl;
+        }
+        throw;
     }
     
-    for (const auto& entry : fs::directory_iterator(tempDir)) {
-        fs::remove(entry.path());
+    if (options.presortInfo) {
+        *options.presortInfo = presort;
     }
-    fs::remove(tempDir);
+    
+    storage.remove();
     
     auto endTime = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = endTime - startTime;
     
     std::cout << "Aridad " << arity << " completada en " << duration.count() << " segundos" << std::endl;
-}
\ No newline at end of file
+    if (options.adaptive) {
+        std::cout << "Orden previo: " << presort.ascendingRuns << " runs ascendentes (máx. " 
+                  << presort.longestAscendingRun << "), " << presort.descendingRuns 
+                  << " runs descendentes (máx. " << presort.longestDescendingRun << "), "
+                  << presort.mergeInputs << " runs a mezclar, estrategia: " 
+                  << presortStrategyName(presort.strategy) << std::endl;
+    }
+    if (fileSize > 0) {
+        std::cout << "Espacio temporal máximo: " << stats.peakTempBytes / (1024.0 * 1024.0) << " MB ("
+                  << static_cast<double>(stats.peakTempBytes) / fileSize << " veces la entrada)" << std::endl;
+    }
+    storage.report();
+}
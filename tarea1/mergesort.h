@@ -2,24 +2,162 @@
 #define MERGESORT_H
 
 #include "iostats.h"
+#include "sortoptions.h"
+#include "tempstorage.h"
+#include <string>
+#include <vector>
+#include <queue>
+#include <fstream>
+#include <functional>
+
+class SortManifest;
+
+/**
+ * @brief Nodo para la cola de prioridad usada en la mezcla
+ *
+ * Almacena un valor y el índice del archivo del cual proviene,
+ * permitiendo comparar valores de diferentes archivos durante la mezcla.
+ */
+struct HeapNode {
+    int64_t value;
+    size_t fileIndex;
+
+    /**
+     * @brief Operador de comparación para ordenar el min-heap
+     * @param other Otro nodo a comparar
+     * @return true si este nodo es mayor que el otro
+     */
+    bool operator>(const HeapNode& other) const {
+        return value > other.value;
+    }
+};
+
+/**
+ * @brief Mezcla k-vías de archivos ordenados con interfaz de extracción (pull)
+ *
+ * Mantiene un buffer de lectura por archivo y un min-heap con el elemento
+ * actual de cada uno. Cada llamada a next() entrega el siguiente elemento
+ * del resultado mezclado, leyendo bloques de disco solo cuando un buffer se agota.
+ *
+ * @note Los archivos deben existir mientras el objeto esté en uso
+ * @note Con releaseConsumed, cada vez que se agota el buffer de un archivo se liberan
+ *       en disco los bloques ya mezclados (TempStorage::releaseRange): el archivo
+ *       queda inutilizable, pero el espacio temporal no crece durante la mezcla
+ */
+class RunMerger {
+public:
+    /**
+     * @brief Abre los archivos de entrada y carga el primer bloque de cada uno
+     *
+     * @param runFiles Archivos ordenados a mezclar
+     * @param bufferSize Cantidad de elementos por buffer de lectura
+     * @param stats Objeto para registrar estadísticas de I/O
+     * @param releaseConsumed Si es true, libera los bloques de cada archivo a medida que se consumen
+     */
+    RunMerger(const std::vector<std::string>& runFiles, size_t bufferSize, IOStats& stats,
+              bool releaseConsumed = false);
+
+    /** @brief Cierra los descriptores usados para liberar bloques */
+    ~RunMerger();
+
+    /**
+     * @brief Extrae el siguiente elemento del resultado mezclado
+     *
+     * @param value Variable donde se deja el elemento extraído
+     * @return true si se extrajo un elemento, false si ya no quedan
+     */
+    bool next(int64_t& value);
+
+private:
+    std::vector<std::ifstream> inputStreams;
+    std::vector<std::vector<int64_t>> buffers;
+    std::vector<size_t> positions;
+    std::vector<int> devices;
+    std::vector<int> releaseFds;
+    std::vector<uint64_t> consumed;
+    std::vector<uint64_t> released;
+    std::priority_queue<HeapNode, std::vector<HeapNode>, std::greater<HeapNode>> minHeap;
+    size_t bufferSize;
+    IOStats& stats;
+};
+
+/**
+ * @brief Mezcla un conjunto de archivos ordenados en un único archivo de salida
+ *
+ * @param runFiles Archivos ordenados a mezclar
+ * @param outputFilename Archivo de salida
+ * @param bufferSize Cantidad de elementos por buffer (entrada y salida)
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param dropDuplicates Si es true, cada clave se escribe una sola vez
+ * @param releaseInputs Si es true, libera los bloques de las entradas a medida que se mezclan
+ * @return uint64_t Checksum (ver checkpoint.h) de lo escrito
+ */
+uint64_t mergeRuns(const std::vector<std::string>& runFiles, const std::string& outputFilename,
+                   size_t bufferSize, IOStats& stats, bool dropDuplicates = false,
+                   bool releaseInputs = false);
+
+/**
+ * @brief Ejecuta una pasada de mezcla agrupando los archivos de a `arity`
+ *
+ * @param runFiles Archivos ordenados de la pasada actual
+ * @param storage Directorios temporales donde se crean los archivos mezclados
+ * @param pass Número de pasada (forma parte del nombre de los archivos generados)
+ * @param arity Número de archivos a mezclar simultáneamente
+ * @param bufferSize Cantidad de elementos por buffer
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param dropDuplicates Si es true, los duplicados se eliminan durante la pasada
+ * @param manifest Si no es nulo, cada grupo mezclado se confirma en el manifiesto
+ *                 y los grupos ya confirmados (y verificados) no se vuelven a mezclar
+ * @param reclaim Si es true, las entradas de cada grupo se eliminan apenas se confirma
+ *                su salida y, sin manifiesto, sus bloques se liberan durante la mezcla
+ * @param async Si no es nulo y está habilitado, opciones de la I/O asíncrona
+ * @param asyncReport Si no es nulo, acumula el reporte de la I/O asíncrona
+ * @return std::vector<std::string> Archivos generados por la pasada
+ *
+ * @note Los archivos generados se llaman merged_[pass]_[i].bin, de modo que una
+ *       pasada nunca trunca un archivo que todavía está siendo leído
+ * @note Cada salida se ubica en el directorio con menos entradas de su grupo
+ * @note Con reclaim y manifiesto, la clave merge.consumed guarda cuántas entradas
+ *       de la pasada ya se eliminaron
+ * @note Con async (y async->enabled) cada grupo se mezcla con asyncMergeRuns
+ */
+std::vector<std::string> mergePass(const std::vector<std::string>& runFiles, TempStorage& storage,
+                                   size_t pass, size_t arity, size_t bufferSize, IOStats& stats,
+                                   bool dropDuplicates = false, SortManifest* manifest = nullptr,
+                                   bool reclaim = false, const AsyncIOOptions* async = nullptr,
+                                   AsyncIOReport* asyncReport = nullptr);
 
 /**
  * @brief Ordena un archivo grande usando el algoritmo de MergeSort externo
- * 
+ *
  * @param inputFilename Archivo de entrada a ordenar
  * @param outputFilename Archivo de salida ordenado
  * @param arity Número de archivos a mezclar simultáneamente
  * @param memoryLimit Límite de memoria en bytes
  * @param stats Objeto para registrar estadísticas de operaciones de I/O
- * 
+ * @param options Opciones adicionales (operador sobre la salida, detección de orden previo)
+ *
  * @note Opera en dos fases principales:
  *   1. División: Divide el archivo en chunks ordenados
  *   2. Mezcla: Mezcla recursiva los chunks usando una cola de prioridad
- * 
- * @warning Crea archivos temporales en el directorio ./temp_[arity]
+ * @note La última mezcla escribe directamente en outputFilename aplicando options.op
+ * @note Con options.adaptive aprovecha entradas ordenadas, descendentes o con runs largos
+ * @note Con options.checkpoint cada run y cada grupo de mezcla se confirma en
+ *       ./temp_[arity]/manifest.txt; si el proceso muere, volver a llamar con la
+ *       misma entrada y parámetros continúa desde el último checkpoint
+ *
+ * @note Con varios options.tempDirs los runs se reparten entre los directorios y
+ *       cada mezcla escribe en un directorio distinto de los que lee
+ * @note Con options.cancel la cancelación toma efecto en el siguiente bloque: se
+ *       eliminan los temporales (se conservan con checkpoints) y se lanza SortCancelled
+ *
+ * @warning Crea archivos temporales en ./temp_[arity] (o [raíz]/temp_[arity] por cada options.tempDirs),
+ *          con el sufijo _[options.tempNamespace] si lo hay: dos ordenamientos concurrentes
+ *          con la misma aridad necesitan sufijos distintos
  */
 
-void externalMergeSort(const std::string& inputFilename, const std::string& outputFilename, 
-                     size_t arity, size_t memoryLimit, IOStats& stats);
+void externalMergeSort(const std::string& inputFilename, const std::string& outputFilename,
+                     size_t arity, size_t memoryLimit, IOStats& stats,
+                     const SortOptions& options = SortOptions());
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,202 @@
+#include "operators.h"
+#include "streamsort.h"
+#include "checkpoint.h"
+#include <iostream>
+#include <chrono>
+
+/**
+ * @brief Crea el destino sobre un archivo ya abierto
+ *
+ * @param output Archivo de salida en modo binario
+ * @param op Operador a aplicar
+ * @param bufferSize Cantidad de elementos del buffer de escritura
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param device Dispositivo de stats al que se atribuyen las escrituras (-1: ninguno)
+ * @param checksumSeed Valor inicial de checksum()
+ */
+OperatorSink::OperatorSink(std::ofstream& output, SortOperator op, size_t bufferSize, IOStats& stats, int device,
+                           uint64_t checksumSeed)
+    : output(output), op(op), bufferSize(bufferSize < 2 ? 2 : bufferSize), stats(stats), device(device),
+      outputChecksum(checksumSeed) {
+    buffer.reserve(this->bufferSize);
+}
+
+/**
+ * @brief Escribe un int64_t al buffer, vaciándolo a disco cuando se llena
+ *
+ * @param value Valor a escribir
+ */
+void OperatorSink::emit(int64_t value) {
+    buffer.push_back(value);
+    recordsWritten++;
+    outputChecksum = checksumValue(outputChecksum, value);
+
+    if (buffer.size() >= bufferSize) {
+        writeBlock(output, buffer, stats, device);
+        buffer.clear();
+    }
+}
+
+/**
+ * @brief Agrega el siguiente elemento del flujo ordenado
+ *
+ * @param value Elemento (mayor o igual que el anterior)
+ */
+void OperatorSink::push(int64_t value) {
+    switch (op) {
+        case SortOperator::NONE:
+            emit(value);
+            break;
+
+        case SortOperator::DISTINCT:
+            if (!hasCurrent || value != current) {
+                emit(value);
+                current = value;
+                hasCurrent = true;
+            }
+            break;
+
+        case SortOperator::GROUP_COUNT:
+            if (hasCurrent && value == current) {
+                currentCount++;
+            } else {
+                if (hasCurrent) {
+                    emit(current);
+                    emit(currentCount);
+                }
+                current = value;
+                currentCount = 1;
+                hasCurrent = true;
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Agrega un tramo ordenado completo
+ *
+ * @param values Elementos en orden ascendente
+ */
+void OperatorSink::push(const std::vector<int64_t>& values) {
+    for (int64_t value : values) {
+        push(value);
+    }
+}
+
+/**
+ * @brief Emite el grupo pendiente sin vaciar el buffer
+ */
+void OperatorSink::endGroup() {
+    if (op == SortOperator::GROUP_COUNT && hasCurrent) {
+        emit(current);
+        emit(currentCount);
+        hasCurrent = false;
+    }
+}
+
+/**
+ * @brief Emite el último grupo pendiente y vacía el buffer
+ */
+void OperatorSink::finish() {
+    endGroup();
+
+    if (!buffer.empty()) {
+        writeBlock(output, buffer, stats, device);
+        buffer.clear();
+    }
+}
+
+/**
+ * @brief Carga un archivo completo en un StreamingSorter por bloques
+ *
+ * @param filename Archivo de entrada
+ * @param sorter Sorter que recibe los datos
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return true si el archivo se pudo abrir
+ */
+static bool feedSorter(const std::string& filename, StreamingSorter& sorter, IOStats& stats) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error al abrir archivo para join: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<int64_t> buffer;
+    while (readBlock(file, buffer, b, stats) > 0) {
+        sorter.add(buffer);
+    }
+    return true;
+}
+
+/**
+ * @brief Join por igualdad de dos archivos sin ordenar, hecho durante la mezcla final
+ *
+ * @param leftFilename Primer archivo de entrada
+ * @param rightFilename Segundo archivo de entrada
+ * @param outputFilename Archivo de salida
+ * @param arity Número de runs a mezclar simultáneamente
+ * @param memoryLimit Límite de memoria en bytes (se reparte entre ambas entradas)
+ * @param stats Objeto para registrar estadísticas de I/O
+ */
+void externalMergeJoin(const std::string& leftFilename,
+                       const std::string& rightFilename,
+                       const std::string& outputFilename,
+                       size_t arity,
+                       size_t memoryLimit,
+                       IOStats& stats) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    stats.reset();
+
+    // Cada lado usa la mitad de la memoria, menos un bloque de lectura y uno de salida
+    size_t sideMemory = memoryLimit / 2 > 2 * B ? memoryLimit / 2 - B : B;
+
+    StreamingSorter leftSorter(arity, sideMemory, stats);
+    StreamingSorter rightSorter(arity, sideMemory, stats);
+    if (!feedSorter(leftFilename, leftSorter, stats) || !feedSorter(rightFilename, rightSorter, stats)) {
+        return;
+    }
+
+    SortedStream left = leftSorter.finish();
+    SortedStream right = rightSorter.finish();
+
+    std::ofstream outputFile(outputFilename, std::ios::binary);
+    OperatorSink sink(outputFile, SortOperator::NONE, b, stats);
+
+    int64_t l, r;
+    bool hasLeft = left.next(l);
+    bool hasRight = right.next(r);
+
+    while (hasLeft && hasRight) {
+        if (l < r) {
+            hasLeft = left.next(l);
+        } else if (r < l) {
+            hasRight = right.next(r);
+        } else {
+            int64_t key = l;
+            size_t leftCount = 0;
+            size_t rightCount = 0;
+            while (hasLeft && l == key) {
+                leftCount++;
+                hasLeft = left.next(l);
+            }
+            while (hasRight && r == key) {
+                rightCount++;
+                hasRight = right.next(r);
+            }
+
+            for (size_t i = 0; i < leftCount * rightCount; ++i) {
+                sink.push(key);
+            }
+        }
+    }
+
+    sink.finish();
+    outputFile.close();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = endTime - startTime;
+
+    std::cout << "Merge-join completado en " << duration.count() << " segundos" << std::endl;
+    std::cout << "Pares escritos: " << sink.written() << std::endl;
+    std::cout << "Total operaciones I/O: " << stats.total() << std::endl;
+}
@@ -0,0 +1,112 @@
+#ifndef OPERATORS_H
+#define OPERATORS_H
+
+#include "iostats.h"
+#include "sortoptions.h"
+#include "checkpoint.h"
+#include <string>
+#include <vector>
+#include <fstream>
+
+/**
+ * @brief Destino de escritura que aplica un SortOperator sobre un flujo ordenado
+ *
+ * Recibe los elementos en orden ascendente y escribe al archivo, por bloques,
+ * el resultado del operador:
+ *   - NONE: cada elemento
+ *   - DISTINCT: cada clave una sola vez
+ *   - GROUP_COUNT: un par (clave, cantidad) de int64_t por clave distinta
+ *
+ * @warning Los elementos deben llegar ordenados; finish() debe llamarse al terminar
+ */
+class OperatorSink {
+public:
+    /**
+     * @brief Crea el destino sobre un archivo ya abierto
+     *
+     * @param output Archivo de salida en modo binario
+     * @param op Operador a aplicar
+     * @param bufferSize Cantidad de elementos del buffer de escritura
+     * @param stats Objeto para registrar estadísticas de I/O
+     * @param device Dispositivo de stats al que se atribuyen las escrituras (-1: ninguno)
+     * @param checksumSeed Valor inicial de checksum(), para continuar el de lo ya escrito antes
+     */
+    OperatorSink(std::ofstream& output, SortOperator op, size_t bufferSize, IOStats& stats, int device = -1,
+                 uint64_t checksumSeed = CHECKSUM_SEED);
+
+    /**
+     * @brief Agrega el siguiente elemento del flujo ordenado
+     * @param value Elemento (mayor o igual que el anterior)
+     */
+    void push(int64_t value);
+
+    /**
+     * @brief Agrega un tramo ordenado completo
+     * @param values Elementos en orden ascendente
+     */
+    void push(const std::vector<int64_t>& values);
+
+    /**
+     * @brief Emite el grupo pendiente sin vaciar el buffer
+     *
+     * Permite cortar el flujo en tramos cuyas claves no se repiten entre sí (por
+     * ejemplo, particiones de Quicksort): tras llamarlo, written() y checksum()
+     * corresponden exactamente al final del tramo.
+     */
+    void endGroup();
+
+    /**
+     * @brief Emite el último grupo pendiente y vacía el buffer
+     */
+    void finish();
+
+    /**
+     * @brief Cantidad de int64_t escritos al archivo hasta ahora
+     */
+    size_t written() const { return recordsWritten; }
+
+    /**
+     * @brief Checksum (ver checkpoint.h) de todo lo escrito hasta ahora
+     */
+    uint64_t checksum() const { return outputChecksum; }
+
+private:
+    void emit(int64_t value);
+
+    std::ofstream& output;
+    SortOperator op;
+    size_t bufferSize;
+    IOStats& stats;
+    int device;
+    std::vector<int64_t> buffer;
+    bool hasCurrent = false;
+    int64_t current = 0;
+    int64_t currentCount = 0;
+    size_t recordsWritten = 0;
+    uint64_t outputChecksum;
+};
+
+/**
+ * @brief Join por igualdad de dos archivos sin ordenar, hecho durante la mezcla final
+ *
+ * @param leftFilename Primer archivo de entrada
+ * @param rightFilename Segundo archivo de entrada
+ * @param outputFilename Archivo de salida
+ * @param arity Número de runs a mezclar simultáneamente
+ * @param memoryLimit Límite de memoria en bytes (se reparte entre ambas entradas)
+ * @param stats Objeto para registrar estadísticas de I/O
+ *
+ * @note Ambas entradas se ordenan con StreamingSorter hasta quedar en a lo más
+ *       `arity` runs; el join consume las dos mezclas finales en forma perezosa,
+ *       sin escribir las entradas ordenadas a disco
+ * @note La salida tiene una clave por cada par que coincide (si una clave aparece
+ *       l veces a la izquierda y r a la derecha, se escribe l * r veces)
+ */
+void externalMergeJoin(const std::string& leftFilename,
+                       const std::string& rightFilename,
+                       const std::string& outputFilename,
+                       size_t arity,
+                       size_t memoryLimit,
+                       IOStats& stats);
+
+#endif
@@ -0,0 +1,245 @@
+#include "perfcounters.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief Segundos del reloj monótono
+ */
+static double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Fallos de página menores y mayores del proceso según getrusage
+ */
+static uint64_t rusagePageFaults() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return static_cast<uint64_t>(usage.ru_minflt + usage.ru_majflt);
+}
+
+const char* perfEventName(PerfEvent event) {
+    switch (event) {
+        case PerfEvent::CYCLES: return "Cycles";
+        case PerfEvent::INSTRUCTIONS: return "Instructions";
+        case PerfEvent::LLC_MISSES: return "LLCMisses";
+        case PerfEvent::BRANCH_MISSES: return "BranchMisses";
+        case PerfEvent::PAGE_FAULTS: return "PageFaults";
+    }
+    return "?";
+}
+
+/**
+ * @brief Instrucciones por ciclo
+ */
+double PerfSample::ipc() const {
+    if (!has(PerfEvent::CYCLES) || !has(PerfEvent::INSTRUCTIONS) || value(PerfEvent::CYCLES) == 0) return 0;
+    return static_cast<double>(value(PerfEvent::INSTRUCTIONS)) / value(PerfEvent::CYCLES);
+}
+
+/**
+ * @brief Acumula otra muestra
+ *
+ * @param other Muestra a sumar
+ */
+void PerfSample::add(const PerfSample& other) {
+    bool first = seconds == 0;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        values[i] += other.values[i];
+        available[i] = (first || available[i]) && other.available[i];
+    }
+    seconds += other.seconds;
+}
+
+/**
+ * @brief Encabezado CSV de los contadores
+ *
+ * @param prefix Prefijo de cada columna
+ * @param separator Separador de columnas
+ */
+std::string PerfSample::csvHeader(const std::string& prefix, char separator) {
+    std::string header;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        if (i > 0) header += separator;
+        header += prefix + perfEventName(static_cast<PerfEvent>(i));
+    }
+    return header;
+}
+
+/**
+ * @brief Valores CSV de los contadores
+ *
+ * @param repetitions Divide cada valor
+ * @param separator Separador de columnas
+ */
+std::string PerfSample::csvRow(size_t repetitions, char separator) const {
+    std::ostringstream row;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        if (i > 0) row << separator;
+        if (available[i]) {
+            row << values[i] / std::max<size_t>(repetitions, 1);
+        } else {
+            row << "NA";
+        }
+    }
+    return row.str();
+}
+
+/**
+ * @brief Abre un contador del proceso actual, solo en espacio de usuario
+ *
+ * @return int Descriptor, o -1 si no está disponible
+ */
+static int openCounter(uint32_t type, uint64_t config) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.inherit = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+/**
+ * @brief Abre los contadores; los que fallan quedan como no disponibles
+ */
+PerfCounters::PerfCounters() {
+    const std::pair<uint32_t, uint64_t> events[PERF_EVENT_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    };
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        fds[i] = openCounter(events[i].first, events[i].second);
+    }
+    rusageFaults = fds[static_cast<size_t>(PerfEvent::PAGE_FAULTS)] < 0;
+    started = nowSeconds();
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+/**
+ * @brief true si el contador se pudo abrir
+ */
+bool PerfCounters::available(PerfEvent event) const {
+    return fds[static_cast<size_t>(event)] >= 0 || (event == PerfEvent::PAGE_FAULTS && rusageFaults);
+}
+
+/**
+ * @brief true si ciclos e instrucciones se pueden medir
+ */
+bool PerfCounters::hardwareAvailable() const {
+    return available(PerfEvent::CYCLES) && available(PerfEvent::INSTRUCTIONS);
+}
+
+/**
+ * @brief Valores acumulados desde la construcción, escalados si hubo multiplexación
+ */
+PerfSample PerfCounters::read() const {
+    PerfSample sample;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        if (fds[i] < 0) continue;
+
+        uint64_t data[3];  // valor, tiempo habilitado, tiempo corriendo
+        if (::read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        double scale = data[2] > 0 && data[2] < data[1] ? static_cast<double>(data[1]) / data[2] : 1.0;
+        sample.values[i] = static_cast<uint64_t>(data[0] * scale);
+        sample.available[i] = true;
+    }
+    if (rusageFaults) {
+        size_t faults = static_cast<size_t>(PerfEvent::PAGE_FAULTS);
+        sample.values[faults] = rusagePageFaults();
+        sample.available[faults] = true;
+    }
+    sample.seconds = nowSeconds() - started;
+    return sample;
+}
+
+/**
+ * @brief Cierra la región abierta (si hay) y abre una nueva
+ *
+ * @param phase Nombre de la región
+ */
+void PerfProfile::begin(const std::string& phase) {
+    end();
+    current = phase;
+    opened = perf.read();
+}
+
+/**
+ * @brief Cierra la región abierta y suma su diferencia a la región con su nombre
+ */
+void PerfProfile::end() {
+    if (current.empty()) return;
+
+    PerfSample now = perf.read();
+    PerfSample delta;
+    for (size_t i = 0; i < PERF_EVENT_COUNT; ++i) {
+        delta.values[i] = now.values[i] - opened.values[i];
+        delta.available[i] = now.available[i] && opened.available[i];
+    }
+    delta.seconds = now.seconds - opened.seconds;
+    samples[current].add(delta);
+    current.clear();
+}
+
+/**
+ * @brief Olvida las regiones medidas (y la abierta)
+ */
+void PerfProfile::clear() {
+    samples.clear();
+    current.clear();
+}
+
+/**
+ * @brief Muestra de una región
+ */
+PerfSample PerfProfile::phase(const std::string& name) const {
+    auto it = samples.find(name);
+    return it == samples.end() ? PerfSample() : it->second;
+}
+
+/**
+ * @brief Suma de las regiones cuyo nombre empieza con prefix
+ *
+ * @param prefix Prefijo (vacío: todas)
+ */
+PerfSample PerfProfile::total(const std::string& prefix) const {
+    PerfSample sum;
+    for (const auto& entry : samples) {
+        if (entry.first.compare(0, prefix.size(), prefix) == 0) {
+            sum.add(entry.second);
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Función para SortProgress::setPhaseListener
+ *
+ * @param prefix Prefijo del nombre de cada región
+ */
+std::function<void(SortPhase)> PerfProfile::phaseListener(const std::string& prefix) {
+    return [this, prefix](SortPhase phase) {
+        if (phase == SortPhase::FINISHED || phase == SortPhase::CANCELLED) {
+            end();
+        } else {
+            begin(prefix + sortPhaseName(phase));
+        }
+    };
+}
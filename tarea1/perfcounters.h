@@ -0,0 +1,170 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include "progress.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+/**
+ * @brief Contadores que se miden en cada región
+ */
+enum class PerfEvent {
+    CYCLES,         ///< Ciclos de CPU
+    INSTRUCTIONS,   ///< Instrucciones retiradas
+    LLC_MISSES,     ///< Fallos de la caché de último nivel
+    BRANCH_MISSES,  ///< Saltos mal predichos
+    PAGE_FAULTS     ///< Fallos de página (con getrusage si perf_event_open no está disponible)
+};
+
+/** @brief Cantidad de contadores */
+constexpr size_t PERF_EVENT_COUNT = static_cast<size_t>(PerfEvent::PAGE_FAULTS) + 1;
+
+/**
+ * @brief Nombre del contador para columnas CSV ("Cycles", "LLCMisses", ...)
+ */
+const char* perfEventName(PerfEvent event);
+
+/**
+ * @brief Valores de los contadores en una región (o acumulados en varias)
+ */
+struct PerfSample {
+    uint64_t values[PERF_EVENT_COUNT] = {};    ///< Valor de cada contador
+    bool available[PERF_EVENT_COUNT] = {};     ///< false si el contador no se pudo abrir
+    double seconds = 0;                        ///< Tiempo de pared de la región
+
+    /** @brief Valor de un contador */
+    uint64_t value(PerfEvent event) const { return values[static_cast<size_t>(event)]; }
+
+    /** @brief true si el contador se midió */
+    bool has(PerfEvent event) const { return available[static_cast<size_t>(event)]; }
+
+    /** @brief Instrucciones por ciclo (0 sin contadores de hardware) */
+    double ipc() const;
+
+    /** @brief Acumula otra muestra (un contador queda disponible solo si lo estaba en ambas) */
+    void add(const PerfSample& other);
+
+    /**
+     * @brief Encabezado CSV de los contadores
+     *
+     * @param prefix Prefijo de cada columna (p. ej. "MergeSort_")
+     * @param separator Separador de columnas
+     */
+    static std::string csvHeader(const std::string& prefix, char separator = ',');
+
+    /**
+     * @brief Valores CSV de los contadores; "NA" si no se midieron
+     *
+     * @param repetitions Divide cada valor (para promediar muestras acumuladas)
+     * @param separator Separador de columnas
+     */
+    std::string csvRow(size_t repetitions = 1, char separator = ',') const;
+};
+
+/**
+ * @brief Contadores de hardware del proceso leídos con perf_event_open
+ *
+ * Abre un descriptor por contador, solo en espacio de usuario (exclude_kernel, lo
+ * que permite perf_event_paranoid <= 2) y heredado por los hilos que se creen
+ * después (pool de la I/O asíncrona, reportero de progreso). Los contadores que no
+ * se pueden abrir (sin PMU en una VM, perf_event_paranoid = 3, seccomp) quedan
+ * como no disponibles; los fallos de página se toman entonces de getrusage.
+ *
+ * @note Si el kernel multiplexa los contadores, los valores se escalan por
+ *       tiempo habilitado / tiempo corriendo
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /** @brief true si el contador se pudo abrir (o, para PAGE_FAULTS, si hay getrusage) */
+    bool available(PerfEvent event) const;
+
+    /** @brief true si al menos ciclos e instrucciones se pueden medir */
+    bool hardwareAvailable() const;
+
+    /** @brief Valores acumulados desde la construcción */
+    PerfSample read() const;
+
+private:
+    int fds[PERF_EVENT_COUNT];
+    bool rusageFaults = false;
+    double started = 0;
+};
+
+/**
+ * @brief Contadores separados por fase (región con nombre)
+ *
+ * begin(fase) cierra la región abierta y abre una nueva; las regiones con el mismo
+ * nombre se acumulan. Se puede conectar a un SortProgress para que cada cambio de
+ * fase de un ordenamiento abra una región (phaseListener).
+ */
+class PerfProfile {
+public:
+    /**
+     * @brief Cierra la región abierta (si hay) y abre una nueva
+     *
+     * @param phase Nombre de la región
+     */
+    void begin(const std::string& phase);
+
+    /** @brief Cierra la región abierta */
+    void end();
+
+    /** @brief Olvida las regiones medidas */
+    void clear();
+
+    /** @brief Muestra de una región (vacía si no se midió) */
+    PerfSample phase(const std::string& name) const;
+
+    /** @brief Regiones medidas, por nombre */
+    const std::map<std::string, PerfSample>& phases() const { return samples; }
+
+    /** @brief Suma de las regiones cuyo nombre empieza con prefix (vacío: todas) */
+    PerfSample total(const std::string& prefix = "") const;
+
+    /** @brief Contadores usados (para consultar disponibilidad) */
+    const PerfCounters& counters() const { return perf; }
+
+    /**
+     * @brief Función para SortProgress::setPhaseListener
+     *
+     * @param prefix Prefijo del nombre de cada región (p. ej. "MergeSort/")
+     * @return Abre la región prefix + sortPhaseName(fase), y cierra la abierta al terminar o cancelar
+     */
+    std::function<void(SortPhase)> phaseListener(const std::string& prefix);
+
+private:
+    PerfCounters perf;
+    std::map<std::string, PerfSample> samples;
+    std::string current;
+    PerfSample opened;
+};
+
+/**
+ * @brief Región medida mientras el objeto existe
+ */
+class PerfScope {
+public:
+    /**
+     * @param profile Perfil donde se acumula
+     * @param phase Nombre de la región
+     */
+    PerfScope(PerfProfile& profile, const std::string& phase) : profile(profile) { profile.begin(phase); }
+    ~PerfScope() { profile.end(); }
+
+    PerfScope(const PerfScope&) = delete;
+    PerfScope& operator=(const PerfScope&) = delete;
+
+private:
+    PerfProfile& profile;
+};
+
+#endif
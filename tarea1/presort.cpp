@@ -0,0 +1,127 @@
+#include "presort.h"
+#include <algorithm>
+#include <sstream>
+
+/**
+ * @brief Obtiene el nombre legible de una estrategia
+ *
+ * @param strategy Estrategia a nombrar
+ * @return const char* Nombre de la estrategia
+ */
+const char* presortStrategyName(PresortStrategy strategy) {
+    switch (strategy) {
+        case PresortStrategy::ALREADY_SORTED: return "ya ordenado";
+        case PresortStrategy::REVERSE:        return "inversión";
+        case PresortStrategy::NATURAL_RUNS:   return "runs naturales";
+        case PresortStrategy::STANDARD:       return "estándar";
+    }
+    return "desconocida";
+}
+
+/**
+ * @brief Analiza el siguiente bloque del flujo
+ *
+ * @param block Elementos en el orden en que aparecen en la entrada
+ * @return PresortInfo Medidas del bloque por sí solo
+ *
+ * @note Un descenso (a[i] < a[i-1]) cierra un run ascendente y un ascenso
+ *       (a[i] > a[i-1]) cierra uno descendente; los elementos iguales extienden ambos
+ */
+PresortInfo PresortScanner::scan(const std::vector<int64_t>& block) {
+    PresortInfo local;
+    if (block.empty()) return local;
+
+    local.elements = block.size();
+    local.ascendingRuns = 1;
+    local.descendingRuns = 1;
+
+    // Continuar los runs abiertos del bloque anterior
+    if (total.elements == 0) {
+        total.ascendingRuns = 1;
+        total.descendingRuns = 1;
+        currentAscending = 1;
+        currentDescending = 1;
+    } else {
+        if (block[0] < last) {
+            total.ascendingRuns++;
+            currentAscending = 1;
+        } else {
+            currentAscending++;
+        }
+        if (block[0] > last) {
+            total.descendingRuns++;
+            currentDescending = 1;
+        } else {
+            currentDescending++;
+        }
+    }
+    total.longestAscendingRun = std::max(total.longestAscendingRun, currentAscending);
+    total.longestDescendingRun = std::max(total.longestDescendingRun, currentDescending);
+
+    size_t localAscending = 1;
+    size_t localDescending = 1;
+    local.longestAscendingRun = 1;
+    local.longestDescendingRun = 1;
+
+    for (size_t i = 1; i < block.size(); ++i) {
+        if (block[i] < block[i - 1]) {
+            local.ascendingRuns++;
+            total.ascendingRuns++;
+            localAscending = 1;
+            currentAscending = 1;
+        } else {
+            localAscending++;
+            currentAscending++;
+        }
+
+        if (block[i] > block[i - 1]) {
+            local.descendingRuns++;
+            total.descendingRuns++;
+            localDescending = 1;
+            currentDescending = 1;
+        } else {
+            localDescending++;
+            currentDescending++;
+        }
+
+        local.longestAscendingRun = std::max(local.longestAscendingRun, localAscending);
+        local.longestDescendingRun = std::max(local.longestDescendingRun, localDescending);
+        total.longestAscendingRun = std::max(total.longestAscendingRun, currentAscending);
+        total.longestDescendingRun = std::max(total.longestDescendingRun, currentDescending);
+    }
+
+    total.elements += block.size();
+    last = block.back();
+    return local;
+}
+
+/**
+ * @brief Serializa el estado del análisis (para reanudar un ordenamiento)
+ *
+ * @return std::string Contadores acumulados y el final del último bloque
+ */
+std::string PresortScanner::state() const {
+    std::ostringstream out;
+    out << total.elements << " " << total.ascendingRuns << " " << total.descendingRuns << " "
+        << total.longestAscendingRun << " " << total.longestDescendingRun << " "
+        << last << " " << currentAscending << " " << currentDescending;
+    return out.str();
+}
+
+/**
+ * @brief Restaura un estado producido por state()
+ *
+ * @param text Estado serializado
+ * @return true si el texto era válido
+ */
+bool PresortScanner::restore(const std::string& text) {
+    std::istringstream in(text);
+    PresortScanner restored;
+    in >> restored.total.elements >> restored.total.ascendingRuns >> restored.total.descendingRuns
+       >> restored.total.longestAscendingRun >> restored.total.longestDescendingRun
+       >> restored.last >> restored.currentAscending >> restored.currentDescending;
+    if (!in) return false;
+
+    *this = restored;
+    return true;
+}
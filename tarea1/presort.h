@@ -0,0 +1,87 @@
+#ifndef PRESORT_H
+#define PRESORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Estrategia elegida según el grado de orden previo de la entrada
+ */
+enum class PresortStrategy {
+    STANDARD,        ///< Formación de runs normal (la entrada no tiene orden aprovechable)
+    NATURAL_RUNS,    ///< Chunks consecutivos que continúan un run se agregan al mismo archivo
+    REVERSE,         ///< La entrada es descendente: basta invertirla
+    ALREADY_SORTED   ///< La entrada ya está ordenada: no se ordena ni se mezcla
+};
+
+/**
+ * @brief Obtiene el nombre legible de una estrategia
+ * @param strategy Estrategia a nombrar
+ * @return const char* Nombre de la estrategia
+ */
+const char* presortStrategyName(PresortStrategy strategy);
+
+/**
+ * @brief Medidas de orden previo (presortedness) de una secuencia
+ *
+ * Un run ascendente es una secuencia maximal no decreciente; uno descendente,
+ * una secuencia maximal no creciente. Una entrada ordenada tiene un único run ascendente.
+ */
+struct PresortInfo {
+    size_t elements = 0;              ///< Elementos analizados
+    size_t ascendingRuns = 0;         ///< Cantidad de runs ascendentes naturales
+    size_t descendingRuns = 0;        ///< Cantidad de runs descendentes naturales
+    size_t longestAscendingRun = 0;   ///< Largo del run ascendente más largo
+    size_t longestDescendingRun = 0;  ///< Largo del run descendente más largo
+    size_t mergeInputs = 0;           ///< Runs entregados a la fase de mezcla
+    PresortStrategy strategy = PresortStrategy::STANDARD;  ///< Estrategia aplicada
+
+    /** @brief true si toda la secuencia es no decreciente */
+    bool ascending() const { return ascendingRuns <= 1; }
+    /** @brief true si toda la secuencia es no creciente */
+    bool descending() const { return descendingRuns <= 1; }
+};
+
+/**
+ * @brief Cuenta runs naturales de un flujo que se recorre por bloques
+ *
+ * Se alimenta con los mismos bloques que ya se leen para ordenar, por lo que
+ * no agrega operaciones de I/O. Los runs que cruzan bloques se cuentan una sola vez.
+ */
+class PresortScanner {
+public:
+    /**
+     * @brief Analiza el siguiente bloque del flujo
+     *
+     * @param block Elementos en el orden en que aparecen en la entrada
+     * @return PresortInfo Medidas del bloque por sí solo (ascending()/descending()
+     *         indican si el bloque completo es monótono)
+     */
+    PresortInfo scan(const std::vector<int64_t>& block);
+
+    /**
+     * @brief Medidas acumuladas de todo lo analizado hasta ahora
+     */
+    const PresortInfo& info() const { return total; }
+
+    /**
+     * @brief Serializa el estado del análisis (para reanudar un ordenamiento)
+     */
+    std::string state() const;
+
+    /**
+     * @brief Restaura un estado producido por state()
+     * @return true si el texto era válido
+     */
+    bool restore(const std::string& text);
+
+private:
+    PresortInfo total;
+    int64_t last = 0;
+    size_t currentAscending = 0;
+    size_t currentDescending = 0;
+};
+
+#endif
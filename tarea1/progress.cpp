@@ -0,0 +1,210 @@
+#include "progress.h"
+#include "iostats.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Nanosegundos del reloj monótono
+ */
+static int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* sortPhaseName(SortPhase phase) {
+    switch (phase) {
+        case SortPhase::STARTING: return "inicio";
+        case SortPhase::RUN_FORMATION: return "división";
+        case SortPhase::MERGE: return "mezcla";
+        case SortPhase::PARTITION: return "partición";
+        case SortPhase::LEAF: return "hojas";
+        case SortPhase::FINISHED: return "terminado";
+        case SortPhase::CANCELLED: return "cancelado";
+    }
+    return "?";
+}
+
+/**
+ * @brief MB/s (lectura más escritura) desde el comienzo
+ */
+double ProgressSnapshot::megabytesPerSecond() const {
+    return seconds > 0 ? bytes() / (1024.0 * 1024.0) / seconds : 0;
+}
+
+/**
+ * @brief Fracción estimada del trabajo hecho
+ *
+ * @return double 1 al terminar; antes, a lo más 0.99 aunque la estimación se haya quedado corta
+ */
+double ProgressSnapshot::fraction() const {
+    if (phase == SortPhase::FINISHED) return 1;
+    if (expectedBytes == 0) return 0;
+    return std::min(0.99, static_cast<double>(bytes()) / expectedBytes);
+}
+
+/**
+ * @brief Segundos que faltan al ritmo promedio observado
+ *
+ * @return double 0 al terminar, -1 si todavía no se transfirió nada o no hay estimación
+ */
+double ProgressSnapshot::etaSeconds() const {
+    if (phase == SortPhase::FINISHED) return 0;
+    if (bytes() == 0 || seconds <= 0 || expectedBytes == 0) return -1;
+    double rate = bytes() / seconds;
+    return expectedBytes > bytes() ? (expectedBytes - bytes()) / rate : 0;
+}
+
+/**
+ * @brief Crea los contadores
+ *
+ * @param callback Función llamada con cada instantánea (vacía: sin reportero)
+ * @param interval Segundos entre llamadas
+ */
+SortProgress::SortProgress(Callback callback, double interval)
+    : callback(std::move(callback)), interval(interval) {
+    for (auto& counter : perPhase) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+SortProgress::~SortProgress() {
+    stopReporter();
+}
+
+/**
+ * @brief Reinicia los contadores y arranca el reportero (si hay callback)
+ */
+void SortProgress::begin() {
+    stopReporter();
+    read.store(0, std::memory_order_relaxed);
+    written.store(0, std::memory_order_relaxed);
+    for (auto& counter : perPhase) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    expected.store(0, std::memory_order_relaxed);
+    step.store(0, std::memory_order_relaxed);
+    phase.store(static_cast<size_t>(SortPhase::STARTING), std::memory_order_relaxed);
+    if (phaseListener) phaseListener(SortPhase::STARTING);
+    startNanos.store(nowNanos(), std::memory_order_relaxed);
+
+    if (callback && interval > 0) {
+        stopping = false;
+        reporter = std::thread(&SortProgress::report, this);
+    }
+}
+
+/**
+ * @brief Detiene el reportero y entrega la última instantánea
+ *
+ * @param cancelled true si el ordenamiento se canceló
+ */
+void SortProgress::finish(bool cancelled) {
+    bool reporting = stopReporter();
+    setPhase(cancelled ? SortPhase::CANCELLED : SortPhase::FINISHED, step.load(std::memory_order_relaxed));
+    if (reporting) callback(snapshot());
+}
+
+/**
+ * @brief Cambia de fase
+ *
+ * @param newPhase Nueva fase
+ * @param newStep Pasada dentro de la fase
+ */
+void SortProgress::setPhase(SortPhase newPhase, size_t newStep) {
+    step.store(newStep, std::memory_order_relaxed);
+    size_t previous = phase.exchange(static_cast<size_t>(newPhase), std::memory_order_relaxed);
+    if (phaseListener && previous != static_cast<size_t>(newPhase)) {
+        phaseListener(newPhase);
+    }
+}
+
+/**
+ * @brief Instantánea de los contadores
+ */
+ProgressSnapshot SortProgress::snapshot() const {
+    ProgressSnapshot snapshot;
+    snapshot.phase = static_cast<SortPhase>(phase.load(std::memory_order_relaxed));
+    snapshot.step = step.load(std::memory_order_relaxed);
+    snapshot.bytesRead = read.load(std::memory_order_relaxed);
+    snapshot.bytesWritten = written.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < SORT_PHASE_COUNT; ++i) {
+        snapshot.phaseBytes[i] = perPhase[i].load(std::memory_order_relaxed);
+    }
+    snapshot.expectedBytes = expected.load(std::memory_order_relaxed);
+    snapshot.seconds = (nowNanos() - startNanos.load(std::memory_order_relaxed)) / 1e9;
+    return snapshot;
+}
+
+/**
+ * @brief Detiene el hilo reportero
+ *
+ * @return true si estaba corriendo
+ */
+bool SortProgress::stopReporter() {
+    if (!reporter.joinable()) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    reporter.join();
+    return true;
+}
+
+/**
+ * @brief Ciclo del hilo reportero: una instantánea cada `interval` segundos
+ */
+void SortProgress::report() {
+    auto period = std::chrono::duration<double>(interval);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!wake.wait_for(lock, period, [this] { return stopping; })) {
+        lock.unlock();
+        callback(snapshot());
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Imprime una instantánea en una línea
+ */
+void printProgress(const ProgressSnapshot& snapshot) {
+    std::ostringstream line;
+    line << "[" << sortPhaseName(snapshot.phase);
+    if (snapshot.phase == SortPhase::MERGE || snapshot.phase == SortPhase::PARTITION) {
+        line << " " << snapshot.step;
+    }
+    line << "] " << std::fixed << std::setprecision(1) << snapshot.fraction() * 100 << "% "
+         << snapshot.megabytesPerSecond() << " MB/s";
+    double eta = snapshot.etaSeconds();
+    if (eta >= 0) {
+        line << ", faltan " << std::setprecision(0) << eta << " s";
+    }
+    std::cout << line.str() << std::endl;
+}
+
+/**
+ * @brief Conecta los contadores y el token a stats
+ *
+ * @param stats Estadísticas del ordenamiento
+ * @param progress Contadores (puede ser nulo)
+ * @param cancel Token de cancelación (puede ser nulo)
+ */
+ProgressScope::ProgressScope(IOStats& stats, SortProgress* progress, const CancellationToken* cancel)
+    : stats(stats), progress(progress) {
+    stats.progress = progress;
+    stats.cancel = cancel;
+    if (progress) progress->begin();
+}
+
+/**
+ * @brief Desconecta los contadores y el token, y cierra el reporte
+ */
+ProgressScope::~ProgressScope() {
+    stats.progress = nullptr;
+    stats.cancel = nullptr;
+    if (progress) progress->finish(wasCancelled);
+}
@@ -0,0 +1,221 @@
+#ifndef PROGRESS_H
+#define PROGRESS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+struct IOStats;
+
+/**
+ * @brief Fase de un ordenamiento externo
+ */
+enum class SortPhase {
+    STARTING,        ///< Antes de la primera lectura
+    RUN_FORMATION,   ///< MergeSort: división en runs ordenados
+    MERGE,           ///< MergeSort: pasadas de mezcla (incluida la final)
+    PARTITION,       ///< QuickSort: selección de pivotes y partición
+    LEAF,            ///< QuickSort: ordenamiento en memoria de las hojas
+    FINISHED,        ///< Terminado
+    CANCELLED        ///< Cancelado con un CancellationToken
+};
+
+/** @brief Cantidad de fases (tamaño de los contadores por fase) */
+constexpr size_t SORT_PHASE_COUNT = static_cast<size_t>(SortPhase::CANCELLED) + 1;
+
+/**
+ * @brief Nombre legible de una fase
+ */
+const char* sortPhaseName(SortPhase phase);
+
+/**
+ * @brief Excepción lanzada cuando se cancela un ordenamiento
+ *
+ * externalMergeSort y externalQuickSort la atrapan para limpiar su estado temporal
+ * y luego la relanzan.
+ */
+class SortCancelled : public std::runtime_error {
+public:
+    SortCancelled() : std::runtime_error("ordenamiento cancelado") {}
+};
+
+/**
+ * @brief Pedido de cancelación, que se puede marcar desde cualquier hilo
+ *
+ * Los algoritmos lo consultan en cada lectura o escritura de bloques (ver
+ * IOStats::observe), así que la cancelación toma efecto en el siguiente bloque.
+ */
+class CancellationToken {
+public:
+    /** @brief Pide cancelar */
+    void cancel() { flag.store(true, std::memory_order_relaxed); }
+
+    /** @brief true si se pidió cancelar */
+    bool cancelled() const { return flag.load(std::memory_order_relaxed); }
+
+    /** @brief Olvida un pedido anterior, para reutilizar el token */
+    void reset() { flag.store(false, std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> flag{false};
+};
+
+/**
+ * @brief Estado de un ordenamiento en un instante
+ */
+struct ProgressSnapshot {
+    SortPhase phase = SortPhase::STARTING;  ///< Fase actual
+    size_t step = 0;                        ///< Pasada de mezcla o de partición dentro de la fase
+    uint64_t bytesRead = 0;                 ///< Bytes leídos desde el comienzo
+    uint64_t bytesWritten = 0;              ///< Bytes escritos desde el comienzo
+    uint64_t phaseBytes[SORT_PHASE_COUNT] = {};  ///< Bytes leídos y escritos en cada fase
+    uint64_t expectedBytes = 0;             ///< Estimación de los bytes que leerá y escribirá el ordenamiento completo
+    double seconds = 0;                     ///< Tiempo desde el comienzo
+
+    /** @brief Bytes leídos y escritos */
+    uint64_t bytes() const { return bytesRead + bytesWritten; }
+
+    /** @brief MB/s (lectura más escritura) desde el comienzo */
+    double megabytesPerSecond() const;
+
+    /** @brief Fracción estimada del trabajo hecho, en [0, 1] */
+    double fraction() const;
+
+    /** @brief Segundos que faltan al ritmo actual (negativo si aún no se puede estimar) */
+    double etaSeconds() const;
+};
+
+/**
+ * @brief Contadores de avance de un ordenamiento y, opcionalmente, un reportero periódico
+ *
+ * Los algoritmos informan cada bloque transferido (IOStats::observe) con sumas
+ * atómicas relajadas, sin tomar locks ni llamar al callback desde los ciclos de
+ * lectura y escritura. Si hay callback, un hilo aparte lo llama cada `interval`
+ * segundos con una instantánea, y una vez más al terminar o cancelar.
+ *
+ * @note La estimación total la fija el algoritmo al comenzar (expect) y la corrige
+ *       cuando sabe más (MergeSort, al terminar la división)
+ */
+class SortProgress {
+public:
+    using Callback = std::function<void(const ProgressSnapshot&)>;
+
+    /**
+     * @brief Crea los contadores
+     *
+     * @param callback Función llamada con cada instantánea (vacía: sin reportero)
+     * @param interval Segundos entre llamadas
+     */
+    explicit SortProgress(Callback callback = Callback(), double interval = 1.0);
+
+    /** @brief Detiene el reportero si sigue corriendo */
+    ~SortProgress();
+
+    SortProgress(const SortProgress&) = delete;
+    SortProgress& operator=(const SortProgress&) = delete;
+
+    /** @brief Reinicia los contadores y arranca el reportero */
+    void begin();
+
+    /**
+     * @brief Detiene el reportero y entrega la última instantánea
+     *
+     * @param cancelled true si el ordenamiento se canceló
+     */
+    void finish(bool cancelled = false);
+
+    /**
+     * @brief Cambia de fase
+     *
+     * @param phase Nueva fase
+     * @param step Pasada dentro de la fase
+     */
+    void setPhase(SortPhase phase, size_t step = 0);
+
+    /**
+     * @brief Función llamada (desde el hilo del ordenamiento) cada vez que cambia la fase
+     *
+     * Sirve para medir por fase, p. ej. con PerfProfile::phaseListener. Debe
+     * configurarse antes de comenzar el ordenamiento.
+     */
+    void setPhaseListener(std::function<void(SortPhase)> listener) { phaseListener = std::move(listener); }
+
+    /** @brief Fija la estimación de bytes totales a leer y escribir */
+    void expect(uint64_t bytes) { expected.store(bytes, std::memory_order_relaxed); }
+
+    /**
+     * @brief Suma bytes transferidos a los contadores
+     *
+     * @param bytes Bytes leídos o escritos
+     * @param write true para una escritura
+     */
+    void add(uint64_t bytes, bool write) {
+        (write ? written : read).fetch_add(bytes, std::memory_order_relaxed);
+        perPhase[phase.load(std::memory_order_relaxed)].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /** @brief Instantánea de los contadores (se puede llamar desde cualquier hilo) */
+    ProgressSnapshot snapshot() const;
+
+private:
+    void report();
+    bool stopReporter();
+
+    Callback callback;
+    std::function<void(SortPhase)> phaseListener;
+    double interval;
+    std::atomic<uint64_t> read{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> perPhase[SORT_PHASE_COUNT];
+    std::atomic<uint64_t> expected{0};
+    std::atomic<size_t> phase{0};
+    std::atomic<size_t> step{0};
+    std::atomic<int64_t> startNanos{0};
+
+    std::thread reporter;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
+
+/**
+ * @brief Imprime una instantánea en una línea (callback listo para usar)
+ *
+ * Ejemplo: "[mezcla 2] 45.3% 120.5 MB/s, faltan 12 s"
+ */
+void printProgress(const ProgressSnapshot& snapshot);
+
+/**
+ * @brief Conecta los contadores y el token de SortOptions a un IOStats mientras dura un ordenamiento
+ *
+ * Al construirse llama a progress->begin(); al destruirse desconecta ambos del
+ * IOStats y llama a progress->finish(), también si el ordenamiento lanzó una excepción.
+ */
+class ProgressScope {
+public:
+    /**
+     * @param stats Estadísticas del ordenamiento
+     * @param progress Contadores (puede ser nulo)
+     * @param cancel Token de cancelación (puede ser nulo)
+     */
+    ProgressScope(IOStats& stats, SortProgress* progress, const CancellationToken* cancel);
+    ~ProgressScope();
+
+    ProgressScope(const ProgressScope&) = delete;
+    ProgressScope& operator=(const ProgressScope&) = delete;
+
+    /** @brief Marca que el ordenamiento terminó por cancelación */
+    void cancelled() { wasCancelled = true; }
+
+private:
+    IOStats& stats;
+    SortProgress* progress;
+    bool wasCancelled = false;
+};
+
+#endif
@@ -1,6 +1,10 @@
 #include "mergesort.h"
+#include "quicksort.h"
+#include "operators.h"
+#include "checkpoint.h"
 #include "iostats.h"
 #include "constants.h"
+#include "simdmerge.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -11,6 +15,7 @@
 #include <filesystem>
 #include <cmath>
 #include <limits>
+#include <sstream>
 
 namespace fs = std::filesystem;
 
@@ -22,44 +27,41 @@ namespace fs = std::filesystem;
  * @param pivotes Vector con los valores pivote para la partición
  * @param memoryLimit Límite de memoria en bytes para procesamiento
  * @param stats Objeto para registrar estadísticas de I/O
+ * @param info Si no es nulo, recibe el orden previo de la entrada y el tamaño,
+ *             checksum, muestra y rango de claves de cada partición, medidos en
+ *             esta misma pasada
+ * @param async Si no es nulo y está habilitado, la I/O se hace con asyncDistribute
+ * @param asyncReport Si no es nulo, acumula el reporte de la I/O asíncrona
  * 
  * @note Crea múltiples archivos de salida, uno por cada partición
  * @note Los elementos menores al primer pivote van a la primera partición, etc.
+ * @note La muestra de cada partición es un reservoir de B/sizeof(int64_t)
+ *       elementos: uniforme sobre toda la partición y sin I/O adicional
  */
 void partition(const std::string& inputFilename, 
                const std::vector<std::string>& outputFilenames,
                const std::vector<int64_t>& pivots, 
                size_t memoryLimit,
-               IOStats& stats) {
-    
-    // Abrir archivo de entrada
-    std::ifstream inputFile(inputFilename, std::ios::binary);
-    if (!inputFile) {
-        std::cerr << "Error al abrir archivo para partición: " << inputFilename << std::endl;
-        return;
-    }
-    
-    // Crear archivos de salida para cada partición
-    size_t numPartitions = pivots.size() + 1;
-    std::vector<std::ofstream> outputFiles(numPartitions);
-    for (size_t i = 0; i < numPartitions; ++i) {
-        outputFiles[i].open(outputFilenames[i], std::ios::binary);
-        if (!outputFiles[i]) {
-            std::cerr << "Error al crear archivo de partición: " << outputFilenames[i] << std::endl;
-            return;
-        }
-    }
+               IOStats& stats,
+               PartitionInfo* info,
+               const AsyncIOOptions* async,
+               AsyncIOReport* asyncReport) {
     
     // Tamaño del buffer para procesar en memoria
+    size_t numPartitions = pivots.size() + 1;
     size_t bufferSize = memoryLimit / sizeof(int64_t);
-    std::vector<int64_t> buffer;
-    std::vector<std::vector<int64_t>> partitionBuffers(numPartitions);
-    
-    // Procesar el archivo por bloques
-    while (true) {
-        // Leer un bloque de datos
-        size_t itemsRead = readBlock(inputFile, buffer, bufferSize, stats);
-        if (itemsRead == 0) break;
+    PresortScanner scanner;
+    std::vector<size_t> counts(numPartitions, 0);
+    std::vector<uint64_t> checksums(numPartitions, CHECKSUM_SEED);
+    std::vector<PartitionSample> samples(numPartitions);
+    const size_t SAMPLE_SIZE = B / sizeof(int64_t);
+    std::mt19937_64 gen(std::random_device{}());
+    
+    // Clasifica un bloque de la entrada en los buffers de cada partición
+    auto classify = [&](const std::vector<int64_t>& buffer, std::vector<std::vector<int64_t>>& partitionBuffers) {
+        if (info) {
+            scanner.scan(buffer);
+        }
         
         // Clasificar cada elemento en la partición correspondiente
         for (int64_t value : buffer) {
@@ -69,28 +71,85 @@ void partition(const std::string& inputFilename,
                 partitionIndex++;
             }
             partitionBuffers[partitionIndex].push_back(value);
+            
+            // Reservoir: el k-ésimo elemento de la partición reemplaza a uno de la
+            // muestra con probabilidad SAMPLE_SIZE / k
+            if (info) {
+                PartitionSample& sample = samples[partitionIndex];
+                size_t seen = ++counts[partitionIndex];
+                if (seen == 1) {
+                    sample.minimum = sample.maximum = value;
+                } else {
+                    sample.minimum = std::min(sample.minimum, value);
+                    sample.maximum = std::max(sample.maximum, value);
+                }
+                if (sample.values.size() < SAMPLE_SIZE) {
+                    sample.values.push_back(value);
+                } else {
+                    size_t slot = gen() % seen;
+                    if (slot < SAMPLE_SIZE) sample.values[slot] = value;
+                }
+            }
         }
         
-        // Escribir los buffers de partición a sus respectivos archivos
-        for (size_t i = 0; i < numPartitions; ++i) {
-            if (!partitionBuffers[i].empty()) {
-                writeBlock(outputFiles[i], partitionBuffers[i], stats);
-                partitionBuffers[i].clear();
+        if (info) {
+            for (size_t i = 0; i < numPartitions; ++i) {
+                checksums[i] = checksumBlock(checksums[i], partitionBuffers[i]);
             }
         }
-    }
+    };
     
-    // Escribir cualquier dato restante en los buffers de partición
-    for (size_t i = 0; i < numPartitions; ++i) {
-        if (!partitionBuffers[i].empty()) {
-            writeBlock(outputFiles[i], partitionBuffers[i], stats);
+    if (async && async->enabled) {
+        asyncDistribute(inputFilename, outputFilenames, bufferSize, stats, *async, classify, asyncReport);
+    } else {
+        // Abrir archivo de entrada
+        std::ifstream inputFile(inputFilename, std::ios::binary);
+        if (!inputFile) {
+            std::cerr << "Error al abrir archivo para partición: " << inputFilename << std::endl;
+            return;
+        }
+        
+        // Crear archivos de salida para cada partición
+        std::vector<std::ofstream> outputFiles(numPartitions);
+        std::vector<int> outputDevices(numPartitions);
+        for (size_t i = 0; i < numPartitions; ++i) {
+            outputFiles[i].open(outputFilenames[i], std::ios::binary);
+            outputDevices[i] = stats.deviceOf(outputFilenames[i]);
+            if (!outputFiles[i]) {
+                std::cerr << "Error al crear archivo de partición: " << outputFilenames[i] << std::endl;
+                return;
+            }
+        }
+        
+        std::vector<int64_t> buffer;
+        std::vector<std::vector<int64_t>> partitionBuffers(numPartitions);
+        int inputDevice = stats.deviceOf(inputFilename);
+        
+        // Procesar el archivo por bloques
+        while (readBlock(inputFile, buffer, bufferSize, stats, inputDevice) > 0) {
+            classify(buffer, partitionBuffers);
+            
+            // Escribir los buffers de partición a sus respectivos archivos
+            for (size_t i = 0; i < numPartitions; ++i) {
+                if (!partitionBuffers[i].empty()) {
+                    writeBlock(outputFiles[i], partitionBuffers[i], stats, outputDevices[i]);
+                    partitionBuffers[i].clear();
+                }
+            }
+        }
+        
+        // Cerrar todos los archivos
+        inputFile.close();
+        for (auto& file : outputFiles) {
+            file.close();
         }
     }
     
-    // Cerrar todos los archivos
-    inputFile.close();
-    for (auto& file : outputFiles) {
-        file.close();
+    if (info) {
+        info->presort = scanner.info();
+        info->counts = counts;
+        info->checksums = checksums;
+        info->samples = std::move(samples);
     }
 }
 
@@ -149,20 +208,30 @@ std::vector<int64_t> selectPivots(const std::string& filename, size_t numPivots,
     readBlock(file, sampleBuffer, SAMPLE_SIZE, stats);
     file.close();
     
+    return pivotsFromSample(std::move(sampleBuffer), numPivots);
+}
+
+/**
+ * @brief Elige pivotes distribuidos uniformemente a partir de una muestra
+ *
+ * @param sample Muestra de la entrada (se ordena)
+ * @param numPivots Número de pivotes a seleccionar
+ * @return std::vector<int64_t> Pivotes en orden ascendente
+ */
+std::vector<int64_t> pivotsFromSample(std::vector<int64_t> sample, size_t numPivots) {
+    // Ordenar la muestra
+    std::sort(sample.begin(), sample.end());
+    
     // Si no tenemos suficientes números, usar lo que tengamos
-    if (sampleBuffer.size() <= numPivots) {
-        std::sort(sampleBuffer.begin(), sampleBuffer.end());
-        return sampleBuffer;
+    if (sample.size() <= numPivots) {
+        return sample;
     }
     
-    // Ordenar el bloque muestreado
-    std::sort(sampleBuffer.begin(), sampleBuffer.end());
-    
     // Seleccionar pivotes distribuidos uniformemente
-    pivots.resize(numPivots);
+    std::vector<int64_t> pivots(numPivots);
     for (size_t i = 0; i < numPivots; ++i) {
-        size_t index = (i + 1) * sampleBuffer.size() / (numPivots + 1);
-        pivots[i] = sampleBuffer[index];
+        size_t index = (i + 1) * sample.size() / (numPivots + 1);
+        pivots[i] = sample[index];
     }
     
     return pivots;
@@ -249,103 +318,543 @@ bool verifySort(const std::string& filename, IOStats& stats) {
 }
 
 
+/**
+ * @brief Abre un archivo existente para escribir desde una posición, sin truncarlo
+ *
+ * @param filename Archivo a abrir
+ * @param offset Posición, en elementos, donde comienza la escritura
+ * @return std::ofstream Archivo posicionado en offset
+ */
+static std::ofstream openAt(const std::string& filename, size_t offset) {
+    std::ofstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(offset * sizeof(int64_t));
+    return file;
+}
+
+/**
+ * @brief Comprueba el checksum de un tramo de la salida
+ *
+ * @param filename Archivo de salida
+ * @param offset Primer elemento del tramo
+ * @param count Elementos del tramo
+ * @param seed Checksum de la salida antes del tramo
+ * @param checksum Checksum esperado al final del tramo
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return true si el tramo está completo y coincide
+ */
+static bool verifyRange(const std::string& filename, size_t offset, size_t count,
+                        uint64_t seed, uint64_t checksum, IOStats& stats) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) return false;
+    file.seekg(offset * sizeof(int64_t));
+    
+    std::vector<int64_t> buffer;
+    size_t blockSize = B / sizeof(int64_t);
+    while (count > 0 && readBlock(file, buffer, std::min(count, blockSize), stats) > 0) {
+        seed = checksumBlock(seed, buffer);
+        count -= buffer.size();
+    }
+    return count == 0 && seed == checksum;
+}
+
+/**
+ * @brief Busca en el manifiesto el tramo de salida ya escrito por un nodo
+ *
+ * La clave "node:[entrada]" guarda el checksum de la entrada del nodo, la posición
+ * y el largo de su tramo y el checksum de la salida antes y después de él. El
+ * tramo sirve si fue escrito para la misma entrada en la posición del cursor.
+ *
+ * @param manifest Manifiesto del ordenamiento
+ * @param node Nombre del archivo de entrada del nodo
+ * @param source Checksum de esa entrada
+ * @param outputFilename Archivo de salida
+ * @param cursor Posición actual; si el tramo sirve, se avanza hasta su final
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return true si el nodo ya estaba terminado
+ */
+static bool finishedNode(const SortManifest& manifest, const std::string& node, uint64_t source,
+                         const std::string& outputFilename, OutputCursor& cursor, IOStats& stats) {
+    std::istringstream value(manifest.get("node:" + node));
+    uint64_t nodeSource, seed, checksum;
+    size_t offset, count;
+    value >> nodeSource >> offset >> count >> seed >> checksum;
+    if (!value || nodeSource != source || offset != cursor.offset || seed != cursor.checksum ||
+        !verifyRange(outputFilename, offset, count, seed, checksum, stats)) {
+        return false;
+    }
+    
+    cursor.offset += count;
+    cursor.checksum = checksum;
+    return true;
+}
+
+/**
+ * @brief Registra en el manifiesto el tramo de salida escrito por un nodo
+ *
+ * @param manifest Manifiesto del ordenamiento
+ * @param node Nombre del archivo de entrada del nodo
+ * @param source Checksum de esa entrada
+ * @param start Cursor al comenzar el nodo
+ * @param end Cursor al terminarlo
+ *
+ * @note Se persiste en el siguiente commit()
+ */
+static void recordNode(SortManifest& manifest, const std::string& node, uint64_t source,
+                       const OutputCursor& start, const OutputCursor& end) {
+    manifest.set("node:" + node, std::to_string(source) + " " + std::to_string(start.offset) + " " +
+                 std::to_string(end.offset - start.offset) + " " + std::to_string(start.checksum) + " " +
+                 std::to_string(end.checksum));
+}
+
+/**
+ * @brief Ordena en memoria los datos de una hoja
+ *
+ * @param buffer Datos a ordenar
+ * @param options Con options.adaptive una hoja monótona no se ordena; si
+ *                options.presortInfo no es nulo recibe su orden previo
+ */
+static void sortInMemory(std::vector<int64_t>& buffer, const SortOptions& options) {
+    if (!options.adaptive) {
+        simdSort(buffer);
+        return;
+    }
+    
+    PresortScanner scanner;
+    PresortInfo leafInfo = scanner.scan(buffer);
+    leafInfo.strategy = leafInfo.ascending() ? PresortStrategy::ALREADY_SORTED
+                      : leafInfo.descending() ? PresortStrategy::REVERSE
+                      : PresortStrategy::STANDARD;
+    
+    if (leafInfo.strategy == PresortStrategy::REVERSE) {
+        std::reverse(buffer.begin(), buffer.end());
+    } else if (leafInfo.strategy == PresortStrategy::STANDARD) {
+        simdSort(buffer);
+    }
+    if (options.presortInfo) {
+        leafInfo.mergeInputs = 1;
+        *options.presortInfo = leafInfo;
+    }
+}
+
+/**
+ * @brief Escribe tramos ordenados en la posición del cursor, aplicando el operador
+ *
+ * Todo se escribe con una sola escritura, así que varios tramos pequeños pagan el
+ * redondeo a bloques una única vez.
+ *
+ * @param outputFilename Archivo de salida
+ * @param buffer Tramos consecutivos; cada uno ordenado y con claves mayores que el anterior
+ * @param ends Fin (exclusivo) de cada tramo dentro de buffer
+ * @param op Operador a aplicar
+ * @param cursor Posición de escritura; se avanza hasta el final de lo escrito
+ * @param checksums Si es false no se calculan checksums (solo hacen falta con manifiesto)
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return std::vector<OutputCursor> Cursor al final de cada tramo
+ */
+static std::vector<OutputCursor> writeSegments(const std::string& outputFilename,
+                                               const std::vector<int64_t>& buffer,
+                                               const std::vector<size_t>& ends,
+                                               SortOperator op, OutputCursor& cursor,
+                                               bool checksums, IOStats& stats) {
+    std::vector<OutputCursor> segmentEnds;
+    std::ofstream outputFile = openAt(outputFilename, cursor.offset);
+    int outputDevice = stats.deviceOf(outputFilename);
+    size_t begin = 0;
+    
+    if (op == SortOperator::NONE) {
+        writeBlock(outputFile, buffer, stats, outputDevice);
+        for (size_t end : ends) {
+            for (size_t k = begin; checksums && k < end; ++k) {
+                cursor.checksum = checksumValue(cursor.checksum, buffer[k]);
+            }
+            cursor.offset += end - begin;
+            segmentEnds.push_back(cursor);
+            begin = end;
+        }
+    } else {
+        OperatorSink sink(outputFile, op, buffer.size(), stats, outputDevice, cursor.checksum);
+        OutputCursor start = cursor;
+        for (size_t end : ends) {
+            for (size_t k = begin; k < end; ++k) {
+                sink.push(buffer[k]);
+            }
+            sink.endGroup();
+            cursor.offset = start.offset + sink.written();
+            cursor.checksum = sink.checksum();
+            segmentEnds.push_back(cursor);
+            begin = end;
+        }
+        sink.finish();
+    }
+    outputFile.close();
+    
+    return segmentEnds;
+}
+
+/**
+ * @brief Copia un archivo ya ordenado a la posición del cursor, aplicando el operador
+ *
+ * @param inputFilename Archivo ordenado
+ * @param outputFilename Archivo de salida
+ * @param bufferSize Elementos por lectura
+ * @param op Operador a aplicar
+ * @param cursor Posición de escritura; se avanza hasta el final de lo escrito
+ * @param checksums Si es false no se calculan checksums (solo hacen falta con manifiesto)
+ * @param stats Objeto para registrar estadísticas de I/O
+ */
+static void copySorted(const std::string& inputFilename, const std::string& outputFilename,
+                       size_t bufferSize, SortOperator op, OutputCursor& cursor,
+                       bool checksums, IOStats& stats) {
+    std::ifstream inputFile(inputFilename, std::ios::binary);
+    std::ofstream outputFile = openAt(outputFilename, cursor.offset);
+    std::vector<int64_t> buffer;
+    int inputDevice = stats.deviceOf(inputFilename);
+    int outputDevice = stats.deviceOf(outputFilename);
+    
+    if (op == SortOperator::NONE) {
+        while (readBlock(inputFile, buffer, bufferSize, stats, inputDevice) > 0) {
+            writeBlock(outputFile, buffer, stats, outputDevice);
+            cursor.offset += buffer.size();
+            if (checksums) cursor.checksum = checksumBlock(cursor.checksum, buffer);
+        }
+    } else {
+        OperatorSink sink(outputFile, op, bufferSize, stats, outputDevice, cursor.checksum);
+        while (readBlock(inputFile, buffer, bufferSize, stats, inputDevice) > 0) {
+            sink.push(buffer);
+        }
+        sink.finish();
+        cursor.offset += sink.written();
+        cursor.checksum = sink.checksum();
+    }
+    outputFile.close();
+}
+
+/**
+ * @brief Bloques de B bytes que ocupan n elementos
+ */
+static size_t blocksFor(size_t n) {
+    return (n * sizeof(int64_t) + B - 1) / B;
+}
+
 /**
  * @brief Implementación recursiva del Quicksort externo
  * 
  * @param inputFilename Archivo de entrada a ordenar
- * @param outputFilename Archivo de salida ordenado
+ * @param outputFilename Archivo de salida, ya creado con al menos el tamaño de la entrada
+ * @param cursor Posición donde se escribe el resultado de este nodo; al volver
+ *               apunta al final de lo escrito
  * @param arity Número de particiones a crear en cada paso
  * @param memoryLimit Límite de memoria para ordenar en RAM
- * @param tempDir Directorio para archivos temporales
+ * @param storage Directorios para archivos temporales
  * @param stats Objeto para registrar estadísticas de I/O
+ * @param options Opciones adicionales (operador sobre la salida, detección de orden previo)
+ * @param manifest Si no es nulo, cada paso terminado se confirma en él
  * 
  * @note Si el archivo cabe en memoria, lo ordena directamente
  * @note Para archivos grandes, usa particionamiento recursivo
+ * @note Tras partition() se conoce el tamaño de cada partición, y como las
+ *       particiones se procesan en orden cada hoja escribe directo en su posición
+ *       final de la salida: no hay archivos ordenados intermedios ni concatenación,
+ *       que costaba una lectura y una escritura de cada elemento por nivel
+ * @note El operador se aplica al escribir cada hoja: como una clave nunca queda
+ *       repartida entre dos particiones no se necesita otra pasada, y el cursor
+ *       avanza solo lo que la hoja escribió
+ * @note Los nombres de las particiones dependen del nombre de la entrada, así que
+ *       cada nodo del árbol de recursión tiene archivos propios; al reanudar, un
+ *       nodo cuyo tramo de salida se verifica se omite, y uno ya particionado
+ *       reutiliza sus particiones (los pivotes son aleatorios, por lo que no se
+ *       pueden recalcular)
  */
 void quicksortRecursive(const std::string& inputFilename, 
                         const std::string& outputFilename, 
+                        OutputCursor& cursor,
                         size_t arity,
                         size_t memoryLimit, 
-                        const std::string& tempDir,
-                        IOStats& stats) {
+                        TempStorage& storage,
+                        IOStats& stats,
+                        const SortOptions& options,
+                        SortManifest* manifest,
+                        const PartitionSample* sample) {
+    // Cada nodo confirmado guarda el checksum de su entrada: si un nodo se vuelve
+    // a particionar (con otros pivotes) lo que quedaba de sus descendientes deja
+    // de coincidir y se rehace
+    size_t verifyBuffer = B / sizeof(int64_t);
+    std::string node = fs::path(inputFilename).filename().string();
+    const FileRecord* inputRecord = manifest ? manifest->record(inputFilename) : nullptr;
+    uint64_t source = inputRecord ? inputRecord->checksum : 0;
+    OutputCursor start = cursor;
+    
+    if (manifest && finishedNode(*manifest, node, source, outputFilename, cursor, stats)) {
+        return;
+    }
+    
     // Obtener el tamaño del archivo
     int64_t fileSize = fs::file_size(inputFilename);
     
     // Si el archivo es pequeño, ordenar en memoria
     if (fileSize <= memoryLimit) {
+        if (options.progress) options.progress->setPhase(SortPhase::LEAF);
         std::ifstream inputFile(inputFilename, std::ios::binary);
         std::vector<int64_t> buffer;
         
         // Leer todo el archivo
-        size_t itemsRead = readBlock(inputFile, buffer, fileSize / sizeof(int64_t), stats);
+        size_t itemsRead = readBlock(inputFile, buffer, fileSize / sizeof(int64_t), stats,
+                                     stats.deviceOf(inputFilename));
         inputFile.close();
         
-        // Ordenar en memoria
-        std::sort(buffer.begin(), buffer.end());
+        // Ordenar en memoria (con options.adaptive, una hoja monótona no se ordena)
+        sortInMemory(buffer, options);
         
-        // Escribir resultado ordenado
-        std::ofstream outputFile(outputFilename, std::ios::binary);
-        writeBlock(outputFile, buffer, stats);
-        outputFile.close();
+        // Escribir el resultado en su posición de la salida aplicando el operador
+        writeSegments(outputFilename, buffer, {buffer.size()}, options.op, cursor, manifest != nullptr, stats);
+        if (options.quicksortStats) {
+            options.quicksortStats->leaves++;
+        }
         
+        if (manifest) {
+            recordNode(*manifest, node, source, start, cursor);
+            manifest->commit();
+        }
         return;
     }
     
-    // Seleccionar pivotes
-    std::vector<int64_t> pivots = selectPivots(inputFilename, arity - 1, stats);
+    // Todas las claves son iguales (el rango medido por el padre es un punto): la
+    // entrada ya está ordenada, y particionarla no la dividiría
+    if (sample && sample->minimum == sample->maximum) {
+        if (options.progress) options.progress->setPhase(SortPhase::LEAF);
+        copySorted(inputFilename, outputFilename, memoryLimit / sizeof(int64_t), options.op, cursor,
+                   manifest != nullptr, stats);
+        if (manifest) {
+            recordNode(*manifest, node, source, start, cursor);
+            manifest->commit();
+        }
+        return;
+    }
     
-    // Crear archivos temporales para las particiones
+    // Crear archivos temporales para las particiones, repartidos entre los
+    // directorios temporales. Al reanudar se usan los que ya existen
     std::vector<std::string> partitionFiles;
     for (size_t i = 0; i < arity; ++i) {
-        partitionFiles.push_back(tempDir + "/partition_" + std::to_string(i) + "_" + 
-                               fs::path(inputFilename).filename().string());
+        std::string partitionName = "partition_" + std::to_string(i) + "_" + node;
+        std::string partitionFile = manifest ? storage.find(partitionName) : "";
+        
+        if (partitionFile.empty()) partitionFile = storage.place(partitionName);
+        partitionFiles.push_back(partitionFile);
     }
     
-    // Particionar el archivo de entrada
-    partition(inputFilename, partitionFiles, pivots, memoryLimit, stats);
+    // Al reanudar, un nodo ya particionado (con la misma entrada) sirve si sus
+    // particiones no vacías, en orden, ya escribieron su tramo o siguen intactas.
+    // La clave del nodo guarda el checksum de su entrada, si las particiones ya
+    // venían ordenadas y el checksum de cada partición, que es el origen de su tramo
+    std::string splitKey = "split:" + node;
+    std::vector<bool> done(arity, false);
+    std::vector<OutputCursor> doneEnd(arity);
+    bool resumeSplit = false;
+    bool partitionsSorted = false;
+    if (manifest) {
+        std::istringstream split(manifest->get(splitKey));
+        uint64_t splitSource;
+        std::vector<uint64_t> checksums(arity);
+        split >> splitSource >> partitionsSorted;
+        for (auto& checksum : checksums) split >> checksum;
+        resumeSplit = split && splitSource == source;
+        
+        // Las particiones se procesan en orden: solo un prefijo puede estar terminado
+        OutputCursor resumeCursor = cursor;
+        bool prefix = true;
+        for (size_t i = 0; resumeSplit && i < arity; ++i) {
+            if (checksums[i] == CHECKSUM_SEED) continue;  // partición vacía
+            
+            std::string child = fs::path(partitionFiles[i]).filename().string();
+            prefix = prefix && finishedNode(*manifest, child, checksums[i], outputFilename, resumeCursor, stats);
+            done[i] = prefix;
+            doneEnd[i] = resumeCursor;
+            if (!done[i]) {
+                const FileRecord* partitionRecord = manifest->record(partitionFiles[i]);
+                resumeSplit = partitionRecord && partitionRecord->source == source &&
+                              partitionRecord->checksum == checksums[i] &&
+                              manifest->verify(partitionFiles[i], verifyBuffer, stats);
+            }
+        }
+        if (!resumeSplit) {
+            std::fill(done.begin(), done.end(), false);
+        }
+    }
     
-    // Ordenar recursivamente cada partición
-    std::vector<std::string> sortedPartitionFiles;
-    for (size_t i = 0; i < arity; ++i) {
-        std::string sortedFile = tempDir + "/sorted_" + std::to_string(i) + "_" + 
-                                fs::path(inputFilename).filename().string();
+    PartitionInfo info;
+    if (!resumeSplit) {
+        if (options.progress) {
+            options.progress->setPhase(SortPhase::PARTITION,
+                                       options.quicksortStats ? options.quicksortStats->passes + 1 : 0);
+        }
+        // Seleccionar pivotes: de la muestra que tomó la partición del padre si la
+        // hay (sin I/O), o de un bloque aleatorio de la entrada
+        bool sampled = sample && !sample->values.empty();
+        std::vector<int64_t> pivots = sampled ? pivotsFromSample(sample->values, arity - 1)
+                                              : selectPivots(inputFilename, arity - 1, stats);
+        
+        // Particionar el archivo de entrada, midiendo su orden previo en la misma lectura
+        partition(inputFilename, partitionFiles, pivots, memoryLimit, stats, &info, &options.asyncIO,
+                  options.asyncReport);
         
-        // Verificar si el archivo de partición existe y no está vacío
-        if (fs::exists(partitionFiles[i]) && fs::file_size(partitionFiles[i]) > 0) {
-            quicksortRecursive(partitionFiles[i], sortedFile, arity, memoryLimit, tempDir, stats);
-            sortedPartitionFiles.push_back(sortedFile);
+        // Calidad de los pivotes: razón entre la partición más grande y la más chica
+        if (options.quicksortStats) {
+            QuicksortStats& qs = *options.quicksortStats;
+            size_t largest = *std::max_element(info.counts.begin(), info.counts.end());
+            size_t smallest = *std::min_element(info.counts.begin(), info.counts.end());
+            double ratio = double(largest) / std::max<size_t>(smallest, 1);
+            qs.partitions += arity - std::count(info.counts.begin(), info.counts.end(), size_t(0));
+            qs.passes++;
+            qs.sampledPasses += sampled;
+            qs.worstRatio = std::max(qs.worstRatio, ratio);
+            qs.ratioSum += ratio;
         }
         
-        // Eliminar el archivo de partición
-        if (fs::exists(partitionFiles[i])) {
-            fs::remove(partitionFiles[i]);
+        // Si la entrada estaba ordenada, cada partición (una subsecuencia) también
+        // lo está: no hace falta recursar en ella
+        PresortInfo& presort = info.presort;
+        partitionsSorted = options.adaptive && presort.ascending() && options.op == SortOperator::NONE;
+        if (options.adaptive) {
+            presort.strategy = presort.ascending() ? PresortStrategy::ALREADY_SORTED
+                             : presort.descending() ? PresortStrategy::REVERSE
+                             : PresortStrategy::STANDARD;
+            if (options.presortInfo) {
+                *options.presortInfo = presort;
+            }
+        }
+        
+        if (manifest) {
+            std::string split = std::to_string(source) + " " + (partitionsSorted ? "1" : "0");
+            for (size_t i = 0; i < arity; ++i) {
+                manifest->erase("node:" + fs::path(partitionFiles[i]).filename().string());
+                manifest->recordFile(partitionFiles[i], info.counts[i] * sizeof(int64_t), info.checksums[i], source);
+                split += " " + std::to_string(info.checksums[i]);
+            }
+            manifest->set(splitKey, split);
+            manifest->commit();
         }
     }
+    SortOptions childOptions = options;
+    childOptions.presortInfo = nullptr;
     
-    // Concatenar las particiones ordenadas
-    std::ofstream outputFile(outputFilename, std::ios::binary);
+    // Tamaño (en elementos) de cada partición pendiente
+    std::vector<size_t> sizes(arity, 0);
+    for (size_t i = 0; i < arity; ++i) {
+        if (!done[i] && fs::exists(partitionFiles[i])) {
+            sizes[i] = fs::file_size(partitionFiles[i]) / sizeof(int64_t);
+        }
+    }
     
-    for (const auto& partitionFile : sortedPartitionFiles) {
-        if (!fs::exists(partitionFile)) continue;
-        
-        std::ifstream inputFile(partitionFile, std::ios::binary);
-        std::vector<int64_t> buffer;
-        
-        // Leer y escribir por bloques
-        while (true) {
-            size_t read = readBlock(inputFile, buffer, memoryLimit / sizeof(int64_t), stats);
-            if (read == 0) break;
+    // Ordenar recursivamente cada partición, en orden, escribiendo a continuación
+    // de la anterior
+    size_t memoryElements = memoryLimit / sizeof(int64_t);
+    for (size_t i = 0; i < arity; ) {
+        // Particiones pequeñas consecutivas: se agrupan mientras quepan juntas en
+        // memoria. Sus rangos de claves no se solapan, así que cada una se ordena
+        // en su propio tramo y el lote se escribe con una sola escritura
+        size_t next = i;
+        if (!partitionsSorted) {
+            std::vector<size_t> batch;
+            size_t batchSize = 0;
+            for (size_t j = i; j < arity && !done[j]; ++j) {
+                if (batchSize + sizes[j] > memoryElements) break;
+                if (sizes[j] > 0) batch.push_back(j);
+                batchSize += sizes[j];
+                next = j + 1;
+            }
             
-            writeBlock(outputFile, buffer, stats);
+            if (batch.size() < 2) {
+                next = i;
+            } else {
+                if (options.progress) options.progress->setPhase(SortPhase::LEAF);
+                std::vector<int64_t> buffer;
+                std::vector<int64_t> segment;
+                std::vector<size_t> ends;
+                buffer.reserve(batchSize);
+                for (size_t j : batch) {
+                    std::ifstream inputFile(partitionFiles[j], std::ios::binary);
+                    readBlock(inputFile, segment, sizes[j], stats, stats.deviceOf(partitionFiles[j]));
+                    sortInMemory(segment, childOptions);
+                    buffer.insert(buffer.end(), segment.begin(), segment.end());
+                    ends.push_back(buffer.size());
+                }
+                
+                OutputCursor batchStart = cursor;
+                std::vector<OutputCursor> segmentEnds =
+                    writeSegments(outputFilename, buffer, ends, options.op, cursor, manifest != nullptr, stats);
+                
+                // Sin agrupar, cada tramo habría pagado su propio redondeo a bloques
+                if (options.quicksortStats) {
+                    QuicksortStats& qs = *options.quicksortStats;
+                    size_t separateBlocks = 0;
+                    size_t previous = batchStart.offset;
+                    for (const auto& end : segmentEnds) {
+                        separateBlocks += blocksFor(end.offset - previous);
+                        previous = end.offset;
+                    }
+                    qs.leaves++;
+                    qs.batches++;
+                    qs.coalesced += batch.size();
+                    qs.blocksSaved += separateBlocks - blocksFor(cursor.offset - batchStart.offset);
+                }
+                
+                // Cada partición del lote queda confirmada con su tramo, en un solo commit
+                if (manifest) {
+                    OutputCursor segmentStart = batchStart;
+                    for (size_t k = 0; k < batch.size(); ++k) {
+                        recordNode(*manifest, fs::path(partitionFiles[batch[k]]).filename().string(),
+                                   manifest->record(partitionFiles[batch[k]])->checksum, segmentStart, segmentEnds[k]);
+                        segmentStart = segmentEnds[k];
+                    }
+                    manifest->commit();
+                }
+            }
         }
         
-        inputFile.close();
+        if (next == i) {
+            if (done[i]) {
+                // Escrita en una ejecución anterior (ya verificada arriba)
+                cursor = doneEnd[i];
+            } else if (sizes[i] > 0) {
+                if (partitionsSorted) {
+                    // La partición ya está ordenada: se copia tal cual a su posición
+                    if (options.progress) options.progress->setPhase(SortPhase::LEAF);
+                    OutputCursor childStart = cursor;
+                    copySorted(partitionFiles[i], outputFilename, memoryElements, options.op, cursor,
+                               manifest != nullptr, stats);
+                    
+                    if (manifest) {
+                        recordNode(*manifest, fs::path(partitionFiles[i]).filename().string(),
+                                   manifest->record(partitionFiles[i])->checksum, childStart, cursor);
+                        manifest->commit();
+                    }
+                } else {
+                    // La muestra de la partición solo existe si se particionó en esta ejecución
+                    quicksortRecursive(partitionFiles[i], outputFilename, cursor, arity, memoryLimit, storage, stats,
+                                       childOptions, manifest, resumeSplit ? nullptr : &info.samples[i]);
+                }
+            }
+            next = i + 1;
+        }
         
-        // Eliminar archivo de partición ordenada
-        fs::remove(partitionFile);
+        // Eliminar los archivos de partición ya escritos
+        for (; i < next; ++i) {
+            if (manifest) manifest->forget(partitionFiles[i]);
+            if (fs::exists(partitionFiles[i])) {
+                fs::remove(partitionFiles[i]);
+            }
+        }
     }
     
-    outputFile.close();
+    // El tramo del nodo reemplaza a los de sus hijos
+    if (manifest) {
+        for (const auto& partitionFile : partitionFiles) {
+            manifest->erase("node:" + fs::path(partitionFile).filename().string());
+        }
+        manifest->erase(splitKey);
+        recordNode(*manifest, node, source, start, cursor);
+        manifest->commit();
+    }
 }
 
 /**
@@ -356,36 +865,93 @@ void quicksortRecursive(const std::string& inputFilename,
  * @param arity Número de particiones a crear en cada paso
  * @param memoryLimit Límite de memoria en bytes
  * @param stats Objeto para registrar estadísticas de I/O
+ * @param options Opciones adicionales (operador sobre la salida)
  * 
  * @note Maneja toda la lógica de directorios temporales
  * @note Mide y reporta tiempo de ejecución y operaciones I/O
+ * @note La salida se reserva completa al comenzar y se recorta al final a lo escrito
  */
 void externalQuickSort(const std::string& inputFilename, 
                       const std::string& outputFilename, 
                       size_t arity,
                       size_t memoryLimit,
-                      IOStats& stats) {
+                      IOStats& stats,
+                      const SortOptions& options) {
     auto startTime = std::chrono::high_resolution_clock::now();
     
     // Reiniciar estadísticas
     stats.reset();
+    ProgressScope progressScope(stats, options.progress, options.cancel);
     
     std::cout << "Iniciando Quicksort externo con " << arity << " particiones..." << std::endl;
     
-    // Crear directorio temporal
-    std::string tempDir = "./temp_quick_" + std::to_string(arity);
-    if (!fs::exists(tempDir)) {
-        fs::create_directories(tempDir);
+    // Crear directorios temporales
+    std::string tempName = "temp_quick_" + std::to_string(arity) +
+                           (options.tempNamespace.empty() ? "" : "_" + options.tempNamespace);
+    TempStorage storage(TempStorage::directoriesFor(options.tempDirs, tempName),
+                        options.placement, stats);
+    const std::string& tempDir = storage.primary();
+    
+    // Ejecutar Quicksort recursivo (el primer nivel reporta el orden previo de la entrada)
+    PresortInfo presort;
+    SortOptions topOptions = options;
+    if (!topOptions.presortInfo) {
+        topOptions.presortInfo = &presort;
+    }
+    QuicksortStats quicksortStats;
+    if (!topOptions.quicksortStats) {
+        topOptions.quicksortStats = &quicksortStats;
+    }
+    SortManifest manifest(tempDir, sortSignature("quicksort", inputFilename, arity, memoryLimit, options),
+                          options.checkpoint, options.stopAfterSteps);
+    if (manifest.resumed()) {
+        std::cout << "Reanudando desde checkpoint en " << tempDir << std::endl;
     }
     
-    // Ejecutar Quicksort recursivo
-    quicksortRecursive(inputFilename, outputFilename, arity, memoryLimit, tempDir, stats);
+    // Reservar la salida completa: las hojas escriben cada una en su posición. Al
+    // reanudar se conserva lo que ya tenía
+    if (!manifest.resumed() || !fs::exists(outputFilename)) {
+        std::ofstream(outputFilename, std::ios::binary | std::ios::trunc);
+    }
+    uintmax_t inputSize = fs::file_size(inputFilename);
+    fs::resize_file(outputFilename, inputSize);
+    manifest.watch(outputFilename);
+    
+    // Cada nivel de partición lee y escribe la entrada una vez, y las hojas otra
+    if (options.progress) {
+        size_t levels = 0;
+        for (uintmax_t size = inputSize; size > memoryLimit; size /= arity) {
+            levels++;
+        }
+        options.progress->expect(2 * inputSize * (levels + 1));
+    }
     
-    // Limpiar directorio temporal
-    for (const auto& entry : fs::directory_iterator(tempDir)) {
-        fs::remove(entry.path());
+    OutputCursor cursor;
+    try {
+        quicksortRecursive(inputFilename, outputFilename, cursor, arity, memoryLimit, storage, stats, topOptions,
+                           options.checkpoint ? &manifest : nullptr);
+    } catch (const SortInterrupted& interrupted) {
+        // El estado queda en tempDir para que la siguiente llamada lo reanude
+        std::cout << "Quicksort externo " << interrupted.what() << "; estado en " << tempDir << std::endl;
+        return;
+    } catch (const SortCancelled& cancelled) {
+        // Con checkpoints el estado (y la salida parcial) se conserva para reanudar
+        progressScope.cancelled();
+        if (manifest.enabled()) {
+            std::cout << "Quicksort externo " << cancelled.what() << "; estado en " << tempDir << std::endl;
+        } else {
+            storage.remove();
+            fs::remove(outputFilename);
+            std::cout << "Quicksort externo " << cancelled.what() << "; archivos temporales eliminados" << std::endl;
+        }
+        throw;
     }
-    fs::remove(tempDir);
+    
+    // Con un operador la salida es más corta que lo reservado
+    fs::resize_file(outputFilename, cursor.offset * sizeof(int64_t));
+    
+    // Limpiar directorios temporales
+    storage.remove();
     
     auto endTime = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = endTime - startTime;
@@ -394,4 +960,17 @@ void externalQuickSort(const std::string& inputFilename,
     std::cout << "Operaciones de lectura: " << stats.reads << std::endl;
     std::cout << "Operaciones de escritura: " << stats.writes << std::endl;
     std::cout << "Total operaciones I/O: " << stats.total() << std::endl;
+    if (options.adaptive) {
+        std::cout << "Orden previo: " << topOptions.presortInfo->ascendingRuns << " runs ascendentes, "
+                  << topOptions.presortInfo->descendingRuns << " runs descendentes, estrategia: "
+                  << presortStrategyName(topOptions.presortInfo->strategy) << std::endl;
+    }
+    const QuicksortStats& qs = *topOptions.quicksortStats;
+    std::cout << "Particiones: " << qs.partitions << ", hojas: " << qs.leaves << " ("
+              << qs.coalesced << " particiones pequeñas agrupadas en " << qs.batches << " lotes: "
+              << qs.leavesSaved() << " hojas y " << qs.blocksSaved << " bloques de escritura menos)" << std::endl;
+    std::cout << "Pivotes: " << qs.sampledPasses << " de " << qs.passes
+              << " pasadas usaron la muestra de la partición anterior; razón partición mayor/menor: promedio "
+              << qs.meanRatio() << ", peor " << qs.worstRatio << std::endl;
+    storage.report();
 }
\ No newline at end of file
@@ -3,12 +3,66 @@
 
 #include "iostats.h"
 #include "constants.h"
+#include "sortoptions.h"
+#include "tempstorage.h"
+#include "checkpoint.h"
 #include <string>
 #include <vector>
 #include <filesystem>
 
 namespace fs = std::filesystem;
 
+/**
+ * @brief Muestra de una partición tomada mientras se escribía
+ */
+struct PartitionSample {
+    std::vector<int64_t> values;  ///< Muestra uniforme (reservoir) de hasta B/sizeof(int64_t) elementos
+    int64_t minimum = 0;          ///< Menor clave de la partición (sin sentido si está vacía)
+    int64_t maximum = 0;          ///< Mayor clave de la partición (sin sentido si está vacía)
+};
+
+/**
+ * @brief Información recogida durante la pasada de partición
+ */
+struct PartitionInfo {
+    PresortInfo presort;                   ///< Orden previo de la entrada
+    std::vector<size_t> counts;            ///< Elementos escritos en cada partición
+    std::vector<uint64_t> checksums;       ///< Checksum (ver checkpoint.h) de cada partición
+    std::vector<PartitionSample> samples;  ///< Muestra y rango de claves de cada partición
+};
+
+/**
+ * @brief Posición de escritura dentro del archivo de salida de quicksortRecursive
+ *
+ * Cada hoja escribe en su posición absoluta de la salida y avanza el cursor, así
+ * que el siguiente nodo continúa justo donde terminó el anterior.
+ */
+struct OutputCursor {
+    size_t offset = 0;                  ///< Elementos de la salida ya escritos antes de esta posición
+    uint64_t checksum = CHECKSUM_SEED;  ///< Checksum de la salida hasta offset (solo con manifiesto)
+};
+
+/**
+ * @brief Resumen de las particiones y hojas de un Quicksort externo
+ */
+struct QuicksortStats {
+    size_t partitions = 0;   ///< Particiones no vacías creadas
+    size_t leaves = 0;       ///< Ordenamientos en memoria escritos a la salida
+    size_t coalesced = 0;    ///< Particiones pequeñas ordenadas en un lote junto a sus vecinas
+    size_t batches = 0;      ///< Lotes formados por esas particiones
+    size_t blocksSaved = 0;  ///< Bloques de escritura ahorrados al escribir cada lote de una vez
+    size_t passes = 0;         ///< Pasadas de partición
+    size_t sampledPasses = 0;  ///< Pasadas cuyos pivotes salieron de la muestra de la pasada anterior
+    double worstRatio = 0;     ///< Mayor razón entre la partición más grande y la más chica de una pasada
+    double ratioSum = 0;       ///< Suma de esas razones, para el promedio
+    
+    /** @brief Ordenamientos y escrituras separadas que se evitaron al agrupar */
+    size_t leavesSaved() const { return coalesced - batches; }
+    
+    /** @brief Razón máx/mín promedio entre pasadas (1 = pivotes perfectos) */
+    double meanRatio() const { return passes ? ratioSum / passes : 0; }
+};
+
 /**
  * @brief Divide un archivo en particiones usando pivotes
  * 
@@ -17,6 +71,13 @@ namespace fs = std::filesystem;
  * @param pivotes Vector con los valores pivote para la partición
  * @param memoryLimit Límite de memoria en bytes para procesamiento
  * @param stats Objeto para registrar estadísticas de I/O
+ * @param info Si no es nulo, recibe el orden previo de la entrada y el tamaño,
+ *             checksum, muestra y rango de claves de cada partición, medidos en
+ *             esta misma pasada
+ * 
+ * @param async Si no es nulo y está habilitado, la lectura y las escrituras de
+ *              cada partición se hacen con asyncDistribute
+ * @param asyncReport Si no es nulo, acumula el reporte de la I/O asíncrona
  * 
  * @note Crea múltiples archivos de salida, uno por cada partición
  * @note Los elementos menores al primer pivote van a la primera partición, etc.
@@ -25,7 +86,10 @@ void partition(const std::string& inputFilename,
                const std::vector<std::string>& outputFilenames,
                const std::vector<int64_t>& pivots, 
                size_t memoryLimit,
-               IOStats& stats);
+               IOStats& stats,
+               PartitionInfo* info = nullptr,
+               const AsyncIOOptions* async = nullptr,
+               AsyncIOReport* asyncReport = nullptr);
 
 /**
  * @brief Genera datos aleatorios en un archivo binario
@@ -64,25 +128,53 @@ std::vector<int64_t> selectPivots(const std::string& filename,
                                  size_t numPivots, 
                                  IOStats& stats);
 
+/**
+ * @brief Elige pivotes distribuidos uniformemente a partir de una muestra
+ *
+ * @param sample Muestra de la entrada (se ordena)
+ * @param numPivots Número de pivotes a seleccionar
+ * @return std::vector<int64_t> Pivotes en orden ascendente (toda la muestra si es más chica)
+ */
+std::vector<int64_t> pivotsFromSample(std::vector<int64_t> sample, size_t numPivots);
+
 /**
  * @brief Implementación recursiva del Quicksort externo
  * 
  * @param inputFilename Archivo de entrada a ordenar
- * @param outputFilename Archivo de salida ordenado
+ * @param outputFilename Archivo de salida, ya creado con al menos el tamaño de la entrada
+ * @param cursor Posición donde se escribe el resultado de este nodo; al volver
+ *               apunta al final de lo escrito
  * @param arity Número de particiones a crear en cada paso
  * @param memoryLimit Límite de memoria para ordenar en RAM
- * @param tempDir Directorio para archivos temporales
+ * @param storage Directorios para archivos temporales
  * @param stats Objeto para registrar estadísticas de I/O
+ * @param options Opciones adicionales (operador sobre la salida, detección de orden previo)
+ * @param manifest Si no es nulo, cada paso terminado se confirma en él
+ * @param sample Muestra y rango de claves de la entrada tomados por la partición
+ *               del nodo padre; si es nulo los pivotes se eligen con selectPivots
  * 
  * @note Si el archivo cabe en memoria, lo ordena directamente
  * @note Para archivos grandes, usa particionamiento recursivo
+ * @note Las hojas escriben directo en su posición de outputFilename, por lo que no
+ *       hay archivos ordenados intermedios ni concatenación
+ * @note options.op se aplica en cada hoja; el cursor avanza lo que realmente se escribió
+ * @note Las particiones pequeñas consecutivas se agrupan hasta llenar la memoria y
+ *       se ordenan y escriben como una sola hoja (cada una en su propio tramo)
+ * @note Con options.adaptive, si la pasada de partición detecta que la entrada ya
+ *       estaba ordenada las particiones se copian tal cual a la salida, sin recursar
+ * @note Con un manifiesto, las particiones y los tramos de salida terminados se
+ *       confirman; al reanudar, los que se verifican correctamente no se repiten
  */
 void quicksortRecursive(const std::string& inputFilename, 
                        const std::string& outputFilename, 
+                       OutputCursor& cursor,
                        size_t arity,
                        size_t memoryLimit, 
-                       const std::string& tempDir,
-                       IOStats& stats);
+                       TempStorage& storage,
+                       IOStats& stats,
+                       const SortOptions& options = SortOptions(),
+                       SortManifest* manifest = nullptr,
+                       const PartitionSample* sample = nullptr);
 
 /**
  * @brief Ordena un archivo usando Quicksort externo
@@ -92,13 +184,25 @@ void quicksortRecursive(const std::string& inputFilename,
  * @param arity Número de particiones a crear en cada paso
  * @param memoryLimit Límite de memoria en bytes
  * @param stats Objeto para registrar estadísticas de I/O
+ * @param options Opciones adicionales (operador sobre la salida)
  * 
  * @note Maneja toda la lógica de directorios temporales
  * @note Mide y reporta tiempo de ejecución y operaciones I/O
+ * @note La salida se reserva completa al comenzar y se recorta al final a lo escrito
+ *       (menos que la entrada con options.op)
+ * @note Con options.checkpoint el avance se guarda en ./temp_quick_[arity]/manifest.txt
+ *       y una nueva llamada con la misma entrada y parámetros lo reanuda
+ * @note Con varios options.tempDirs las particiones se reparten entre ellos (en
+ *       [raíz]/temp_quick_[arity]) según options.placement
+ * @note options.tempNamespace se agrega como sufijo (temp_quick_[arity]_[sufijo]);
+ *       ordenamientos concurrentes con la misma aridad necesitan sufijos distintos * @note Con options.cancel la cancelación toma efecto en el siguiente bloque: se
+ *       eliminan los temporales y la salida (se conservan con checkpoints) y se
+ *       lanza SortCancelled
  */
 void externalQuickSort(const std::string& inputFilename, 
                      const std::string& outputFilename, 
                      size_t arity,
                      size_t memoryLimit,
-                     IOStats& stats);             
+                     IOStats& stats,
+                     const SortOptions& options = SortOptions());             
 #endif
\ No newline at end of file
@@ -0,0 +1,351 @@
+#include "simdmerge.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <immintrin.h>
+
+// GCC 12 advierte sobre el registro "indefinido" que usan internamente los
+// intrínsecos de AVX-512 (_mm512_min_epi64, _mm512_permutexvar_epi64); es un falso positivo
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+/**
+ * @brief Mejor nivel soportado por la CPU actual
+ *
+ * @return SimdLevel Se detecta una sola vez, en la primera llamada
+ */
+SimdLevel simdLevel() {
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        return SimdLevel::SCALAR;
+    }();
+    return level;
+}
+
+/**
+ * @brief Nombre legible de un nivel
+ */
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+        default: return "scalar";
+    }
+}
+
+/**
+ * @brief Mezcla escalar de dos secuencias ordenadas
+ *
+ * @return int64_t* Posición siguiente al último elemento escrito
+ */
+static int64_t* scalarMerge(const int64_t* a, const int64_t* aEnd, const int64_t* b, const int64_t* bEnd,
+                            int64_t* out) {
+    while (a < aEnd && b < bEnd) {
+        *out++ = (*b < *a) ? *b++ : *a++;
+    }
+    size_t restA = aEnd - a;
+    std::memcpy(out, a, restA * sizeof(int64_t));
+    out += restA;
+    size_t restB = bEnd - b;
+    std::memcpy(out, b, restB * sizeof(int64_t));
+    return out + restB;
+}
+
+/**
+ * @brief Mezcla escalar de tres secuencias ordenadas (las colas de los kernels vectoriales)
+ */
+static void scalarMerge3(const int64_t* a, const int64_t* aEnd, const int64_t* b, const int64_t* bEnd,
+                         const int64_t* c, const int64_t* cEnd, int64_t* out) {
+    while (a < aEnd && b < bEnd && c < cEnd) {
+        if (*a <= *b && *a <= *c) *out++ = *a++;
+        else if (*b <= *c) *out++ = *b++;
+        else *out++ = *c++;
+    }
+    if (a == aEnd) scalarMerge(b, bEnd, c, cEnd, out);
+    else if (b == bEnd) scalarMerge(a, aEnd, c, cEnd, out);
+    else scalarMerge(a, aEnd, b, bEnd, out);
+}
+
+// ---------------------------------------------------------------------------
+// AVX2: 4 int64_t por registro
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static inline void minMax4(__m256i a, __m256i b, __m256i& mn, __m256i& mx) {
+    __m256i greater = _mm256_cmpgt_epi64(a, b);
+    mn = _mm256_blendv_epi8(a, b, greater);
+    mx = _mm256_blendv_epi8(b, a, greater);
+}
+
+/**
+ * @brief Ordena un registro bitónico de 4 elementos (comparaciones a distancia 2 y 1)
+ */
+__attribute__((target("avx2")))
+static inline __m256i sortBitonic4(__m256i v) {
+    __m256i mn, mx;
+    minMax4(v, _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2)), mn, mx);
+    v = _mm256_blend_epi32(mn, mx, 0xF0);
+    minMax4(v, _mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 3, 0, 1)), mn, mx);
+    return _mm256_blend_epi32(mn, mx, 0xCC);
+}
+
+/**
+ * @brief Red bitónica 4x4: lo y hi ordenados quedan con los 4 menores y los 4 mayores
+ */
+__attribute__((target("avx2")))
+static inline void bitonicMerge4(__m256i& lo, __m256i& hi) {
+    __m256i mn, mx;
+    minMax4(lo, _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(0, 1, 2, 3)), mn, mx);
+    lo = sortBitonic4(mn);
+    hi = sortBitonic4(mx);
+}
+
+__attribute__((target("avx2")))
+static void mergeAvx2(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out) {
+    const size_t W = 4;
+    if (na < W || nb < W) {
+        scalarMerge(a, a + na, b, b + nb, out);
+        return;
+    }
+
+    const int64_t* aEnd = a + na;
+    const int64_t* bEnd = b + nb;
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+    a += W;
+    b += W;
+
+    // hi guarda los W mayores vistos; se recarga desde la secuencia de menor cabeza
+    while (true) {
+        bitonicMerge4(lo, hi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), lo);
+        out += W;
+
+        const int64_t*& next = (a < aEnd && (b == bEnd || *a < *b)) ? a : b;
+        const int64_t* nextEnd = (&next == &a) ? aEnd : bEnd;
+        if (nextEnd - next < static_cast<ptrdiff_t>(W)) break;
+        lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(next));
+        next += W;
+    }
+
+    alignas(32) int64_t rest[W];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(rest), hi);
+    scalarMerge3(rest, rest + W, a, aEnd, b, bEnd, out);
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512: 8 int64_t por registro
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Ordena un registro bitónico de 8 elementos (comparaciones a distancia 4, 2 y 1)
+ */
+__attribute__((target("avx512f")))
+static inline __m512i sortBitonic8(__m512i v) {
+    const __m512i swap4 = _mm512_set_epi64(3, 2, 1, 0, 7, 6, 5, 4);
+    const __m512i swap2 = _mm512_set_epi64(5, 4, 7, 6, 1, 0, 3, 2);
+    const __m512i swap1 = _mm512_set_epi64(6, 7, 4, 5, 2, 3, 0, 1);
+
+    __m512i t = _mm512_permutexvar_epi64(swap4, v);
+    v = _mm512_mask_blend_epi64(0xF0, _mm512_min_epi64(v, t), _mm512_max_epi64(v, t));
+    t = _mm512_permutexvar_epi64(swap2, v);
+    v = _mm512_mask_blend_epi64(0xCC, _mm512_min_epi64(v, t), _mm512_max_epi64(v, t));
+    t = _mm512_permutexvar_epi64(swap1, v);
+    return _mm512_mask_blend_epi64(0xAA, _mm512_min_epi64(v, t), _mm512_max_epi64(v, t));
+}
+
+/**
+ * @brief Red bitónica 8x8: lo y hi ordenados quedan con los 8 menores y los 8 mayores
+ */
+__attribute__((target("avx512f")))
+static inline void bitonicMerge8(__m512i& lo, __m512i& hi) {
+    const __m512i reverse = _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    __m512i reversed = _mm512_permutexvar_epi64(reverse, hi);
+    __m512i mn = _mm512_min_epi64(lo, reversed);
+    __m512i mx = _mm512_max_epi64(lo, reversed);
+    lo = sortBitonic8(mn);
+    hi = sortBitonic8(mx);
+}
+
+__attribute__((target("avx512f")))
+static void mergeAvx512(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out) {
+    const size_t W = 8;
+    if (na < W || nb < W) {
+        scalarMerge(a, a + na, b, b + nb, out);
+        return;
+    }
+
+    const int64_t* aEnd = a + na;
+    const int64_t* bEnd = b + nb;
+    __m512i lo = _mm512_loadu_si512(a);
+    __m512i hi = _mm512_loadu_si512(b);
+    a += W;
+    b += W;
+
+    // hi guarda los W mayores vistos; se recarga desde la secuencia de menor cabeza
+    while (true) {
+        bitonicMerge8(lo, hi);
+        _mm512_storeu_si512(out, lo);
+        out += W;
+
+        const int64_t*& next = (a < aEnd && (b == bEnd || *a < *b)) ? a : b;
+        const int64_t* nextEnd = (&next == &a) ? aEnd : bEnd;
+        if (nextEnd - next < static_cast<ptrdiff_t>(W)) break;
+        lo = _mm512_loadu_si512(next);
+        next += W;
+    }
+
+    alignas(64) int64_t rest[W];
+    _mm512_store_si512(rest, hi);
+    scalarMerge3(rest, rest + W, a, aEnd, b, bEnd, out);
+}
+
+/**
+ * @brief Mezcla dos secuencias ordenadas en memoria
+ *
+ * @param a Primera secuencia ordenada
+ * @param na Largo de a
+ * @param b Segunda secuencia ordenada
+ * @param nb Largo de b
+ * @param out Destino de na + nb elementos
+ * @param level Kernel a usar; si la CPU no lo soporta se usa el mejor disponible
+ */
+void mergeTwo(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out, SimdLevel level) {
+    if (static_cast<int>(level) > static_cast<int>(simdLevel())) {
+        level = simdLevel();
+    }
+
+    switch (level) {
+        case SimdLevel::AVX512:
+            mergeAvx512(a, na, b, nb, out);
+            break;
+        case SimdLevel::AVX2:
+            mergeAvx2(a, na, b, nb, out);
+            break;
+        default:
+            scalarMerge(a, a + na, b, b + nb, out);
+            break;
+    }
+}
+
+/**
+ * @brief Mezcla k secuencias ordenadas en memoria con un árbol de mezclas de a dos
+ *
+ * @param runs Secuencias ordenadas
+ * @param out Recibe el resultado
+ * @param level Kernel a usar en cada mezcla
+ */
+void mergeKWay(const std::vector<std::vector<int64_t>>& runs, std::vector<int64_t>& out, SimdLevel level) {
+    if (runs.empty()) {
+        out.clear();
+        return;
+    }
+    if (runs.size() == 1) {
+        out = runs[0];
+        return;
+    }
+
+    // Primer nivel: directamente desde las entradas
+    std::vector<std::vector<int64_t>> current;
+    for (size_t i = 0; i < runs.size(); i += 2) {
+        if (i + 1 == runs.size()) {
+            current.push_back(runs[i]);
+            continue;
+        }
+        std::vector<int64_t> merged(runs[i].size() + runs[i + 1].size());
+        mergeTwo(runs[i].data(), runs[i].size(), runs[i + 1].data(), runs[i + 1].size(), merged.data(), level);
+        current.push_back(std::move(merged));
+    }
+
+    // Niveles siguientes hasta que quede una sola secuencia
+    while (current.size() > 1) {
+        std::vector<std::vector<int64_t>> next;
+        for (size_t i = 0; i < current.size(); i += 2) {
+            if (i + 1 == current.size()) {
+                next.push_back(std::move(current[i]));
+                continue;
+            }
+            std::vector<int64_t> merged(current[i].size() + current[i + 1].size());
+            mergeTwo(current[i].data(), current[i].size(), current[i + 1].data(), current[i + 1].size(),
+                     merged.data(), level);
+            next.push_back(std::move(merged));
+        }
+        current = std::move(next);
+    }
+
+    out = std::move(current[0]);
+}
+
+/**
+ * @brief Ordena en memoria: std::sort por bloques que caben en caché y mezclas con mergeTwo
+ *
+ * @param data Datos a ordenar
+ * @param level Kernel a usar en las mezclas
+ */
+void simdSort(std::vector<int64_t>& data, SimdLevel level) {
+    // 32KB por bloque: cada std::sort trabaja dentro de la caché L1/L2
+    const size_t BLOCK = 4096;
+    size_t n = data.size();
+    for (size_t begin = 0; begin < n; begin += BLOCK) {
+        std::sort(data.begin() + begin, data.begin() + std::min(n, begin + BLOCK));
+    }
+    if (n <= BLOCK) return;
+
+    // Pasadas de mezcla alternando entre data y un buffer auxiliar
+    std::vector<int64_t> buffer(n);
+    int64_t* source = data.data();
+    int64_t* target = buffer.data();
+    for (size_t width = BLOCK; width < n; width *= 2) {
+        for (size_t begin = 0; begin < n; begin += 2 * width) {
+            size_t middle = std::min(n, begin + width);
+            size_t end = std::min(n, begin + 2 * width);
+            mergeTwo(source + begin, middle - begin, source + middle, end - middle, target + begin, level);
+        }
+        std::swap(source, target);
+    }
+
+    if (source != data.data()) {
+        data.swap(buffer);
+    }
+}
+
+/**
+ * @brief Mezcla k secuencias ordenadas con un heap de mínimos, elemento a elemento
+ *
+ * @param runs Secuencias ordenadas
+ * @param out Recibe el resultado
+ */
+void heapMergeKWay(const std::vector<std::vector<int64_t>>& runs, std::vector<int64_t>& out) {
+    size_t total = 0;
+    for (const auto& run : runs) total += run.size();
+    out.clear();
+    out.reserve(total);
+
+    // (valor, run): mismo orden que HeapNode en RunMerger
+    using Node = std::pair<int64_t, size_t>;
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> minHeap;
+    std::vector<size_t> positions(runs.size(), 0);
+    for (size_t j = 0; j < runs.size(); ++j) {
+        if (!runs[j].empty()) minHeap.push({runs[j][0], j});
+    }
+    while (!minHeap.empty()) {
+        Node top = minHeap.top();
+        minHeap.pop();
+        out.push_back(top.first);
+        if (++positions[top.second] < runs[top.second].size()) {
+            minHeap.push({runs[top.second][positions[top.second]], top.second});
+        }
+    }
+}
+
+/**
+ * @brief std::sort sobre todo el vector
+ *
+ * @param data Datos a ordenar
+ */
+void referenceSort(std::vector<int64_t>& data) {
+    std::sort(data.begin(), data.end());
+}
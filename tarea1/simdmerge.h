@@ -0,0 +1,87 @@
+#ifndef SIMDMERGE_H
+#define SIMDMERGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Conjunto de instrucciones usado por los kernels de mezcla
+ */
+enum class SimdLevel {
+    SCALAR,  ///< Mezcla elemento a elemento, sin instrucciones vectoriales
+    AVX2,    ///< Redes bitónicas sobre registros de 4 int64_t
+    AVX512   ///< Redes bitónicas sobre registros de 8 int64_t (AVX-512F)
+};
+
+/**
+ * @brief Mejor nivel soportado por la CPU actual
+ *
+ * @return SimdLevel Se detecta una sola vez, en la primera llamada
+ */
+SimdLevel simdLevel();
+
+/**
+ * @brief Nombre legible de un nivel
+ */
+const char* simdLevelName(SimdLevel level);
+
+/**
+ * @brief Mezcla dos secuencias ordenadas en memoria
+ *
+ * Con AVX2 / AVX-512 mantiene un registro con los elementos mayores vistos y, en
+ * cada paso, carga un bloque de la secuencia cuyo siguiente elemento es menor y
+ * lo mezcla con una red bitónica; la mitad menor del resultado ya es definitiva
+ * y se escribe. Las colas (menos de un registro) se mezclan de forma escalar.
+ *
+ * @param a Primera secuencia ordenada
+ * @param na Largo de a
+ * @param b Segunda secuencia ordenada
+ * @param nb Largo de b
+ * @param out Destino de na + nb elementos (no puede solaparse con a ni b)
+ * @param level Kernel a usar; si la CPU no lo soporta se usa el mejor disponible
+ */
+void mergeTwo(const int64_t* a, size_t na, const int64_t* b, size_t nb, int64_t* out,
+              SimdLevel level = simdLevel());
+
+/**
+ * @brief Mezcla k secuencias ordenadas en memoria con un árbol de mezclas de a dos
+ *
+ * Cada nivel del árbol mezcla pares de secuencias con mergeTwo, por lo que el
+ * kernel vectorial es la hoja de la mezcla k-vías (log2(k) pasadas sobre los
+ * datos en lugar de un heap con log2(k) comparaciones por elemento).
+ *
+ * @param runs Secuencias ordenadas
+ * @param out Recibe el resultado (se redimensiona)
+ * @param level Kernel a usar en cada mezcla
+ */
+void mergeKWay(const std::vector<std::vector<int64_t>>& runs, std::vector<int64_t>& out,
+               SimdLevel level = simdLevel());
+
+/**
+ * @brief Ordena en memoria: std::sort por bloques que caben en caché y mezclas con mergeTwo
+ *
+ * @param data Datos a ordenar
+ * @param level Kernel a usar en las mezclas
+ */
+void simdSort(std::vector<int64_t>& data, SimdLevel level = simdLevel());
+
+/**
+ * @brief Mezcla k secuencias ordenadas con un heap de mínimos, elemento a elemento
+ *
+ * Es el ciclo de RunMerger sobre memoria. Se usa como referencia en los experimentos:
+ * vive en simdmerge.cpp para compilarse con las mismas banderas (-O2) que los kernels.
+ *
+ * @param runs Secuencias ordenadas
+ * @param out Recibe el resultado (se redimensiona)
+ */
+void heapMergeKWay(const std::vector<std::vector<int64_t>>& runs, std::vector<int64_t>& out);
+
+/**
+ * @brief std::sort sobre todo el vector, compilado junto a los kernels (referencia de simdSort)
+ *
+ * @param data Datos a ordenar
+ */
+void referenceSort(std::vector<int64_t>& data);
+
+#endif
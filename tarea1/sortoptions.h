@@ -0,0 +1,45 @@
+#ifndef SORTOPTIONS_H
+#define SORTOPTIONS_H
+
+#include "asyncio.h"
+#include "presort.h"
+#include "progress.h"
+#include "tempstorage.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct QuicksortStats;
+
+/**
+ * @brief Operador aplicado sobre el flujo ordenado mientras se produce la salida
+ */
+enum class SortOperator {
+    NONE,        ///< Salida ordenada sin cambios
+    DISTINCT,    ///< Elimina claves repetidas
+    GROUP_COUNT  ///< Escribe pares (clave, cantidad de apariciones)
+};
+
+/**
+ * @brief Opciones adicionales para externalMergeSort y externalQuickSort
+ *
+ * Los valores por defecto producen la misma salida que las versiones originales de ambos algoritmos.
+ */
+struct SortOptions {
+    SortOperator op = SortOperator::NONE;  ///< Operador aplicado en la última pasada
+    bool adaptive = true;                  ///< Detecta orden previo en la primera lectura y lo aprovecha
+    PresortInfo* presortInfo = nullptr;    ///< Si no es nulo, recibe el orden previo detectado
+    bool checkpoint = false;               ///< Mantiene un manifiesto en el directorio temporal y reanuda desde él
+    size_t stopAfterSteps = 0;             ///< Si es mayor que 0, se detiene tras ese número de checkpoints (pruebas)
+    std::vector<std::string> tempDirs;     ///< Raíces de los directorios temporales, idealmente una por disco (vacío: ".")
+    TempPlacement placement = TempPlacement::ROUND_ROBIN;  ///< Cómo se reparten los archivos entre tempDirs
+    QuicksortStats* quicksortStats = nullptr;  ///< Si no es nulo, recibe el resumen de particiones y hojas de Quicksort
+    bool reclaimSpace = false;             ///< MergeSort: libera el espacio de los runs ya mezclados durante cada pasada
+    AsyncIOOptions asyncIO;                ///< Con asyncIO.enabled las mezclas y particiones usan asyncio.h
+    AsyncIOReport* asyncReport = nullptr;  ///< Si no es nulo, acumula throughput y profundidad de cola de la I/O asíncrona
+    std::string tempNamespace;             ///< Sufijo del directorio temporal (temp_[aridad]_[sufijo]) para ordenamientos concurrentes
+    SortProgress* progress = nullptr;      ///< Si no es nulo, recibe los bytes procesados por fase (ver progress.h)
+    const CancellationToken* cancel = nullptr;  ///< Si no es nulo y se cancela, el ordenamiento se detiene en el siguiente bloque
+};
+
+#endif
@@ -0,0 +1,325 @@
+#include "sortservice.h"
+#include "mergesort.h"
+#include "quicksort.h"
+#include "constants.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <streambuf>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Buffer que descarta todo lo que recibe (para ServiceConfig::quiet)
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+const char* sortAlgorithmName(SortAlgorithm algorithm) {
+    return algorithm == SortAlgorithm::QUICKSORT ? "quicksort" : "mergesort";
+}
+
+/**
+ * @brief Crea el servicio
+ *
+ * @param config Parámetros de planificación
+ */
+SortService::SortService(const ServiceConfig& config) : config(config) {
+    if (this->config.tempRoots.empty()) {
+        this->config.tempRoots.push_back(".");
+    }
+    if (this->config.maxConcurrent == 0) {
+        this->config.maxConcurrent = 1;
+    }
+    for (const auto& root : this->config.tempRoots) {
+        inflightIO[root] = 0;
+    }
+}
+
+/**
+ * @brief Encola un trabajo
+ *
+ * @param job Trabajo a ejecutar
+ * @return size_t Identificador del trabajo
+ */
+size_t SortService::submit(const SortJob& job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t id = nextId++;
+    queues[job.queue].push_back({id, job, std::chrono::steady_clock::now()});
+    changed.notify_all();
+    return id;
+}
+
+/**
+ * @brief Memoria mínima con la que se admite un trabajo
+ *
+ * @param job Trabajo
+ * @return size_t (aridad + 1) bloques
+ */
+size_t SortService::minimumMemory(const SortJob& job) {
+    return (std::max<size_t>(job.arity, 2) + 1) * B;
+}
+
+/**
+ * @brief Bloques de I/O estimados de un trabajo
+ *
+ * @param job Trabajo
+ * @param memory Memoria concedida
+ * @return size_t 2 * bloques * (1 + ceil(log_aridad(tamaño / memoria)))
+ */
+size_t SortService::estimateIO(const SortJob& job, size_t memory) {
+    std::error_code error;
+    uintmax_t bytes = fs::file_size(job.input, error);
+    if (error || bytes == 0) {
+        return 0;
+    }
+
+    size_t blocks = (bytes + B - 1) / B;
+    double runs = std::ceil(static_cast<double>(bytes) / std::max<size_t>(memory, B));
+    size_t passes = 1;
+    if (runs > 1) {
+        passes += static_cast<size_t>(std::ceil(std::log(runs) / std::log(std::max<size_t>(job.arity, 2))));
+    }
+    return 2 * blocks * passes;
+}
+
+/**
+ * @brief Intenta admitir un trabajo pendiente (con mutex tomado)
+ *
+ * Recorre las colas por turnos a partir de la siguiente a la última atendida y
+ * admite la cabeza de la primera cola que cumpla las restricciones de memoria e I/O.
+ *
+ * @return true si se lanzó un trabajo
+ */
+bool SortService::admitNext() {
+    if (running >= config.maxConcurrent || queues.empty()) {
+        return false;
+    }
+
+    size_t pendingJobs = 0;
+    for (const auto& entry : queues) {
+        pendingJobs += entry.second.size();
+    }
+    if (pendingJobs == 0) {
+        return false;
+    }
+
+    // La memoria libre se reparte entre los trabajos que pueden empezar ahora
+    size_t freeMemory = config.memoryBudget > memoryInUse ? config.memoryBudget - memoryInUse : 0;
+    size_t slots = std::min(config.maxConcurrent - running, pendingJobs);
+    size_t share = freeMemory / slots;
+
+    // Turno: la primera cola después de la última atendida
+    auto start = queues.upper_bound(lastQueue);
+    std::vector<std::map<std::string, std::deque<Pending>>::iterator> order;
+    for (auto it = start; it != queues.end(); ++it) {
+        order.push_back(it);
+    }
+    for (auto it = queues.begin(); it != start; ++it) {
+        order.push_back(it);
+    }
+
+    for (auto it : order) {
+        if (it->second.empty()) {
+            continue;
+        }
+        const SortJob& job = it->second.front().job;
+
+        size_t minimum = minimumMemory(job);
+        size_t memory = job.memoryRequest > 0 ? std::min(job.memoryRequest, share) : share;
+        memory = std::max(memory, minimum);
+        if (memory > freeMemory) {
+            continue;
+        }
+
+        // Raíz temporal con menos I/O en curso
+        auto root = std::min_element(inflightIO.begin(), inflightIO.end(),
+                                     [](const auto& a, const auto& b) { return a.second < b.second; });
+        size_t estimate = estimateIO(job, memory);
+        if (config.maxInflightIO > 0 && root->second > 0 && root->second + estimate > config.maxInflightIO) {
+            continue;
+        }
+
+        Pending pending = std::move(it->second.front());
+        it->second.pop_front();
+        lastQueue = it->first;
+        if (it->second.empty()) {
+            queues.erase(it);
+        }
+
+        std::chrono::duration<double> wait = std::chrono::steady_clock::now() - pending.submitted;
+        memoryInUse += memory;
+        root->second += estimate;
+        running++;
+        workers.emplace_back(&SortService::execute, this, std::move(pending), memory, root->first, estimate,
+                             wait.count());
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Ejecuta un trabajo admitido (en su propio hilo) y libera sus recursos al terminar
+ *
+ * @param pending Trabajo
+ * @param memory Memoria concedida
+ * @param root Raíz temporal asignada
+ * @param estimate Bloques de I/O estimados
+ * @param waitSeconds Tiempo que pasó en cola
+ */
+void SortService::execute(Pending pending, size_t memory, std::string root, size_t estimate, double waitSeconds) {
+    JobResult result;
+    result.id = pending.id;
+    result.queue = pending.job.queue;
+    result.algorithm = pending.job.algorithm;
+    result.input = pending.job.input;
+    result.tempRoot = root;
+    result.memory = memory;
+    result.estimatedIO = estimate;
+    result.waitSeconds = waitSeconds;
+
+    SortOptions options = pending.job.options;
+    options.tempDirs = {root};
+    options.tempNamespace = "job" + std::to_string(pending.id);
+
+    IOStats stats;
+    auto startTime = std::chrono::steady_clock::now();
+    try {
+        if (!fs::exists(pending.job.input)) {
+            throw std::runtime_error("no existe " + pending.job.input);
+        }
+        if (pending.job.algorithm == SortAlgorithm::QUICKSORT) {
+            externalQuickSort(pending.job.input, pending.job.output, pending.job.arity, memory, stats, options);
+        } else {
+            externalMergeSort(pending.job.input, pending.job.output, pending.job.arity, memory, stats, options);
+        }
+        result.ok = fs::exists(pending.job.output);
+        if (!result.ok) {
+            result.error = "no se escribió " + pending.job.output;
+        }
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+    result.runSeconds = duration.count();
+    result.io = stats.total();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    memoryInUse -= memory;
+    inflightIO[root] -= estimate;
+    running--;
+    finished.push_back(std::move(result));
+    changed.notify_all();
+}
+
+/**
+ * @brief Ejecuta los trabajos encolados hasta que no quede ninguno pendiente ni en curso
+ */
+void SortService::run() {
+    NullBuffer nullBuffer;
+    std::streambuf* original = nullptr;
+    if (config.quiet) {
+        original = std::cout.rdbuf(&nullBuffer);
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.clear();
+        while (true) {
+            while (admitNext()) {
+            }
+            if (running == 0) {
+                if (queues.empty()) {
+                    break;
+                }
+                // Nada en curso y nada admisible: el trabajo no cabe en el presupuesto
+                for (auto& entry : queues) {
+                    for (auto& pending : entry.second) {
+                        JobResult result;
+                        result.id = pending.id;
+                        result.queue = pending.job.queue;
+                        result.algorithm = pending.job.algorithm;
+                        result.input = pending.job.input;
+                        result.error = "memoria insuficiente (mínimo " +
+                                       std::to_string(minimumMemory(pending.job)) + " bytes)";
+                        finished.push_back(std::move(result));
+                    }
+                }
+                queues.clear();
+                break;
+            }
+            changed.wait(lock);
+        }
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - startTime;
+    runSeconds = duration.count();
+
+    if (original) {
+        std::cout.rdbuf(original);
+    }
+}
+
+/**
+ * @brief Resultados de los trabajos terminados
+ */
+std::vector<JobResult> SortService::results() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return finished;
+}
+
+/**
+ * @brief Percentil por rango más cercano
+ *
+ * @param sorted Valores ordenados (no vacío)
+ * @param percentile Entre 0 y 100
+ */
+static double percentileOf(const std::vector<double>& sorted, double percentile) {
+    size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * sorted.size()));
+    return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+/**
+ * @brief Throughput y latencias de la última llamada a run()
+ */
+ServiceReport SortService::report() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    ServiceReport report;
+    report.seconds = runSeconds;
+
+    std::vector<double> latencies;
+    double waitSum = 0;
+    for (const auto& result : finished) {
+        report.jobs++;
+        report.io += result.io;
+        if (!result.ok) {
+            report.failed++;
+            continue;
+        }
+        latencies.push_back(result.latency());
+        waitSum += result.waitSeconds;
+    }
+
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        report.meanWait = waitSum / latencies.size();
+        report.p50 = percentileOf(latencies, 50);
+        report.p95 = percentileOf(latencies, 95);
+        report.p99 = percentileOf(latencies, 99);
+        report.maxLatency = latencies.back();
+    }
+    if (report.seconds > 0) {
+        report.jobsPerHour = (report.jobs - report.failed) * 3600.0 / report.seconds;
+    }
+    return report;
+}
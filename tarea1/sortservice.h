@@ -0,0 +1,176 @@
+#ifndef SORTSERVICE_H
+#define SORTSERVICE_H
+
+#include "iostats.h"
+#include "sortoptions.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Algoritmo con el que se ejecuta un trabajo
+ */
+enum class SortAlgorithm {
+    MERGESORT,  ///< externalMergeSort
+    QUICKSORT   ///< externalQuickSort
+};
+
+/**
+ * @brief Nombre legible de un algoritmo ("mergesort" / "quicksort")
+ */
+const char* sortAlgorithmName(SortAlgorithm algorithm);
+
+/**
+ * @brief Un ordenamiento pedido al servicio
+ */
+struct SortJob {
+    std::string queue = "default";                        ///< Cola a la que pertenece
+    SortAlgorithm algorithm = SortAlgorithm::MERGESORT;  ///< Algoritmo a usar
+    std::string input;                                    ///< Archivo a ordenar
+    std::string output;                                   ///< Archivo de salida
+    size_t arity = 57;                                    ///< Aridad del algoritmo
+    size_t memoryRequest = 0;                             ///< Memoria deseada en bytes (0: la parte que le toque)
+    SortOptions options;                                  ///< Opciones; el servicio fija tempDirs y tempNamespace
+};
+
+/**
+ * @brief Resultado de un trabajo terminado
+ */
+struct JobResult {
+    size_t id = 0;              ///< Identificador asignado por submit()
+    std::string queue;          ///< Cola del trabajo
+    SortAlgorithm algorithm = SortAlgorithm::MERGESORT;
+    std::string input;          ///< Archivo ordenado
+    std::string tempRoot;       ///< Raíz temporal asignada
+    size_t memory = 0;          ///< Memoria concedida en bytes
+    size_t estimatedIO = 0;     ///< Bloques de I/O estimados al admitirlo
+    size_t io = 0;              ///< Bloques de I/O realizados
+    double waitSeconds = 0;     ///< Tiempo en cola, desde submit() hasta la admisión
+    double runSeconds = 0;      ///< Tiempo de ejecución
+    bool ok = false;            ///< false si el ordenamiento falló
+    std::string error;          ///< Mensaje de error si falló
+
+    /** @brief Latencia total (espera + ejecución) */
+    double latency() const { return waitSeconds + runSeconds; }
+};
+
+/**
+ * @brief Parámetros del servicio
+ */
+struct ServiceConfig {
+    size_t memoryBudget = 256 * 1024 * 1024;  ///< Memoria total a repartir entre los trabajos activos
+    size_t maxConcurrent = 4;                 ///< Máximo de trabajos ejecutándose a la vez
+    size_t maxInflightIO = 0;                 ///< Máximo de bloques de I/O estimados en curso por raíz temporal (0: sin límite)
+    std::vector<std::string> tempRoots;       ///< Raíces temporales, idealmente una por disco (vacío: ".")
+    bool quiet = true;                        ///< Silencia la salida de los algoritmos mientras corre run()
+};
+
+/**
+ * @brief Resumen de una ejecución del servicio
+ */
+struct ServiceReport {
+    size_t jobs = 0;           ///< Trabajos terminados
+    size_t failed = 0;         ///< Trabajos que fallaron
+    double seconds = 0;        ///< Duración de run()
+    double jobsPerHour = 0;    ///< Throughput
+    double meanWait = 0;       ///< Espera promedio en cola (s)
+    double p50 = 0;            ///< Latencia mediana (s)
+    double p95 = 0;            ///< Latencia percentil 95 (s)
+    double p99 = 0;            ///< Latencia percentil 99 (s)
+    double maxLatency = 0;     ///< Latencia máxima (s)
+    size_t io = 0;             ///< Bloques de I/O de todos los trabajos
+};
+
+/**
+ * @brief Planificador de ordenamientos externos por lotes
+ *
+ * Recibe trabajos en colas con nombre y los ejecuta con externalMergeSort o
+ * externalQuickSort, cada uno en su propio hilo:
+ *   - Las colas se atienden por turnos, para que una cola larga no bloquee a las demás.
+ *   - La memoria libre del presupuesto se reparte entre los trabajos que pueden
+ *     empezar; un trabajo no se admite si su parte no alcanza su mínimo.
+ *   - Cada trabajo usa un directorio temporal propio (SortOptions::tempNamespace),
+ *     así que trabajos con la misma aridad no comparten archivos.
+ *   - Admisión según I/O: cada trabajo se asigna a la raíz temporal con menos I/O
+ *     estimada en curso, y con maxInflightIO no se admite si esa raíz ya tiene
+ *     trabajos y la suma superaría el límite.
+ *
+ * @note Los algoritmos reciben su memoria como memoryLimit; el servicio confía en
+ *       que lo respetan
+ */
+class SortService {
+public:
+    /**
+     * @brief Crea el servicio
+     * @param config Parámetros de planificación
+     */
+    explicit SortService(const ServiceConfig& config);
+
+    /**
+     * @brief Encola un trabajo (se puede llamar desde otro hilo durante run())
+     *
+     * @param job Trabajo a ejecutar
+     * @return size_t Identificador del trabajo
+     */
+    size_t submit(const SortJob& job);
+
+    /**
+     * @brief Ejecuta los trabajos encolados y vuelve cuando no queda ninguno pendiente ni en curso
+     */
+    void run();
+
+    /** @brief Resultados de los trabajos terminados, en orden de término */
+    std::vector<JobResult> results() const;
+
+    /** @brief Throughput y latencias de la última llamada a run() */
+    ServiceReport report() const;
+
+    /**
+     * @brief Memoria mínima con la que se admite un trabajo
+     *
+     * @param job Trabajo
+     * @return size_t Bytes: un buffer de B por vía más el de salida
+     */
+    static size_t minimumMemory(const SortJob& job);
+
+    /**
+     * @brief Bloques de I/O estimados de un trabajo
+     *
+     * @param job Trabajo
+     * @param memory Memoria concedida
+     * @return size_t Lectura y escritura de la entrada por cada pasada:
+     *         1 + ceil(log_aridad(tamaño / memoria))
+     */
+    static size_t estimateIO(const SortJob& job, size_t memory);
+
+private:
+    struct Pending {
+        size_t id;
+        SortJob job;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    bool admitNext();
+    void execute(Pending pending, size_t memory, std::string root, size_t estimate, double waitSeconds);
+
+    ServiceConfig config;
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    std::map<std::string, std::deque<Pending>> queues;
+    std::string lastQueue;
+    std::map<std::string, size_t> inflightIO;
+    std::vector<std::thread> workers;
+    std::vector<JobResult> finished;
+    size_t nextId = 0;
+    size_t running = 0;
+    size_t memoryInUse = 0;
+    double runSeconds = 0;
+};
+
+#endif
@@ -0,0 +1,227 @@
+#include "streamsort.h"
+#include "simdmerge.h"
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Elimina un directorio temporal y todo su contenido, si existe
+ *
+ * @param tempDir Directorio a eliminar
+ */
+static void removeTempDir(const std::string& tempDir) {
+    if (tempDir.empty() || !fs::exists(tempDir)) return;
+
+    for (const auto& entry : fs::directory_iterator(tempDir)) {
+        fs::remove(entry.path());
+    }
+    fs::remove(tempDir);
+}
+
+SortedStream::SortedStream(SortedStream&& other) noexcept
+    : merger(std::move(other.merger)), memoryRun(std::move(other.memoryRun)),
+      memoryPos(other.memoryPos), tempDir(std::move(other.tempDir)) {
+    other.tempDir.clear();
+}
+
+SortedStream& SortedStream::operator=(SortedStream&& other) noexcept {
+    if (this != &other) {
+        merger.reset();
+        removeTempDir(tempDir);
+
+        merger = std::move(other.merger);
+        memoryRun = std::move(other.memoryRun);
+        memoryPos = other.memoryPos;
+        tempDir = std::move(other.tempDir);
+        other.tempDir.clear();
+    }
+    return *this;
+}
+
+/**
+ * @brief Cierra los runs abiertos y elimina el directorio temporal
+ */
+SortedStream::~SortedStream() {
+    merger.reset();
+    removeTempDir(tempDir);
+}
+
+/**
+ * @brief Extrae el siguiente elemento en orden ascendente
+ *
+ * @param value Variable donde se deja el elemento extraído
+ * @return true si se extrajo un elemento, false si el flujo terminó
+ */
+bool SortedStream::next(int64_t& value) {
+    if (merger) {
+        return merger->next(value);
+    }
+
+    if (memoryPos < memoryRun.size()) {
+        value = memoryRun[memoryPos++];
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Extrae hasta `count` elementos consecutivos
+ *
+ * @param buffer Vector donde se dejan los elementos (se sobrescribe)
+ * @param count Número máximo de elementos a extraer
+ * @return size_t Número de elementos extraídos
+ */
+size_t SortedStream::nextBatch(std::vector<int64_t>& buffer, size_t count) {
+    buffer.clear();
+
+    if (!merger) {
+        size_t available = std::min(count, memoryRun.size() - memoryPos);
+        buffer.assign(memoryRun.begin() + memoryPos, memoryRun.begin() + memoryPos + available);
+        memoryPos += available;
+        return available;
+    }
+
+    int64_t value;
+    while (buffer.size() < count && merger->next(value)) {
+        buffer.push_back(value);
+    }
+    return buffer.size();
+}
+
+/**
+ * @brief Crea un sorter vacío con su propio directorio temporal
+ *
+ * @param arity Número de runs a mezclar simultáneamente
+ * @param memoryLimit Límite de memoria en bytes
+ * @param stats Objeto para registrar estadísticas de I/O
+ *
+ * @note El nombre del directorio incluye el pid y un contador, así dos sorters
+ *       con la misma aridad no comparten archivos temporales
+ */
+StreamingSorter::StreamingSorter(size_t arity, size_t memoryLimit, IOStats& stats)
+    : arity(arity < 2 ? 2 : arity),
+      numbersInMemory(std::max<size_t>(1, memoryLimit / sizeof(int64_t))),
+      memoryLimit(memoryLimit),
+      stats(stats) {
+    static std::atomic<size_t> nextId{0};
+    tempDir = "./temp_stream_" + std::to_string(this->arity) + "_" +
+              std::to_string(getpid()) + "_" + std::to_string(nextId++);
+    buffer.reserve(numbersInMemory);
+}
+
+/**
+ * @brief Elimina los runs si finish() nunca se llamó
+ */
+StreamingSorter::~StreamingSorter() {
+    if (!finished) {
+        removeTempDir(tempDir);
+    }
+}
+
+/**
+ * @brief Agrega un tramo contiguo de registros
+ *
+ * @param data Puntero al primer registro
+ * @param count Cantidad de registros
+ */
+void StreamingSorter::add(const int64_t* data, size_t count) {
+    if (finished) {
+        std::cerr << "Error: StreamingSorter::add llamado después de finish()" << std::endl;
+        return;
+    }
+
+    while (count > 0) {
+        size_t space = numbersInMemory - buffer.size();
+        size_t toCopy = std::min(space, count);
+        buffer.insert(buffer.end(), data, data + toCopy);
+        data += toCopy;
+        count -= toCopy;
+
+        if (buffer.size() >= numbersInMemory) {
+            spillRun();
+        }
+    }
+}
+
+/**
+ * @brief Agrega todos los registros de un vector
+ *
+ * @param data Registros a agregar
+ */
+void StreamingSorter::add(const std::vector<int64_t>& data) {
+    add(data.data(), data.size());
+}
+
+/**
+ * @brief Ordena el buffer actual y lo escribe como un nuevo run
+ */
+void StreamingSorter::spillRun() {
+    if (buffer.empty()) return;
+
+    if (!fs::exists(tempDir)) {
+        fs::create_directories(tempDir);
+    }
+
+    simdSort(buffer);
+
+    std::string runFilename = tempDir + "/run_" + std::to_string(runFiles.size()) + ".bin";
+    std::ofstream runFile(runFilename, std::ios::binary);
+    writeBlock(runFile, buffer, stats);
+    runFile.close();
+
+    runFiles.push_back(runFilename);
+    buffer.clear();
+}
+
+/**
+ * @brief Termina la fase de entrada y entrega el flujo ordenado
+ *
+ * @return SortedStream Iterador que realiza la mezcla final en forma perezosa
+ *
+ * @note Si nunca se escribió un run, los datos se ordenan en memoria y no hay I/O
+ * @note En otro caso el resto del buffer se escribe como run y se aplican pasadas
+ *       de mezcla hasta dejar a lo más `arity` runs para la mezcla final
+ */
+SortedStream StreamingSorter::finish() {
+    SortedStream stream;
+    if (finished) {
+        std::cerr << "Error: StreamingSorter::finish llamado dos veces" << std::endl;
+        return stream;
+    }
+    finished = true;
+
+    if (runFiles.empty()) {
+        simdSort(buffer);
+        stream.memoryRun = std::move(buffer);
+        return stream;
+    }
+
+    spillRun();
+    buffer.clear();
+    buffer.shrink_to_fit();
+
+    size_t bufferSize = (memoryLimit / (arity + 1)) / sizeof(int64_t);
+    if (bufferSize < 1) bufferSize = 1;
+
+    TempStorage storage({tempDir}, TempPlacement::ROUND_ROBIN, stats);
+    size_t pass = 0;
+    while (runFiles.size() > arity) {
+        std::vector<std::string> merged = mergePass(runFiles, storage, pass++, arity, bufferSize, stats);
+        std::swap(runFiles, merged);
+
+        // Las entradas de la pasada ya están en sus salidas: se borran para no acumular una copia por pasada
+        for (const auto& file : merged) {
+            fs::remove(file);
+        }
+    }
+
+    // La mezcla final tiene a lo más `arity` entradas: el buffer de salida no se usa
+    size_t finalBufferSize = std::max<size_t>(1, (memoryLimit / runFiles.size()) / sizeof(int64_t));
+    stream.merger = std::make_unique<RunMerger>(runFiles, finalBufferSize, stats);
+    stream.tempDir = tempDir;
+    return stream;
+}
@@ -0,0 +1,124 @@
+#ifndef STREAMSORT_H
+#define STREAMSORT_H
+
+#include "iostats.h"
+#include "mergesort.h"
+#include <string>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Iterador de extracción (pull) sobre el resultado de un StreamingSorter
+ *
+ * Realiza la mezcla final de forma perezosa: cada bloque de los runs se lee
+ * recién cuando el consumidor lo necesita, sin escribir el resultado a disco.
+ * Si todos los datos cupieron en memoria, entrega directamente el buffer ordenado.
+ *
+ * @note Es dueño del directorio temporal del sorter y lo elimina al destruirse
+ */
+class SortedStream {
+public:
+    SortedStream(SortedStream&& other) noexcept;
+    SortedStream& operator=(SortedStream&& other) noexcept;
+    SortedStream(const SortedStream&) = delete;
+    SortedStream& operator=(const SortedStream&) = delete;
+    ~SortedStream();
+
+    /**
+     * @brief Extrae el siguiente elemento en orden ascendente
+     *
+     * @param value Variable donde se deja el elemento extraído
+     * @return true si se extrajo un elemento, false si el flujo terminó
+     */
+    bool next(int64_t& value);
+
+    /**
+     * @brief Extrae hasta `count` elementos consecutivos
+     *
+     * @param buffer Vector donde se dejan los elementos (se sobrescribe)
+     * @param count Número máximo de elementos a extraer
+     * @return size_t Número de elementos extraídos (0 al terminar el flujo)
+     */
+    size_t nextBatch(std::vector<int64_t>& buffer, size_t count);
+
+private:
+    friend class StreamingSorter;
+    SortedStream() = default;
+
+    std::unique_ptr<RunMerger> merger;  ///< Mezcla perezosa de runs en disco
+    std::vector<int64_t> memoryRun;     ///< Datos ordenados cuando no hubo runs en disco
+    size_t memoryPos = 0;
+    std::string tempDir;                ///< Directorio a eliminar al destruirse
+};
+
+/**
+ * @brief Ordenamiento externo por flujo: se empujan registros y se extraen ordenados
+ *
+ * Los datos se acumulan en un buffer de `memoryLimit` bytes; cada vez que se llena
+ * se ordena y se escribe como un run en disco. finish() reduce los runs con pasadas
+ * de mezcla hasta que queden a lo más `arity` y devuelve un SortedStream que hace
+ * la última mezcla a medida que se consume.
+ *
+ * @warning Crea archivos temporales en el directorio ./temp_stream_[arity]_[pid]_[id]
+ */
+class StreamingSorter {
+public:
+    /**
+     * @brief Crea un sorter vacío
+     *
+     * @param arity Número de runs a mezclar simultáneamente
+     * @param memoryLimit Límite de memoria en bytes
+     * @param stats Objeto para registrar estadísticas de I/O
+     */
+    StreamingSorter(size_t arity, size_t memoryLimit, IOStats& stats);
+    StreamingSorter(const StreamingSorter&) = delete;
+    StreamingSorter& operator=(const StreamingSorter&) = delete;
+    ~StreamingSorter();
+
+    /**
+     * @brief Agrega un tramo contiguo de registros
+     *
+     * @param data Puntero al primer registro
+     * @param count Cantidad de registros
+     *
+     * @note Puede escribir uno o más runs a disco si el buffer se llena
+     */
+    void add(const int64_t* data, size_t count);
+
+    /**
+     * @brief Agrega todos los registros de un vector
+     * @param data Registros a agregar
+     */
+    void add(const std::vector<int64_t>& data);
+
+    /**
+     * @brief Termina la fase de entrada y entrega el flujo ordenado
+     *
+     * @return SortedStream Iterador que realiza la mezcla final en forma perezosa
+     *
+     * @warning Después de llamar a finish() el sorter no acepta más registros
+     */
+    SortedStream finish();
+
+    /**
+     * @brief Cantidad de runs escritos a disco hasta el momento
+     */
+    size_t runCount() const { return runFiles.size(); }
+
+private:
+    /**
+     * @brief Ordena el buffer actual y lo escribe como un nuevo run
+     */
+    void spillRun();
+
+    size_t arity;
+    size_t numbersInMemory;
+    size_t memoryLimit;
+    IOStats& stats;
+    std::string tempDir;
+    std::vector<int64_t> buffer;
+    std::vector<std::string> runFiles;
+    bool finished = false;
+};
+
+#endif
@@ -0,0 +1,214 @@
+#include "tempstorage.h"
+#include <algorithm>
+#include <iostream>
+#include <filesystem>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/falloc.h>
+#endif
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Crea (si no existen) los directorios y los registra en stats
+ *
+ * @param directories Directorios temporales; el primero es el principal
+ * @param placement Política de ubicación de archivos
+ * @param stats Objeto donde se registran los dispositivos
+ */
+TempStorage::TempStorage(const std::vector<std::string>& directories, TempPlacement placement, IOStats& stats)
+    : directories(directories), placement(placement), stats(stats) {
+    if (this->directories.empty()) {
+        this->directories.push_back("./temp");
+    }
+    for (const auto& directory : this->directories) {
+        if (!fs::exists(directory)) {
+            fs::create_directories(directory);
+        }
+        stats.addDevice(directory);
+    }
+}
+
+/**
+ * @brief Directorios temporales de un ordenamiento: [raíz]/[name] para cada raíz
+ *
+ * @param roots Directorios base (vacío equivale a ".")
+ * @param name Nombre del directorio del ordenamiento
+ * @return std::vector<std::string> Un directorio por raíz
+ */
+std::vector<std::string> TempStorage::directoriesFor(const std::vector<std::string>& roots, const std::string& name) {
+    std::vector<std::string> directories;
+    for (const auto& root : roots) {
+        directories.push_back(root + "/" + name);
+    }
+    if (directories.empty()) {
+        directories.push_back("./" + name);
+    }
+    return directories;
+}
+
+/**
+ * @brief Elige un directorio entre los candidatos según la política
+ *
+ * @param candidates Índices de directorios elegibles (no vacío)
+ * @return size_t Índice elegido
+ */
+size_t TempStorage::choose(const std::vector<size_t>& candidates) {
+    if (placement == TempPlacement::FREE_SPACE) {
+        size_t best = candidates.front();
+        uintmax_t bestSpace = 0;
+        for (size_t candidate : candidates) {
+            std::error_code error;
+            uintmax_t space = fs::space(directories[candidate], error).available;
+            if (!error && space > bestSpace) {
+                best = candidate;
+                bestSpace = space;
+            }
+        }
+        return best;
+    }
+
+    // Por turnos: el primer candidato a partir del siguiente turno
+    for (size_t offset = 0; offset < directories.size(); ++offset) {
+        size_t index = (nextDirectory + offset) % directories.size();
+        if (std::find(candidates.begin(), candidates.end(), index) != candidates.end()) {
+            nextDirectory = index + 1;
+            return index;
+        }
+    }
+    return candidates.front();
+}
+
+/**
+ * @brief Elige la ruta de un archivo nuevo según la política
+ *
+ * @param filename Nombre del archivo (sin directorio)
+ * @return std::string Ruta completa
+ */
+std::string TempStorage::place(const std::string& filename) {
+    std::vector<size_t> candidates(directories.size());
+    for (size_t i = 0; i < directories.size(); ++i) {
+        candidates[i] = i;
+    }
+    return directories[choose(candidates)] + "/" + filename;
+}
+
+/**
+ * @brief Elige la ruta de un archivo que se escribirá mientras se leen otros
+ *
+ * @param filename Nombre del archivo (sin directorio)
+ * @param inputs Archivos que se leerán mientras se escribe este
+ * @return std::string Ruta completa en el directorio con menos entradas
+ */
+std::string TempStorage::placeAwayFrom(const std::string& filename, const std::vector<std::string>& inputs) {
+    std::vector<size_t> inputsPerDirectory(directories.size(), 0);
+    for (const auto& input : inputs) {
+        for (size_t i = 0; i < directories.size(); ++i) {
+            const std::string& directory = directories[i];
+            if (input.size() > directory.size() && input.compare(0, directory.size(), directory) == 0 &&
+                input[directory.size()] == '/') {
+                inputsPerDirectory[i]++;
+                break;
+            }
+        }
+    }
+
+    size_t fewest = *std::min_element(inputsPerDirectory.begin(), inputsPerDirectory.end());
+    std::vector<size_t> candidates;
+    for (size_t i = 0; i < directories.size(); ++i) {
+        if (inputsPerDirectory[i] == fewest) candidates.push_back(i);
+    }
+    return directories[choose(candidates)] + "/" + filename;
+}
+
+/**
+ * @brief Busca un archivo ya existente en cualquiera de los directorios
+ *
+ * @param filename Nombre del archivo (sin directorio)
+ * @return std::string Ruta del archivo, o "" si no existe en ninguno
+ */
+std::string TempStorage::find(const std::string& filename) const {
+    for (const auto& directory : directories) {
+        std::string path = directory + "/" + filename;
+        if (fs::exists(path)) return path;
+    }
+    return "";
+}
+
+/**
+ * @brief Elimina todos los directorios y su contenido
+ */
+void TempStorage::remove() {
+    for (const auto& directory : directories) {
+        if (!fs::exists(directory)) continue;
+
+        for (const auto& entry : fs::directory_iterator(directory)) {
+            fs::remove(entry.path());
+        }
+        fs::remove(directory);
+    }
+}
+
+/**
+ * @brief Bytes ocupados en disco por los archivos de todos los directorios
+ *
+ * @return uintmax_t Suma de los bloques asignados de cada archivo
+ */
+uintmax_t TempStorage::allocated() const {
+    uintmax_t bytes = 0;
+    for (const auto& directory : directories) {
+        std::error_code error;
+        for (const auto& entry : fs::directory_iterator(directory, error)) {
+            struct stat info;
+            if (::stat(entry.path().c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+                bytes += static_cast<uintmax_t>(info.st_blocks) * 512;
+            }
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief Mide el espacio ocupado y actualiza el máximo en stats
+ */
+void TempStorage::sampleUsage() {
+    stats.peakTempBytes = std::max(stats.peakTempBytes, allocated());
+}
+
+/**
+ * @brief Libera los bloques de un rango ya consumido de un archivo
+ *
+ * @param fd Descriptor abierto para escritura
+ * @param offset Inicio del rango en bytes
+ * @param length Largo del rango en bytes
+ * @return true si el rango se liberó
+ */
+bool TempStorage::releaseRange(int fd, uintmax_t offset, uintmax_t length) {
+#ifdef FALLOC_FL_PUNCH_HOLE
+    if (fd < 0 || length == 0) return false;
+    return ::fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset),
+                       static_cast<off_t>(length)) == 0;
+#else
+    (void)fd;
+    (void)offset;
+    (void)length;
+    return false;
+#endif
+}
+
+/**
+ * @brief Imprime las operaciones y el ancho de banda de cada directorio
+ */
+void TempStorage::report() const {
+    if (directories.size() < 2) return;
+
+    for (const auto& directory : directories) {
+        int device = stats.deviceOf(directory + "/");
+        if (device < 0) continue;
+
+        const DeviceStats& io = stats.devices[device];
+        std::cout << "  " << io.directory << ": " << io.reads << " lecturas, " << io.writes
+                  << " escrituras, " << io.bandwidth() << " MB/s" << std::endl;
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef TEMPSTORAGE_H
+#define TEMPSTORAGE_H
+
+#include "iostats.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Política para elegir en qué directorio temporal se crea cada archivo
+ */
+enum class TempPlacement {
+    ROUND_ROBIN,  ///< Los directorios se usan por turnos
+    FREE_SPACE    ///< Se elige el directorio con más espacio libre
+};
+
+/**
+ * @brief Conjunto de directorios temporales de un ordenamiento, normalmente uno por disco
+ *
+ * Reparte los archivos temporales (runs, particiones, resultados de mezcla) entre
+ * los directorios según la política elegida, de modo que las lecturas y escrituras
+ * no compitan por un único dispositivo. Cada directorio se registra en
+ * IOStats::devices para desglosar las operaciones y el ancho de banda.
+ *
+ * @note Los directorios se crean en el constructor y solo se eliminan con remove()
+ *       (un ordenamiento interrumpido debe poder dejar su estado en disco)
+ */
+class TempStorage {
+public:
+    /**
+     * @brief Crea (si no existen) los directorios y los registra en stats
+     *
+     * @param directories Directorios temporales; el primero es el principal
+     * @param placement Política de ubicación de archivos
+     * @param stats Objeto donde se registran los dispositivos
+     */
+    TempStorage(const std::vector<std::string>& directories, TempPlacement placement, IOStats& stats);
+
+    /**
+     * @brief Directorios temporales de un ordenamiento: [raíz]/[name] para cada raíz
+     *
+     * @param roots Directorios base (vacío equivale a ".")
+     * @param name Nombre del directorio del ordenamiento, p. ej. "temp_57"
+     * @return std::vector<std::string> Un directorio por raíz
+     */
+    static std::vector<std::string> directoriesFor(const std::vector<std::string>& roots, const std::string& name);
+
+    /** @brief Directorio principal (donde se guardan el manifiesto y archivos únicos) */
+    const std::string& primary() const { return directories.front(); }
+
+    /** @brief Todos los directorios */
+    const std::vector<std::string>& all() const { return directories; }
+
+    /**
+     * @brief Elige la ruta de un archivo nuevo según la política
+     *
+     * @param filename Nombre del archivo (sin directorio)
+     * @return std::string Ruta completa
+     */
+    std::string place(const std::string& filename);
+
+    /**
+     * @brief Elige la ruta de un archivo que se escribirá mientras se leen otros
+     *
+     * Prefiere el directorio que contiene menos de los archivos de entrada, para que
+     * la salida no compita con ellos por el mismo dispositivo; los empates se
+     * resuelven con la política de ubicación.
+     *
+     * @param filename Nombre del archivo (sin directorio)
+     * @param inputs Archivos que se leerán mientras se escribe este
+     * @return std::string Ruta completa
+     */
+    std::string placeAwayFrom(const std::string& filename, const std::vector<std::string>& inputs);
+
+    /**
+     * @brief Busca un archivo ya existente en cualquiera de los directorios
+     *
+     * @param filename Nombre del archivo (sin directorio)
+     * @return std::string Ruta del archivo, o "" si no existe en ninguno
+     *
+     * @note Al reanudar desde un checkpoint los archivos no necesariamente están
+     *       donde los pondría la política ahora
+     */
+    std::string find(const std::string& filename) const;
+
+    /**
+     * @brief Elimina todos los directorios y su contenido
+     */
+    void remove();
+
+    /**
+     * @brief Bytes ocupados en disco por los archivos de todos los directorios
+     *
+     * @note Cuenta los bloques asignados (st_blocks), así que los huecos
+     *       liberados con releaseRange no suman
+     */
+    uintmax_t allocated() const;
+
+    /**
+     * @brief Mide allocated() y actualiza IOStats::peakTempBytes si es mayor
+     */
+    void sampleUsage();
+
+    /**
+     * @brief Libera los bloques de un rango ya consumido de un archivo (fallocate PUNCH_HOLE)
+     *
+     * @param fd Descriptor abierto para escritura
+     * @param offset Inicio del rango en bytes
+     * @param length Largo del rango en bytes
+     * @return true si el sistema de archivos liberó el rango
+     *
+     * @note El tamaño del archivo no cambia y el rango se lee como ceros; fuera de
+     *       Linux, o si el sistema de archivos no lo soporta, devuelve false
+     */
+    static bool releaseRange(int fd, uintmax_t offset, uintmax_t length);
+
+    /**
+     * @brief Imprime las operaciones y el ancho de banda de cada directorio
+     *
+     * @note No imprime nada si hay un solo directorio
+     */
+    void report() const;
+
+private:
+    size_t choose(const std::vector<size_t>& candidates);
+
+    std::vector<std::string> directories;
+    TempPlacement placement;
+    IOStats& stats;
+    size_t nextDirectory = 0;
+};
+
+#endif
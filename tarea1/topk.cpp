@@ -0,0 +1,277 @@
+#include "topk.h"
+#include "quicksort.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <limits>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief Obtiene los k elementos más pequeños de un archivo en una sola pasada
+ *
+ * @param inputFilename Archivo de entrada
+ * @param k Cantidad de elementos a obtener
+ * @param memoryLimit Límite de memoria en bytes
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return std::vector<int64_t> Los k menores elementos en orden ascendente
+ *
+ * @note Cada bloque leído se compara contra el máximo del heap, de modo que
+ *       solo los candidatos reales pagan la operación de inserción
+ */
+std::vector<int64_t> externalTopK(const std::string& inputFilename,
+                                  size_t k,
+                                  size_t memoryLimit,
+                                  IOStats& stats) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    stats.reset();
+
+    if (k == 0) return {};
+    if (k * sizeof(int64_t) >= memoryLimit) {
+        std::cerr << "Error: k = " << k << " no cabe en memoria, usar externalPartialSort" << std::endl;
+        return {};
+    }
+
+    std::ifstream inputFile(inputFilename, std::ios::binary);
+    if (!inputFile) {
+        std::cerr << "Error al abrir archivo para top-k: " << inputFilename << std::endl;
+        return {};
+    }
+
+    // La memoria que no ocupa el heap se usa como buffer de lectura
+    size_t bufferSize = (memoryLimit - k * sizeof(int64_t)) / sizeof(int64_t);
+    if (bufferSize < b) bufferSize = b;
+
+    std::priority_queue<int64_t> maxHeap;
+    std::vector<int64_t> buffer;
+
+    while (true) {
+        size_t itemsRead = readBlock(inputFile, buffer, bufferSize, stats);
+        if (itemsRead == 0) break;
+
+        for (int64_t value : buffer) {
+            if (maxHeap.size() < k) {
+                maxHeap.push(value);
+            } else if (value < maxHeap.top()) {
+                maxHeap.pop();
+                maxHeap.push(value);
+            }
+        }
+    }
+    inputFile.close();
+
+    std::vector<int64_t> result(maxHeap.size());
+    for (size_t i = result.size(); i > 0; --i) {
+        result[i - 1] = maxHeap.top();
+        maxHeap.pop();
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = endTime - startTime;
+
+    std::cout << "Top-" << k << " completado en " << duration.count() << " segundos" << std::endl;
+    std::cout << "Total operaciones I/O: " << stats.total() << std::endl;
+
+    return result;
+}
+
+/**
+ * @brief Entrega ordenados los elementos cuyos rangos están en [lo, hi)
+ *
+ * @param inputFilename Archivo (o partición) a procesar
+ * @param lo Primer rango pedido, relativo a este archivo
+ * @param hi Rango siguiente al último pedido, relativo a este archivo
+ * @param arity Número de particiones a crear en cada paso
+ * @param memoryLimit Límite de memoria en bytes
+ * @param tempDir Directorio para archivos temporales
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param emit Función que recibe, en orden, los bloques del resultado
+ *
+ * @note Las particiones que no se solapan con [lo, hi) se descartan sin leerlas
+ * @note Si los pivotes no logran dividir el archivo (por ejemplo, con muchas
+ *       claves repetidas) se particiona en dos usando el máximo como pivote
+ */
+static void rankRangeRecursive(const std::string& inputFilename,
+                               size_t lo,
+                               size_t hi,
+                               size_t arity,
+                               size_t memoryLimit,
+                               const std::string& tempDir,
+                               IOStats& stats,
+                               const std::function<void(const std::vector<int64_t>&)>& emit) {
+    size_t fileSize = fs::file_size(inputFilename);
+    size_t numNumbers = fileSize / sizeof(int64_t);
+    hi = std::min(hi, numNumbers);
+    if (lo >= hi) return;
+
+    // Caso base: el archivo cabe en memoria
+    if (fileSize <= memoryLimit) {
+        std::ifstream inputFile(inputFilename, std::ios::binary);
+        std::vector<int64_t> buffer;
+        readBlock(inputFile, buffer, numNumbers, stats);
+        inputFile.close();
+
+        std::nth_element(buffer.begin(), buffer.begin() + lo, buffer.end());
+        std::partial_sort(buffer.begin() + lo, buffer.begin() + hi, buffer.end());
+
+        emit(std::vector<int64_t>(buffer.begin() + lo, buffer.begin() + hi));
+        return;
+    }
+
+    std::vector<int64_t> pivots = selectPivots(inputFilename, arity - 1, stats);
+
+    std::vector<std::string> partitionFiles;
+    for (size_t i = 0; i <= pivots.size(); ++i) {
+        partitionFiles.push_back(tempDir + "/partition_" + std::to_string(i) + "_" +
+                                 fs::path(inputFilename).filename().string());
+    }
+    partition(inputFilename, partitionFiles, pivots, memoryLimit, stats);
+
+    // Si una partición recibió todo el archivo, los pivotes no sirvieron
+    for (size_t i = 0; i < partitionFiles.size(); ++i) {
+        if (fs::file_size(partitionFiles[i]) != fileSize) continue;
+
+        for (const auto& file : partitionFiles) fs::remove(file);
+
+        std::ifstream inputFile(inputFilename, std::ios::binary);
+        std::vector<int64_t> buffer;
+        int64_t minValue = std::numeric_limits<int64_t>::max();
+        int64_t maxValue = std::numeric_limits<int64_t>::min();
+        while (readBlock(inputFile, buffer, memoryLimit / sizeof(int64_t), stats) > 0) {
+            auto bounds = std::minmax_element(buffer.begin(), buffer.end());
+            minValue = std::min(minValue, *bounds.first);
+            maxValue = std::max(maxValue, *bounds.second);
+        }
+        inputFile.close();
+
+        if (minValue == maxValue) {
+            // Todas las claves son iguales: el resultado es la misma clave repetida
+            for (size_t pos = lo; pos < hi; pos += memoryLimit / sizeof(int64_t)) {
+                size_t count = std::min(hi - pos, memoryLimit / sizeof(int64_t));
+                emit(std::vector<int64_t>(count, minValue));
+            }
+            return;
+        }
+
+        pivots = {maxValue};
+        partitionFiles.resize(2);
+        partition(inputFilename, partitionFiles, pivots, memoryLimit, stats);
+        break;
+    }
+
+    // Recursar solo en las particiones que se solapan con [lo, hi)
+    size_t offset = 0;
+    for (const auto& partitionFile : partitionFiles) {
+        size_t count = fs::file_size(partitionFile) / sizeof(int64_t);
+
+        if (count > 0 && offset < hi && offset + count > lo) {
+            size_t subLo = lo > offset ? lo - offset : 0;
+            size_t subHi = std::min(hi - offset, count);
+            rankRangeRecursive(partitionFile, subLo, subHi, arity, memoryLimit, tempDir, stats, emit);
+        }
+
+        fs::remove(partitionFile);
+        offset += count;
+    }
+}
+
+/**
+ * @brief Crea el directorio temporal, ejecuta la búsqueda por rangos y lo elimina
+ *
+ * @param inputFilename Archivo de entrada
+ * @param lo Primer rango pedido
+ * @param hi Rango siguiente al último pedido
+ * @param arity Número de particiones a crear en cada paso
+ * @param memoryLimit Límite de memoria en bytes
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @param emit Función que recibe, en orden, los bloques del resultado
+ */
+static void externalRankRange(const std::string& inputFilename,
+                              size_t lo,
+                              size_t hi,
+                              size_t arity,
+                              size_t memoryLimit,
+                              IOStats& stats,
+                              const std::function<void(const std::vector<int64_t>&)>& emit) {
+    std::string tempDir = "./temp_topk_" + std::to_string(arity);
+    if (!fs::exists(tempDir)) {
+        fs::create_directories(tempDir);
+    }
+
+    rankRangeRecursive(inputFilename, lo, hi, arity, memoryLimit, tempDir, stats, emit);
+
+    for (const auto& entry : fs::directory_iterator(tempDir)) {
+        fs::remove(entry.path());
+    }
+    fs::remove(tempDir);
+}
+
+/**
+ * @brief Escribe ordenados los k elementos más pequeños de un archivo
+ *
+ * @param inputFilename Archivo de entrada
+ * @param outputFilename Archivo de salida con los k menores elementos ordenados
+ * @param k Cantidad de elementos a obtener
+ * @param arity Número de particiones a crear en cada paso
+ * @param memoryLimit Límite de memoria en bytes
+ * @param stats Objeto para registrar estadísticas de I/O
+ */
+void externalPartialSort(const std::string& inputFilename,
+                         const std::string& outputFilename,
+                         size_t k,
+                         size_t arity,
+                         size_t memoryLimit,
+                         IOStats& stats) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    stats.reset();
+
+    if (!fs::exists(inputFilename)) {
+        std::cerr << "Error al abrir archivo para ordenamiento parcial: " << inputFilename << std::endl;
+        return;
+    }
+
+    std::ofstream outputFile(outputFilename, std::ios::binary);
+    externalRankRange(inputFilename, 0, k, arity, memoryLimit, stats,
+                      [&](const std::vector<int64_t>& block) { writeBlock(outputFile, block, stats); });
+    outputFile.close();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = endTime - startTime;
+
+    std::cout << "Ordenamiento parcial (k = " << k << ") completado en " << duration.count() << " segundos" << std::endl;
+    std::cout << "Total operaciones I/O: " << stats.total() << std::endl;
+}
+
+/**
+ * @brief Obtiene el elemento que ocuparía la posición `rank` en el archivo ordenado
+ *
+ * @param inputFilename Archivo de entrada
+ * @param rank Posición buscada (comenzando en 0)
+ * @param arity Número de particiones a crear en cada paso
+ * @param memoryLimit Límite de memoria en bytes
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return int64_t Elemento de rango `rank`
+ */
+int64_t externalSelect(const std::string& inputFilename,
+                       size_t rank,
+                       size_t arity,
+                       size_t memoryLimit,
+                       IOStats& stats) {
+    stats.reset();
+
+    if (!fs::exists(inputFilename) || rank >= fs::file_size(inputFilename) / sizeof(int64_t)) {
+        std::cerr << "Error: rango " << rank << " fuera del archivo " << inputFilename << std::endl;
+        return 0;
+    }
+
+    int64_t result = 0;
+    externalRankRange(inputFilename, rank, rank + 1, arity, memoryLimit, stats,
+                      [&](const std::vector<int64_t>& block) { result = block[0]; });
+
+    std::cout << "Selección del rango " << rank << ": " << stats.total() << " operaciones I/O" << std::endl;
+    return result;
+}
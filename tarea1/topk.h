@@ -0,0 +1,66 @@
+#ifndef TOPK_H
+#define TOPK_H
+
+#include "iostats.h"
+#include "constants.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Obtiene los k elementos más pequeños de un archivo en una sola pasada
+ *
+ * @param inputFilename Archivo de entrada (no necesita estar ordenado)
+ * @param k Cantidad de elementos a obtener
+ * @param memoryLimit Límite de memoria en bytes
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return std::vector<int64_t> Los k menores elementos en orden ascendente
+ *
+ * @note Usa un max-heap acotado a k elementos; el resto de la memoria se usa como buffer de lectura
+ * @warning Requiere k * sizeof(int64_t) < memoryLimit; si no, usar externalPartialSort
+ */
+std::vector<int64_t> externalTopK(const std::string& inputFilename,
+                                  size_t k,
+                                  size_t memoryLimit,
+                                  IOStats& stats);
+
+/**
+ * @brief Escribe ordenados los k elementos más pequeños de un archivo
+ *
+ * @param inputFilename Archivo de entrada a ordenar parcialmente
+ * @param outputFilename Archivo de salida con los k menores elementos ordenados
+ * @param k Cantidad de elementos a obtener (puede exceder la memoria)
+ * @param arity Número de particiones a crear en cada paso
+ * @param memoryLimit Límite de memoria en bytes
+ * @param stats Objeto para registrar estadísticas de I/O
+ *
+ * @note Reutiliza selectPivots y partition de Quicksort externo, pero solo
+ *       recursa en las particiones que se solapan con los rangos [0, k)
+ * @warning Crea archivos temporales en el directorio ./temp_topk_[arity]
+ */
+void externalPartialSort(const std::string& inputFilename,
+                         const std::string& outputFilename,
+                         size_t k,
+                         size_t arity,
+                         size_t memoryLimit,
+                         IOStats& stats);
+
+/**
+ * @brief Obtiene el elemento que ocuparía la posición `rank` en el archivo ordenado
+ *
+ * @param inputFilename Archivo de entrada
+ * @param rank Posición buscada (comenzando en 0)
+ * @param arity Número de particiones a crear en cada paso
+ * @param memoryLimit Límite de memoria en bytes
+ * @param stats Objeto para registrar estadísticas de I/O
+ * @return int64_t Elemento de rango `rank`
+ *
+ * @note En cada nivel solo se recursa en la única partición que contiene el rango
+ * @warning Si rank está fuera del archivo reporta un error y retorna 0
+ */
+int64_t externalSelect(const std::string& inputFilename,
+                       size_t rank,
+                       size_t arity,
+                       size_t memoryLimit,
+                       IOStats& stats);
+
+#endif
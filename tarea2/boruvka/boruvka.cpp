@@ -0,0 +1,187 @@
+#include "boruvka.hpp"
+#include "../estructuras/nube_puntos.hpp"
+#include "../estructuras/paralelo.hpp"
+#include <atomic>
+#include <limits>
+
+namespace {
+
+    const uint32_t NINGUNA = numeric_limits<uint32_t>::max(); ///< Sin arista (o vecino) elegida
+
+    /** \brief Orden total de aristas del grafo completo: peso, luego extremos (menor, mayor). */
+    bool menor_arista(double peso_a, uint32_t u_a, uint32_t v_a, double peso_b, uint32_t u_b, uint32_t v_b) {
+        if (peso_a != peso_b) return peso_a < peso_b;
+        pair<uint32_t, uint32_t> a = minmax(u_a, v_a);
+        pair<uint32_t, uint32_t> b = minmax(u_b, v_b);
+        return a < b;
+    }
+
+    /** \brief Actualiza rep[i] = find_rep(i) para todos los puntos. */
+    void calcular_representantes(UnionFindConcurrente& uf, vector<uint32_t>& rep, unsigned hilos) {
+        size_t n = rep.size();
+        Paralelo::en_paralelo(hilos, [&](unsigned k) {
+            size_t fin = Paralelo::inicio_tramo(n, k + 1, hilos);
+            for (size_t i = Paralelo::inicio_tramo(n, k, hilos); i < fin; ++i) {
+                rep[i] = uf.find_rep(static_cast<uint32_t>(i));
+            }
+        });
+    }
+
+    /**
+     *  \brief Contrae en paralelo la arista elegida por cada componente.
+     *
+     *  Si dos componentes eligieron la misma arista, solo una de las uniones devuelve
+     *  true, así que cada arista entra una sola vez al MST.
+     *  \param extremos Función pair<uint32_t, uint32_t>(uint32_t c): extremos elegidos por la componente c.
+     *  \return Cantidad de aristas agregadas.
+     */
+    template <class Extremos>
+    size_t contraer(const vector<Punto*>& puntos, const vector<uint32_t>& rep, const vector<uint32_t>& elegida,
+                    UnionFindConcurrente& uf, Extremos extremos, vector<Arista>& mst, unsigned hilos) {
+        size_t n = rep.size();
+        vector<uint8_t> agregada(n, 0);
+        Paralelo::en_paralelo(hilos, [&](unsigned k) {
+            size_t fin = Paralelo::inicio_tramo(n, k + 1, hilos);
+            for (size_t c = Paralelo::inicio_tramo(n, k, hilos); c < fin; ++c) {
+                if (rep[c] != c || elegida[c] == NINGUNA) continue;
+                auto [u, v] = extremos(static_cast<uint32_t>(c));
+                agregada[c] = uf.union_eq_class(u, v);
+            }
+        });
+
+        size_t antes = mst.size();
+        for (size_t c = 0; c < n; ++c) {
+            if (agregada[c]) {
+                auto [u, v] = extremos(static_cast<uint32_t>(c));
+                mst.emplace_back(puntos[u], puntos[v]);
+            }
+        }
+        return mst.size() - antes;
+    }
+}
+
+vector<Arista> boruvka_aristas(const vector<Punto*>& puntos, const vector<pair<uint32_t, uint32_t>>& pares, unsigned hilos) {
+    hilos = max(1u, hilos);
+    size_t n = puntos.size();
+    size_t m = pares.size();
+    vector<Arista> mst;
+    if (n < 2 || m == 0) return mst;
+
+    vector<double> pesos(m);
+    Paralelo::en_paralelo(hilos, [&](unsigned k) {
+        size_t fin = Paralelo::inicio_tramo(m, k + 1, hilos);
+        for (size_t e = Paralelo::inicio_tramo(m, k, hilos); e < fin; ++e) {
+            pesos[e] = PuntoUtils::getWeight(*puntos[pares[e].first], *puntos[pares[e].second]);
+        }
+    });
+    // empates por posición en la lista: orden total, las elegidas no forman ciclos
+    auto menor = [&](uint32_t a, uint32_t b) {
+        return pesos[a] < pesos[b] || (pesos[a] == pesos[b] && a < b);
+    };
+
+    UnionFindConcurrente uf(n);
+    vector<uint32_t> rep(n);
+    vector<atomic<uint32_t>> mejor(n);
+    vector<uint32_t> elegida(n);
+
+    while (mst.size() + 1 < n) {
+        calcular_representantes(uf, rep, hilos);
+        for (atomic<uint32_t>& celda : mejor) {
+            celda.store(NINGUNA, memory_order_relaxed);
+        }
+
+        Paralelo::en_paralelo(hilos, [&](unsigned k) {
+            auto actualizar = [&](atomic<uint32_t>& celda, uint32_t e) {
+                uint32_t actual = celda.load(memory_order_relaxed);
+                while ((actual == NINGUNA || menor(e, actual)) && !celda.compare_exchange_weak(actual, e)) {
+                }
+            };
+            size_t fin = Paralelo::inicio_tramo(m, k + 1, hilos);
+            for (size_t e = Paralelo::inicio_tramo(m, k, hilos); e < fin; ++e) {
+                uint32_t ru = rep[pares[e].first];
+                uint32_t rv = rep[pares[e].second];
+                if (ru == rv) continue;
+                actualizar(mejor[ru], static_cast<uint32_t>(e));
+                actualizar(mejor[rv], static_cast<uint32_t>(e));
+            }
+        });
+        for (size_t c = 0; c < n; ++c) {
+            elegida[c] = mejor[c].load(memory_order_relaxed);
+        }
+
+        size_t agregadas = contraer(puntos, rep, elegida, uf, [&](uint32_t c) { return pares[elegida[c]]; }, mst, hilos);
+        if (agregadas == 0) break; // no quedan aristas entre componentes: bosque
+    }
+    return mst;
+}
+
+vector<Arista> boruvka_completo(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config) {
+    unsigned hilos = max(1u, config.hilos);
+    size_t n = puntos.size();
+    vector<Arista> mst;
+
+    vector<uint32_t> rep(n);
+    vector<uint32_t> vecino(n, NINGUNA); // vecino más cercano fuera de la componente
+    vector<double> distancia(n);
+    vector<uint32_t> elegida(n);          // punto de la componente cuya arista (punto, vecino) es la elegida
+    UnionFindConcurrente uf = [&] {
+        RegionHW region(perfil, "conjuntos");
+        return UnionFindConcurrente(n);
+    }();
+    NubePuntos nube = [&] {
+        RegionHW region(perfil, "coordenadas");
+        return NubePuntos(puntos, config.simd);
+    }();
+
+    RegionHW region(perfil, "mst");
+    while (mst.size() + 1 < n) {
+        calcular_representantes(uf, rep, hilos);
+
+        // puntos intercalados entre hilos: los que deben volver a buscar quedan repartidos
+        Paralelo::en_paralelo(hilos, [&](unsigned k) {
+            vector<double> fila;
+            for (size_t i = k; i < n; i += hilos) {
+                uint32_t ri = rep[i];
+                if (vecino[i] != NINGUNA && rep[vecino[i]] != ri) continue; // sigue afuera: sigue siendo el más cercano
+
+                fila.resize(n);
+                nube.fila_distancias(i, 0, n, fila.data());
+                uint32_t mejor = NINGUNA;
+                double mejor_distancia = 0;
+                for (size_t j = 0; j < n; ++j) {
+                    if (rep[j] == ri) continue;
+                    double d = fila[j];
+                    if (mejor == NINGUNA || menor_arista(d, i, j, mejor_distancia, i, mejor)) {
+                        mejor = static_cast<uint32_t>(j);
+                        mejor_distancia = d;
+                    }
+                }
+                vecino[i] = mejor;
+                distancia[i] = mejor_distancia;
+            }
+        });
+
+        // mínimo por componente: O(n), secuencial
+        fill(elegida.begin(), elegida.end(), NINGUNA);
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t& e = elegida[rep[i]];
+            if (e == NINGUNA || menor_arista(distancia[i], i, vecino[i], distancia[e], e, vecino[e])) {
+                e = static_cast<uint32_t>(i);
+            }
+        }
+
+        size_t agregadas = contraer(puntos, rep, elegida, uf, [&](uint32_t c) { return make_pair(elegida[c], vecino[elegida[c]]); }, mst, hilos);
+        if (agregadas == 0) break;
+    }
+    return mst;
+}
+
+vector<Arista> boruvka_delaunay(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config) {
+    vector<pair<uint32_t, uint32_t>> pares;
+    {
+        RegionHW region(perfil, "aristas");
+        pares = DelaunayUtils::getParesDelaunay(puntos);
+    }
+    RegionHW region(perfil, "mst");
+    return boruvka_aristas(puntos, pares, config.hilos);
+}
@@ -0,0 +1,51 @@
+/** \file boruvka.hpp
+ *  \brief Algoritmo de Borůvka paralelo para el MST euclidiano.
+ */
+#ifndef BORUVKA_HPP
+#define BORUVKA_HPP
+
+#include "../kruskal/kruskal.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ *  \brief Borůvka paralelo sobre una lista explícita de aristas.
+ *
+ *  En cada ronda cada componente elige su arista de salida más liviana (los hilos
+ *  recorren tramos de la lista y actualizan el mínimo de cada componente con
+ *  compare-exchange) y luego todas las elegidas se contraen en un UnionFindConcurrente.
+ *  Los empates se rompen por posición en la lista, así que las elegidas no forman ciclos;
+ *  cada ronda al menos divide por dos la cantidad de componentes: O(log n) rondas.
+ *  \param puntos Vector de punteros a puntos.
+ *  \param pares Aristas como pares de índices sobre puntos.
+ *  \param hilos Cantidad de hilos.
+ *  \return Aristas del bosque generador mínimo (el MST si pares conecta todos los puntos).
+ */
+vector<Arista> boruvka_aristas(const vector<Punto*>& puntos, const vector<pair<uint32_t, uint32_t>>& pares, unsigned hilos);
+
+/**
+ *  \brief Borůvka paralelo sobre el grafo completo, sin materializar aristas.
+ *
+ *  Cada punto busca su vecino más cercano fuera de su componente recorriendo todos los
+ *  puntos (O(n) por punto, repartido entre hilos). Como las componentes solo crecen,
+ *  si el vecino de la ronda anterior sigue afuera sigue siendo el más cercano y no se
+ *  vuelve a buscar. Las distancias de cada búsqueda se calculan por filas sobre una
+ *  NubePuntos. Memoria O(n).
+ *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("conjuntos", "coordenadas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (hilos y simd).
+ *  \return Vector de aristas que forman el MST.
+ */
+vector<Arista> boruvka_completo(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
+
+/**
+ *  \brief Borůvka paralelo sobre las aristas de la triangulación de Delaunay.
+ *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("aristas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (solo se usa hilos).
+ *  \return Vector de aristas que forman el MST.
+ */
+vector<Arista> boruvka_delaunay(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
+
+#endif
@@ -1,4 +1,6 @@
 #include "aristas.hpp"
+#include "nube_puntos.hpp"
+#include "paralelo.hpp"
 
 
 Arista::Arista(Punto* a, Punto* b)
@@ -6,21 +8,87 @@ Arista::Arista(Punto* a, Punto* b)
 
 namespace AristaUtils {
 
+    // orden creciente por peso: Kruskal recorre las aristas de la más liviana a la más pesada
     auto comp = [](const Arista& a, const Arista& b) {
-        return a.peso > b.peso;
+        return a.peso < b.peso;
     };
 
     vector<Arista> getAristasSort(const vector<Punto*>& puntos) {
-        vector<Arista> aristas;
-        for (size_t i = 0; i < puntos.size(); ++i) {
-            for (size_t j = i + 1; j < puntos.size(); ++j) {
-                aristas.emplace_back(puntos[i], puntos[j]);
-            }
-        }
+        vector<Arista> aristas = getAristas(puntos);
+        ordenarAristas(aristas);
+        return aristas;
+    }
+
+    vector<Arista> getAristas(const vector<Punto*>& puntos) {
+        return getAristasParalelo(puntos, 1);
+    }
+
+    void ordenarAristas(vector<Arista>& aristas) {
         sort(aristas.begin(), aristas.end(), comp);
+    }
+
+    size_t filaDeArista(size_t e, size_t n) {
+        // mayor i con desplazamientoFila(i, n) <= e
+        size_t lo = 0, hi = n - 1;
+        while (hi - lo > 1) {
+            size_t medio = lo + (hi - lo) / 2;
+            if (desplazamientoFila(medio, n) <= e) lo = medio;
+            else hi = medio;
+        }
+        return lo;
+    }
+
+    vector<Arista> getAristasParalelo(const vector<Punto*>& puntos, unsigned hilos) {
+        size_t n = puntos.size();
+        size_t m = n < 2 ? 0 : n * (n - 1) / 2;
+        vector<Arista> aristas(m);
+        NubePuntos nube(puntos);
+
+        Paralelo::en_paralelo(hilos, [&](unsigned k) {
+            nube.recorrer_aristas(Paralelo::inicio_tramo(m, k, hilos), Paralelo::inicio_tramo(m, k + 1, hilos),
+                                  [&](size_t e, uint32_t i, uint32_t j, double peso) {
+                aristas[e] = Arista(puntos[i], puntos[j], peso);
+            });
+        });
         return aristas;
     }
 
+    void ordenarAristasParalelo(vector<Arista>& aristas, unsigned hilos) {
+        size_t m = aristas.size();
+        if (hilos <= 1 || m < 2 * static_cast<size_t>(hilos)) {
+            ordenarAristas(aristas);
+            return;
+        }
+
+        vector<size_t> cortes(hilos + 1);
+        for (unsigned k = 0; k <= hilos; ++k) {
+            cortes[k] = Paralelo::inicio_tramo(m, k, hilos);
+        }
+        Paralelo::en_paralelo(hilos, [&](unsigned k) {
+            sort(aristas.begin() + cortes[k], aristas.begin() + cortes[k + 1], comp);
+        });
+
+        // rondas de mezcla: en la ronda de ancho a se juntan los tramos [t, t+a) y [t+a, t+2a)
+        vector<Arista> buffer(m);
+        vector<Arista>* origen = &aristas;
+        vector<Arista>* destino = &buffer;
+        for (size_t ancho = 1; ancho < hilos; ancho *= 2) {
+            unsigned pares = static_cast<unsigned>((hilos + 2 * ancho - 1) / (2 * ancho));
+            Paralelo::en_paralelo(pares, [&](unsigned p) {
+                size_t a = cortes[p * 2 * ancho];
+                size_t b = cortes[min<size_t>(p * 2 * ancho + ancho, hilos)];
+                size_t c = cortes[min<size_t>(p * 2 * ancho + 2 * ancho, hilos)];
+                merge(origen->begin() + a, origen->begin() + b,
+                      origen->begin() + b, origen->begin() + c,
+                      destino->begin() + a, comp);
+            });
+            swap(origen, destino);
+        }
+        if (origen != &aristas) {
+            aristas.swap(*origen);
+        }
+    }
+
         // Esto se hace solo una vez, al inicio de Kruskal
     priority_queue<Arista, vector<Arista>, ComparadorAristas>
     construirHeapAristas(const vector<Punto*>& puntos) {
@@ -29,6 +29,19 @@ struct Arista {
      *  \param b Puntero al segundo punto.
      */
     Arista(Punto* a, Punto* b);
+
+    /**
+     *  \brief Construye una arista con el peso ya calculado (por ejemplo, por NubePuntos).
+     *  \param a Puntero al primer punto.
+     *  \param b Puntero al segundo punto.
+     *  \param peso Distancia al cuadrado entre a y b.
+     */
+    Arista(Punto* a, Punto* b, double peso) : p1(a), p2(b), peso(peso) {}
+
+    /**
+     *  \brief Arista sin inicializar, para preasignar listas que luego se llenan por posición.
+     */
+    Arista() {}
 };
 
 /**
@@ -50,6 +63,62 @@ namespace AristaUtils
      */
     vector<Arista> getAristasSort(const vector<Punto*>& puntos);
 
+    /**
+     *  \brief Genera la lista completa de aristas, sin ordenar.
+     *
+     *  Los pesos se calculan por filas sobre una NubePuntos (kernel vectorizado).
+     *  \param puntos Vector de punteros a puntos.
+     *  \return Vector de las n(n-1)/2 aristas.
+     */
+    vector<Arista> getAristas(const vector<Punto*>& puntos);
+
+    /**
+     *  \brief Ordena aristas por peso creciente.
+     *  \param aristas Vector de aristas a ordenar.
+     */
+    void ordenarAristas(vector<Arista>& aristas);
+
+    /**
+     *  \brief Posición de la arista (i, i+1) en la lista del grafo completo.
+     *
+     *  La fila i aporta n - 1 - i aristas, así que antes de ella hay i(2n - i - 1)/2.
+     *  \param i Fila (primer extremo).
+     *  \param n Cantidad de puntos.
+     */
+    inline size_t desplazamientoFila(size_t i, size_t n) {
+        return i * (2 * n - i - 1) / 2;
+    }
+
+    /**
+     *  \brief Fila (primer extremo) de la arista en la posición e del grafo completo.
+     *  \param e Posición en la lista, menor que n(n-1)/2.
+     *  \param n Cantidad de puntos.
+     */
+    size_t filaDeArista(size_t e, size_t n);
+
+    /**
+     *  \brief Genera la lista completa de aristas, sin ordenar, repartida entre hilos.
+     *
+     *  Se reservan exactamente n(n-1)/2 posiciones y cada hilo llena un tramo contiguo;
+     *  el punto de partida de cada tramo se obtiene con desplazamientoFila, así que no
+     *  hay sincronización. Cada hilo calcula los pesos por filas sobre una NubePuntos.
+     *  El resultado es idéntico al de getAristas.
+     *  \param puntos Vector de punteros a puntos.
+     *  \param hilos Cantidad de hilos.
+     *  \return Vector de las n(n-1)/2 aristas.
+     */
+    vector<Arista> getAristasParalelo(const vector<Punto*>& puntos, unsigned hilos);
+
+    /**
+     *  \brief Ordena aristas por peso creciente con merge sort paralelo.
+     *
+     *  Cada hilo ordena un tramo con sort y luego los tramos se mezclan de a pares,
+     *  en paralelo, en log2(hilos) rondas (usa un buffer del mismo tamaño).
+     *  \param aristas Vector de aristas a ordenar.
+     *  \param hilos Cantidad de hilos; con 1 equivale a ordenarAristas.
+     */
+    void ordenarAristasParalelo(vector<Arista>& aristas, unsigned hilos);
+
     /**
      *  \brief Construye un heap (priority_queue) con todas las aristas.
      *  \param puntos Vector de punteros a puntos.
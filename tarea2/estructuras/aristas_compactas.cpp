@@ -0,0 +1,163 @@
+#include "aristas_compactas.hpp"
+#include "nube_puntos.hpp"
+#include "paralelo.hpp"
+#include <array>
+
+namespace {
+
+    const unsigned BITS_DIGITO = 11;
+    const size_t NUM_DIGITOS = size_t(1) << BITS_DIGITO;
+
+    /**
+     *  \brief Radix sort LSD paralelo y estable sobre los bits [bit_inicio, bit_fin) de clave(e).
+     *  \param datos Elementos a ordenar.
+     *  \param clave Función uint64_t(const T&).
+     *  \param bit_inicio Primer bit de la clave que se ordena.
+     *  \param bit_fin Bit siguiente al último que se ordena.
+     *  \param hilos Cantidad de hilos.
+     */
+    template <class T, class Clave>
+    void radix_paralelo(vector<T>& datos, Clave clave, unsigned bit_inicio, unsigned bit_fin, unsigned hilos) {
+        size_t m = datos.size();
+        if (m < 2) return;
+        hilos = max(1u, hilos);
+
+        vector<T> buffer(m);
+        vector<T>* origen = &datos;
+        vector<T>* destino = &buffer;
+        vector<array<size_t, NUM_DIGITOS>> conteo(hilos);
+
+        for (unsigned bit = bit_inicio; bit < bit_fin; bit += BITS_DIGITO) {
+            uint64_t mascara = NUM_DIGITOS - 1;
+            Paralelo::en_paralelo(hilos, [&](unsigned k) {
+                array<size_t, NUM_DIGITOS>& c = conteo[k];
+                c.fill(0);
+                size_t fin = Paralelo::inicio_tramo(m, k + 1, hilos);
+                for (size_t e = Paralelo::inicio_tramo(m, k, hilos); e < fin; ++e) {
+                    ++c[(clave((*origen)[e]) >> bit) & mascara];
+                }
+            });
+
+            // posición de salida de cada (dígito, hilo): los hilos van en orden dentro de cada dígito
+            size_t acumulado = 0;
+            bool trivial = false;
+            for (size_t d = 0; d < NUM_DIGITOS; ++d) {
+                size_t total_digito = 0;
+                for (unsigned k = 0; k < hilos; ++k) {
+                    size_t c = conteo[k][d];
+                    conteo[k][d] = acumulado + total_digito;
+                    total_digito += c;
+                }
+                trivial = trivial || total_digito == m;
+                acumulado += total_digito;
+            }
+            if (trivial) continue;
+
+            Paralelo::en_paralelo(hilos, [&](unsigned k) {
+                array<size_t, NUM_DIGITOS>& pos = conteo[k];
+                size_t fin = Paralelo::inicio_tramo(m, k + 1, hilos);
+                for (size_t e = Paralelo::inicio_tramo(m, k, hilos); e < fin; ++e) {
+                    const T& x = (*origen)[e];
+                    (*destino)[pos[(clave(x) >> bit) & mascara]++] = x;
+                }
+            });
+            swap(origen, destino);
+        }
+        if (origen != &datos) {
+            datos.swap(*origen);
+        }
+    }
+}
+
+void ListaAristasCompacta::reservar(size_t m) {
+    if (!soa) {
+        if (peso_32) aos32.reserve(m);
+        else aos.reserve(m);
+        return;
+    }
+    us.reserve(m);
+    vs.reserve(m);
+    if (peso_32) claves32.reserve(m);
+    else claves.reserve(m);
+}
+
+void ListaAristasCompacta::redimensionar(size_t m) {
+    if (!soa) {
+        if (peso_32) aos32.resize(m);
+        else aos.resize(m);
+        return;
+    }
+    us.resize(m);
+    vs.resize(m);
+    if (peso_32) claves32.resize(m);
+    else claves.resize(m);
+}
+
+void ListaAristasCompacta::agregar_completas(const vector<Punto*>& puntos, unsigned hilos) {
+    size_t n = puntos.size();
+    size_t m = n < 2 ? 0 : n * (n - 1) / 2;
+    size_t base = size();
+    redimensionar(base + m);
+
+    NubePuntos nube(puntos);
+
+    Paralelo::en_paralelo(hilos, [&](unsigned k) {
+        nube.recorrer_aristas(Paralelo::inicio_tramo(m, k, hilos), Paralelo::inicio_tramo(m, k + 1, hilos),
+                              [&](size_t e, uint32_t i, uint32_t j, double peso) {
+            escribir(base + e, i, j, peso);
+        });
+    });
+}
+
+void ListaAristasCompacta::agregar_pares(const vector<Punto*>& puntos, const vector<pair<uint32_t, uint32_t>>& pares) {
+    reservar(size() + pares.size());
+    for (const auto& [u, v] : pares) {
+        agregar(u, v, PuntoUtils::getWeight(*puntos[u], *puntos[v]));
+    }
+}
+
+void ListaAristasCompacta::ordenar() {
+    es_heap = false;
+    if (!soa) {
+        if (peso_32) sort(aos32.begin(), aos32.end());
+        else sort(aos.begin(), aos.end());
+    } else if (peso_32) {
+        sort(claves32.begin(), claves32.end());
+    } else {
+        sort(claves.begin(), claves.end());
+    }
+}
+
+void ListaAristasCompacta::ordenar_radix(unsigned hilos) {
+    es_heap = false;
+    if (!soa) {
+        if (peso_32) radix_paralelo(aos32, [](const AristaCompacta32& a) -> uint64_t { return a.clave; }, 0, 32, hilos);
+        else radix_paralelo(aos, [](const AristaCompacta& a) { return a.clave; }, 0, 64, hilos);
+    } else if (peso_32) {
+        radix_paralelo(claves32, [](uint64_t c) { return c; }, 32, 64, hilos);
+    } else {
+        radix_paralelo(claves, [](const ClaveId& c) { return c.clave; }, 0, 64, hilos);
+    }
+}
+
+void ListaAristasCompacta::armar_heap() {
+    es_heap = true;
+    if (!soa) {
+        if (peso_32) make_heap(aos32.begin(), aos32.end(), greater<AristaCompacta32>());
+        else make_heap(aos.begin(), aos.end(), greater<AristaCompacta>());
+    } else if (peso_32) {
+        make_heap(claves32.begin(), claves32.end(), greater<uint64_t>());
+    } else {
+        make_heap(claves.begin(), claves.end(), greater<ClaveId>());
+    }
+}
+
+size_t ListaAristasCompacta::size() const {
+    if (!soa) return peso_32 ? aos32.size() : aos.size();
+    return us.size();
+}
+
+size_t ListaAristasCompacta::bytes_por_arista(bool peso_32, bool soa) {
+    if (!soa) return peso_32 ? sizeof(AristaCompacta32) : sizeof(AristaCompacta);
+    return 2 * sizeof(uint32_t) + (peso_32 ? sizeof(uint64_t) : sizeof(ClaveId));
+}
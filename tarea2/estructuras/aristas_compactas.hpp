@@ -0,0 +1,251 @@
+/** \file aristas_compactas.hpp
+ *  \brief Lista de aristas compacta: extremos como índices de 32 bits y peso codificado como entero.
+ */
+#ifndef ARISTAS_COMPACTAS_HPP
+#define ARISTAS_COMPACTAS_HPP
+
+#include "puntos.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace CodificacionPeso
+{
+    /**
+     *  \brief Codifica un peso no negativo como entero de 64 bits que conserva el orden.
+     *
+     *  Para doubles no negativos, los bits IEEE 754 leídos como entero sin signo crecen
+     *  con el valor, así que comparar claves equivale a comparar pesos (sin pérdida).
+     *  \param peso Peso (distancia al cuadrado, >= 0).
+     *  \return Clave de 64 bits.
+     */
+    inline uint64_t codificar64(double peso) {
+        uint64_t clave;
+        memcpy(&clave, &peso, sizeof(clave));
+        return clave;
+    }
+
+    /**
+     *  \brief Codifica un peso no negativo como entero de 32 bits (bits de float) que conserva el orden.
+     *
+     *  El redondeo a float es monótono, pero pesos distintos pueden quedar empatados:
+     *  el orden es aproximado (error relativo ~6e-8).
+     *  \param peso Peso (distancia al cuadrado, >= 0).
+     *  \return Clave de 32 bits.
+     */
+    inline uint32_t codificar32(double peso) {
+        float f = static_cast<float>(peso);
+        uint32_t clave;
+        memcpy(&clave, &f, sizeof(clave));
+        return clave;
+    }
+}
+
+/**
+ *  \struct AristaCompacta
+ *  \brief Arista de 16 bytes: peso codificado en 64 bits y extremos como índices.
+ */
+struct AristaCompacta {
+    uint64_t clave; ///< Peso codificado (CodificacionPeso::codificar64)
+    uint32_t u;     ///< Índice del primer extremo
+    uint32_t v;     ///< Índice del segundo extremo
+
+    bool operator<(const AristaCompacta& otra) const { return clave < otra.clave; }
+    bool operator>(const AristaCompacta& otra) const { return clave > otra.clave; }
+};
+
+/**
+ *  \struct AristaCompacta32
+ *  \brief Arista de 12 bytes: peso codificado en 32 bits y extremos como índices.
+ */
+struct AristaCompacta32 {
+    uint32_t clave; ///< Peso codificado (CodificacionPeso::codificar32)
+    uint32_t u;     ///< Índice del primer extremo
+    uint32_t v;     ///< Índice del segundo extremo
+
+    bool operator<(const AristaCompacta32& otra) const { return clave < otra.clave; }
+    bool operator>(const AristaCompacta32& otra) const { return clave > otra.clave; }
+};
+
+/**
+ *  \struct ClaveId
+ *  \brief Clave de orden del layout SoA con peso de 64 bits: peso codificado e id de la arista.
+ *
+ *  Empaquetada en 12 bytes (sin el relleno a 16 que pondría la alineación del uint64_t):
+ *  x86 lee la clave desalineada sin costo apreciable y el orden mueve un 25% menos de memoria.
+ */
+struct __attribute__((packed)) ClaveId {
+    uint64_t clave; ///< Peso codificado
+    uint32_t id;    ///< Posición de la arista en los arreglos de extremos
+
+    bool operator<(const ClaveId& otra) const { return clave < otra.clave; }
+    bool operator>(const ClaveId& otra) const { return clave > otra.clave; }
+};
+static_assert(sizeof(ClaveId) == 12, "ClaveId debe ocupar 12 bytes");
+
+/**
+ *  \class ListaAristasCompacta
+ *  \brief Aristas con extremos de 32 bits y peso entero, en layout AoS o SoA.
+ *
+ *  - AoS: un arreglo de AristaCompacta (16 B) o AristaCompacta32 (12 B); ordenar mueve la arista completa.
+ *  - SoA: extremos en dos arreglos aparte y un arreglo de claves (peso, id); ordenar mueve solo
+ *    las claves. Con peso de 32 bits la clave es un único uint64_t (peso << 32 | id).
+ *
+ *  Se puede ordenar (Kruskal con sort) o dejar como min-heap (Kruskal con heap); en ambos
+ *  casos recorrer() entrega los extremos de menor a mayor peso.
+ */
+class ListaAristasCompacta {
+private:
+    bool peso_32;
+    bool soa;
+    bool es_heap = false;
+
+    vector<AristaCompacta> aos;     ///< AoS, peso de 64 bits
+    vector<AristaCompacta32> aos32; ///< AoS, peso de 32 bits
+    vector<uint32_t> us;            ///< SoA: primer extremo de cada arista
+    vector<uint32_t> vs;            ///< SoA: segundo extremo de cada arista
+    vector<ClaveId> claves;         ///< SoA, peso de 64 bits
+    vector<uint64_t> claves32;      ///< SoA, peso de 32 bits: (peso << 32) | id
+
+    /** \brief Agranda los arreglos a m aristas (las nuevas posiciones se llenan con escribir). */
+    void redimensionar(size_t m);
+
+    /** \brief Escribe la arista de la posición pos, ya reservada con redimensionar. */
+    void escribir(size_t pos, uint32_t u, uint32_t v, double peso) {
+        if (!soa) {
+            if (peso_32) aos32[pos] = {CodificacionPeso::codificar32(peso), u, v};
+            else aos[pos] = {CodificacionPeso::codificar64(peso), u, v};
+            return;
+        }
+        uint32_t id = static_cast<uint32_t>(pos);
+        us[pos] = u;
+        vs[pos] = v;
+        if (peso_32) claves32[pos] = static_cast<uint64_t>(CodificacionPeso::codificar32(peso)) << 32 | id;
+        else claves[pos] = {CodificacionPeso::codificar64(peso), id};
+    }
+
+    template <class T, class G>
+    void recorrer_en(vector<T>& elementos, G&& g) {
+        if (!es_heap) {
+            for (const T& e : elementos) {
+                if (!g(e)) return;
+            }
+            return;
+        }
+        while (!elementos.empty()) {
+            pop_heap(elementos.begin(), elementos.end(), greater<T>());
+            T e = elementos.back();
+            elementos.pop_back();
+            if (!g(e)) return;
+        }
+    }
+
+public:
+    /**
+     *  \param peso_32 Codificar el peso en 32 bits (float) en vez de 64 (double).
+     *  \param soa Guardar extremos y claves en arreglos separados.
+     */
+    ListaAristasCompacta(bool peso_32, bool soa) : peso_32(peso_32), soa(soa) {}
+
+    /**
+     *  \brief Reserva memoria para m aristas.
+     *  \param m Cantidad de aristas.
+     */
+    void reservar(size_t m);
+
+    /**
+     *  \brief Agrega una arista.
+     *  \param u Índice del primer extremo.
+     *  \param v Índice del segundo extremo.
+     *  \param peso Peso (distancia al cuadrado).
+     */
+    void agregar(uint32_t u, uint32_t v, double peso) {
+        if (!soa) {
+            if (peso_32) aos32.push_back({CodificacionPeso::codificar32(peso), u, v});
+            else aos.push_back({CodificacionPeso::codificar64(peso), u, v});
+            return;
+        }
+        uint32_t id = static_cast<uint32_t>(us.size());
+        us.push_back(u);
+        vs.push_back(v);
+        if (peso_32) claves32.push_back(static_cast<uint64_t>(CodificacionPeso::codificar32(peso)) << 32 | id);
+        else claves.push_back({CodificacionPeso::codificar64(peso), id});
+    }
+
+    /**
+     *  \brief Agrega las n(n-1)/2 aristas del grafo completo.
+     *
+     *  Se reservan exactamente n(n-1)/2 posiciones y cada hilo llena un tramo contiguo
+     *  (el inicio de cada fila se calcula con AristaUtils::desplazamientoFila); los pesos
+     *  se calculan por filas sobre una NubePuntos.
+     *  \param puntos Vector de punteros a puntos (los índices son posiciones en él).
+     *  \param hilos Cantidad de hilos.
+     */
+    void agregar_completas(const vector<Punto*>& puntos, unsigned hilos = 1);
+
+    /**
+     *  \brief Agrega aristas dadas por pares de índices.
+     *  \param puntos Vector de punteros a puntos.
+     *  \param pares Pares de índices sobre puntos.
+     */
+    void agregar_pares(const vector<Punto*>& puntos, const vector<pair<uint32_t, uint32_t>>& pares);
+
+    /** \brief Ordena por peso creciente. */
+    void ordenar();
+
+    /**
+     *  \brief Ordena por peso creciente con radix sort LSD paralelo sobre las claves enteras.
+     *
+     *  Dígitos de 11 bits; en cada pasada cada hilo cuenta su tramo, se calculan los
+     *  prefijos por (dígito, hilo) y cada hilo reparte su tramo de forma estable. Las
+     *  pasadas en que todas las claves tienen el mismo dígito (p. ej. bits de exponente
+     *  comunes) se saltan. Con peso de 32 bits en SoA solo se ordena la mitad alta (el peso).
+     *  \param hilos Cantidad de hilos.
+     */
+    void ordenar_radix(unsigned hilos);
+
+    /** \brief Organiza las aristas como min-heap por peso (O(m)); recorrer() las extrae en orden. */
+    void armar_heap();
+
+    /** \brief Cantidad de aristas. */
+    size_t size() const;
+
+    /** \brief Bytes por arista del layout elegido. */
+    size_t bytes_por_arista() const { return bytes_por_arista(peso_32, soa); }
+
+    /**
+     *  \brief Bytes por arista de un layout.
+     *  \param peso_32 Peso de 32 bits.
+     *  \param soa Layout SoA.
+     */
+    static size_t bytes_por_arista(bool peso_32, bool soa);
+
+    /**
+     *  \brief Entrega los extremos (u, v) de menor a mayor peso hasta que f devuelva false.
+     *
+     *  En modo heap las aristas entregadas se extraen de la lista.
+     *  \param f Función bool(uint32_t u, uint32_t v).
+     */
+    template <class F>
+    void recorrer(F&& f) {
+        if (!soa) {
+            if (peso_32) recorrer_en(aos32, [&](const AristaCompacta32& a) { return f(a.u, a.v); });
+            else recorrer_en(aos, [&](const AristaCompacta& a) { return f(a.u, a.v); });
+        } else if (peso_32) {
+            recorrer_en(claves32, [&](uint64_t c) {
+                uint32_t id = static_cast<uint32_t>(c);
+                return f(us[id], vs[id]);
+            });
+        } else {
+            recorrer_en(claves, [&](const ClaveId& c) { return f(us[c.id], vs[c.id]); });
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,434 @@
+/*
+ *  La triangulación es una adaptación de Delaunator (https://github.com/mapbox/delaunator):
+ *  misma envoltura con hull_prev/hull_next/hull_tri/hull_hash, legalización con pila de
+ *  aristas, cota de orientación y hash por pseudo-ángulo. Se distribuye bajo su licencia:
+ *
+ *  ISC License
+ *
+ *  Copyright (c) 2021, Mapbox
+ *
+ *  Permission to use, copy, modify, and/or distribute this software for any purpose
+ *  with or without fee is hereby granted, provided that the above copyright notice
+ *  and this permission notice appear in all copies.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH REGARD TO
+ *  THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+ *  IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR
+ *  CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+ *  OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+ *  ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ */
+#include "delaunay.hpp"
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+namespace {
+
+    const double EPSILON = ldexp(1.0, -52); ///< Distancia bajo la cual dos puntos se consideran repetidos
+
+    /** \brief Orientación de (p, r, q) si el signo es confiable en punto flotante; 0 si no. */
+    double orientacion_segura(double px, double py, double rx, double ry, double qx, double qy) {
+        double l = (ry - py) * (qx - px);
+        double r = (rx - px) * (qy - py);
+        return fabs(l - r) >= 3.3306690738754716e-16 * fabs(l + r) ? l - r : 0;
+    }
+
+    /**
+     *  \brief true si (r, q, p) están en sentido antihorario.
+     *
+     *  Prueba la orientación desde los tres vértices y usa la primera que sea confiable,
+     *  para que la respuesta sea estable en puntos casi colineales.
+     */
+    bool antihorario(double rx, double ry, double qx, double qy, double px, double py) {
+        double o = orientacion_segura(px, py, rx, ry, qx, qy);
+        if (o == 0) o = orientacion_segura(rx, ry, qx, qy, px, py);
+        if (o == 0) o = orientacion_segura(qx, qy, px, py, rx, ry);
+        return o < 0;
+    }
+
+    /** \brief true si p está dentro del círculo circunscrito al triángulo horario (a, b, c). */
+    bool en_circulo(double ax, double ay, double bx, double by, double cx, double cy, double px, double py) {
+        double dx = ax - px, dy = ay - py;
+        double ex = bx - px, ey = by - py;
+        double fx = cx - px, fy = cy - py;
+        double ap = dx * dx + dy * dy;
+        double bp = ex * ex + ey * ey;
+        double cp = fx * fx + fy * fy;
+        return dx * (ey * cp - bp * fy) - dy * (ex * cp - bp * fx) + ap * (ex * fy - ey * fx) < 0;
+    }
+
+    /** \brief Cuadrado del radio del círculo circunscrito (infinito o NaN si son colineales). */
+    double radio_circunscrito(double ax, double ay, double bx, double by, double cx, double cy) {
+        double dx = bx - ax, dy = by - ay;
+        double ex = cx - ax, ey = cy - ay;
+        double bl = dx * dx + dy * dy;
+        double cl = ex * ex + ey * ey;
+        double d = 0.5 / (dx * ey - dy * ex);
+        double x = (ey * bl - dy * cl) * d;
+        double y = (dx * cl - ex * bl) * d;
+        return x * x + y * y;
+    }
+
+    /** \brief Centro del círculo circunscrito. */
+    pair<double, double> circuncentro(double ax, double ay, double bx, double by, double cx, double cy) {
+        double dx = bx - ax, dy = by - ay;
+        double ex = cx - ax, ey = cy - ay;
+        double bl = dx * dx + dy * dy;
+        double cl = ex * ex + ey * ey;
+        double d = 0.5 / (dx * ey - dy * ex);
+        return {ax + (ey * bl - dy * cl) * d, ay + (dx * cl - ex * bl) * d};
+    }
+
+    /** \brief Valor en [0, 1) que crece con el ángulo de (dx, dy), sin trigonometría. */
+    double pseudo_angulo(double dx, double dy) {
+        double suma = fabs(dx) + fabs(dy);
+        if (suma == 0) return 0;
+        double p = dx / suma;
+        return (dy > 0 ? 3 - p : 1 + p) / 4;
+    }
+
+    /**
+     *  \class ConstructorDelaunay
+     *  \brief Estado del barrido radial: envoltura convexa como lista doble y tabla hash por ángulo.
+     */
+    class ConstructorDelaunay {
+    private:
+        const vector<double>& coords; ///< x0, y0, x1, y1, ...
+        size_t n;
+        Triangulacion& t;
+        size_t num_semiaristas = 0;
+
+        vector<uint32_t> hull_prev;   ///< Vértice anterior en la envoltura
+        vector<uint32_t> hull_next;   ///< Vértice siguiente (hull_next[i] == i: ya no está en la envoltura)
+        vector<uint32_t> hull_tri;    ///< Semiarista del borde que sale de cada vértice de la envoltura
+        vector<int32_t> hull_hash;    ///< Vértice de la envoltura por sector angular (-1: vacío)
+        uint32_t hull_start = 0;
+        double cx = 0, cy = 0;        ///< Centro del barrido
+
+        vector<uint32_t> pila;        ///< Semiaristas pendientes de legalizar
+
+        double x(uint32_t i) const { return coords[2 * i]; }
+        double y(uint32_t i) const { return coords[2 * i + 1]; }
+
+        size_t clave_hash(double px, double py) const {
+            size_t clave = static_cast<size_t>(floor(pseudo_angulo(px - cx, py - cy) * hull_hash.size()));
+            return clave % hull_hash.size();
+        }
+
+        void enlazar(uint32_t a, int32_t b) {
+            t.opuestas[a] = b;
+            if (b != -1) t.opuestas[b] = static_cast<int32_t>(a);
+        }
+
+        uint32_t agregar_triangulo(uint32_t i0, uint32_t i1, uint32_t i2, int32_t a, int32_t b, int32_t c) {
+            uint32_t e = static_cast<uint32_t>(num_semiaristas);
+            t.triangulos[e] = i0;
+            t.triangulos[e + 1] = i1;
+            t.triangulos[e + 2] = i2;
+            enlazar(e, a);
+            enlazar(e + 1, b);
+            enlazar(e + 2, c);
+            num_semiaristas += 3;
+            return e;
+        }
+
+        /**
+         *  \brief Aplica flips desde la semiarista a hasta que los triángulos vecinos cumplan la condición de Delaunay.
+         *  \return Semiarista que queda en el lugar de la anterior a a en su triángulo.
+         */
+        uint32_t legalizar(uint32_t a);
+
+        /** \brief Une los puntos colineales (o todos iguales) en orden sobre la recta. */
+        void cadena_colineal();
+
+    public:
+        ConstructorDelaunay(const vector<double>& coords, Triangulacion& t)
+            : coords(coords), n(coords.size() / 2), t(t) {}
+
+        void construir();
+    };
+
+    uint32_t ConstructorDelaunay::legalizar(uint32_t a) {
+        pila.clear();
+        uint32_t ar = 0;
+
+        while (true) {
+            int32_t b = t.opuestas[a];
+            uint32_t a0 = a - a % 3;
+            ar = a0 + (a + 2) % 3;
+
+            if (b == -1) { // arista de la envoltura
+                if (pila.empty()) break;
+                a = pila.back();
+                pila.pop_back();
+                continue;
+            }
+
+            uint32_t ub = static_cast<uint32_t>(b);
+            uint32_t b0 = ub - ub % 3;
+            uint32_t al = a0 + (a + 1) % 3;
+            uint32_t bl = b0 + (ub + 2) % 3;
+
+            uint32_t p0 = t.triangulos[ar];
+            uint32_t pr = t.triangulos[a];
+            uint32_t pl = t.triangulos[al];
+            uint32_t p1 = t.triangulos[bl];
+
+            if (en_circulo(x(p0), y(p0), x(pr), y(pr), x(pl), y(pl), x(p1), y(p1))) {
+                t.triangulos[a] = p1;
+                t.triangulos[ub] = p0;
+
+                int32_t hbl = t.opuestas[bl];
+
+                // el flip movió una arista de la envoltura: se corrige su referencia
+                if (hbl == -1) {
+                    uint32_t e = hull_start;
+                    do {
+                        if (hull_tri[e] == bl) {
+                            hull_tri[e] = a;
+                            break;
+                        }
+                        e = hull_prev[e];
+                    } while (e != hull_start);
+                }
+                enlazar(a, hbl);
+                enlazar(ub, t.opuestas[ar]);
+                enlazar(ar, static_cast<int32_t>(bl));
+
+                pila.push_back(b0 + (ub + 1) % 3);
+            } else {
+                if (pila.empty()) break;
+                a = pila.back();
+                pila.pop_back();
+            }
+        }
+        return ar;
+    }
+
+    void ConstructorDelaunay::cadena_colineal() {
+        vector<double> posicion(n);
+        for (size_t i = 0; i < n; ++i) {
+            double dx = x(i) - x(0);
+            posicion[i] = dx != 0 ? dx : y(i) - y(0);
+        }
+        vector<uint32_t> ids(n);
+        iota(ids.begin(), ids.end(), 0);
+        sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) { return posicion[a] < posicion[b]; });
+        for (size_t k = 1; k < n; ++k) {
+            t.extra.emplace_back(ids[k], ids[k - 1]);
+        }
+    }
+
+    void ConstructorDelaunay::construir() {
+        if (n < 2) return;
+
+        double min_x = numeric_limits<double>::infinity(), min_y = min_x;
+        double max_x = -min_x, max_y = -min_x;
+        for (uint32_t i = 0; i < n; ++i) {
+            min_x = min(min_x, x(i));
+            min_y = min(min_y, y(i));
+            max_x = max(max_x, x(i));
+            max_y = max(max_y, y(i));
+        }
+        double centro_x = (min_x + max_x) / 2;
+        double centro_y = (min_y + max_y) / 2;
+
+        // triángulo semilla: el punto más cercano al centro, su vecino más cercano y
+        // el tercero que da el menor círculo circunscrito
+        auto dist = [&](uint32_t i, double px, double py) {
+            return (x(i) - px) * (x(i) - px) + (y(i) - py) * (y(i) - py);
+        };
+        uint32_t i0 = 0, i1 = 0, i2 = 0;
+        double min_dist = numeric_limits<double>::infinity();
+        for (uint32_t i = 0; i < n; ++i) {
+            double d = dist(i, centro_x, centro_y);
+            if (d < min_dist) { i0 = i; min_dist = d; }
+        }
+        min_dist = numeric_limits<double>::infinity();
+        for (uint32_t i = 0; i < n; ++i) {
+            double d = dist(i, x(i0), y(i0));
+            if (i != i0 && d > 0 && d < min_dist) { i1 = i; min_dist = d; }
+        }
+        double min_radio = numeric_limits<double>::infinity();
+        if (i1 != i0) {
+            for (uint32_t i = 0; i < n; ++i) {
+                if (i == i0 || i == i1) continue;
+                double r = radio_circunscrito(x(i0), y(i0), x(i1), y(i1), x(i), y(i));
+                if (r < min_radio) { i2 = i; min_radio = r; }
+            }
+        }
+        if (min_radio == numeric_limits<double>::infinity()) {
+            cadena_colineal();
+            return;
+        }
+
+        // los triángulos se guardan en sentido horario
+        if (antihorario(x(i0), y(i0), x(i1), y(i1), x(i2), y(i2))) {
+            swap(i1, i2);
+        }
+        tie(cx, cy) = circuncentro(x(i0), y(i0), x(i1), y(i1), x(i2), y(i2));
+
+        // orden de inserción: distancia al circuncentro de la semilla; los empates se
+        // ordenan por coordenadas para que los puntos repetidos queden contiguos
+        vector<double> distancias(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            distancias[i] = dist(i, cx, cy);
+        }
+        vector<uint32_t> ids(n);
+        iota(ids.begin(), ids.end(), 0);
+        sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+            if (distancias[a] != distancias[b]) return distancias[a] < distancias[b];
+            return x(a) != x(b) ? x(a) < x(b) : y(a) < y(b);
+        });
+        vector<double>().swap(distancias);
+
+        size_t max_semiaristas = 3 * max<size_t>(2 * n - 5, 1);
+        t.triangulos.assign(max_semiaristas, 0);
+        t.opuestas.assign(max_semiaristas, -1);
+        hull_prev.assign(n, 0);
+        hull_next.assign(n, 0);
+        hull_tri.assign(n, 0);
+        hull_hash.assign(static_cast<size_t>(ceil(sqrt(static_cast<double>(n)))), -1);
+
+        hull_start = i0;
+        hull_next[i0] = hull_prev[i2] = i1;
+        hull_next[i1] = hull_prev[i0] = i2;
+        hull_next[i2] = hull_prev[i1] = i0;
+        hull_tri[i0] = 0;
+        hull_tri[i1] = 1;
+        hull_tri[i2] = 2;
+        hull_hash[clave_hash(x(i0), y(i0))] = static_cast<int32_t>(i0);
+        hull_hash[clave_hash(x(i1), y(i1))] = static_cast<int32_t>(i1);
+        hull_hash[clave_hash(x(i2), y(i2))] = static_cast<int32_t>(i2);
+        agregar_triangulo(i0, i1, i2, -1, -1, -1);
+
+        vector<uint32_t> omitidos;
+        vector<bool> triangulado(n, false);
+        triangulado[i0] = triangulado[i1] = triangulado[i2] = true;
+        uint32_t anterior = 0;
+        for (size_t k = 0; k < n; ++k) {
+            uint32_t i = ids[k];
+            double px = x(i), py = y(i);
+
+            // punto repetido: se conecta al que repite
+            if (k > 0 && fabs(px - x(anterior)) <= EPSILON && fabs(py - y(anterior)) <= EPSILON) {
+                t.extra.emplace_back(i, anterior);
+                continue;
+            }
+            anterior = i;
+
+            if (i == i0 || i == i1 || i == i2) continue;
+
+            // arista visible de la envoltura, partiendo del sector angular del punto
+            uint32_t start = 0;
+            for (size_t j = 0, clave = clave_hash(px, py); j < hull_hash.size(); ++j) {
+                int32_t candidato = hull_hash[(clave + j) % hull_hash.size()];
+                if (candidato != -1 && static_cast<uint32_t>(candidato) != hull_next[candidato]) {
+                    start = static_cast<uint32_t>(candidato);
+                    break;
+                }
+            }
+            start = hull_prev[start];
+            int64_t e = start;
+            uint32_t q;
+            while (q = hull_next[e], !antihorario(px, py, x(e), y(e), x(q), y(q))) {
+                e = q;
+                if (e == start) {
+                    e = -1;
+                    break;
+                }
+            }
+            if (e == -1) { // casi repetido de un vértice de la envoltura: se conecta al final
+                omitidos.push_back(i);
+                continue;
+            }
+            uint32_t ue = static_cast<uint32_t>(e);
+
+            // primer triángulo desde el punto
+            uint32_t tri = agregar_triangulo(ue, i, hull_next[ue], -1, -1, static_cast<int32_t>(hull_tri[ue]));
+            hull_tri[i] = legalizar(tri + 2);
+            hull_tri[ue] = tri;
+
+            // avanza por la envoltura agregando triángulos mientras las aristas sean visibles
+            uint32_t siguiente = hull_next[ue];
+            while (q = hull_next[siguiente], antihorario(px, py, x(siguiente), y(siguiente), x(q), y(q))) {
+                tri = agregar_triangulo(siguiente, i, q, static_cast<int32_t>(hull_tri[i]), -1,
+                                        static_cast<int32_t>(hull_tri[siguiente]));
+                hull_tri[i] = legalizar(tri + 2);
+                hull_next[siguiente] = siguiente;
+                siguiente = q;
+            }
+
+            // y retrocede desde el otro lado
+            if (ue == start) {
+                while (q = hull_prev[ue], antihorario(px, py, x(q), y(q), x(ue), y(ue))) {
+                    tri = agregar_triangulo(q, i, ue, -1, static_cast<int32_t>(hull_tri[ue]),
+                                            static_cast<int32_t>(hull_tri[q]));
+                    legalizar(tri + 2);
+                    hull_tri[q] = tri;
+                    hull_next[ue] = ue;
+                    ue = q;
+                }
+            }
+
+            hull_start = hull_prev[i] = ue;
+            hull_next[ue] = hull_prev[siguiente] = i;
+            hull_next[i] = siguiente;
+
+            hull_hash[clave_hash(px, py)] = static_cast<int32_t>(i);
+            triangulado[i] = true;
+            hull_hash[clave_hash(x(ue), y(ue))] = static_cast<int32_t>(ue);
+        }
+
+        t.triangulos.resize(num_semiaristas);
+        t.opuestas.resize(num_semiaristas);
+        t.triangulos.shrink_to_fit();
+        t.opuestas.shrink_to_fit();
+
+        // los omitidos (muy raros) se unen al vértice triangulado más cercano; no a otro
+        // punto fuera de la triangulación, que podría estar unido de vuelta a él
+        if (!omitidos.empty()) {
+            for (uint32_t i : omitidos) {
+                uint32_t mejor = i;
+                double mejor_dist = numeric_limits<double>::infinity();
+                for (uint32_t j = 0; j < n; ++j) {
+                    double d = dist(j, x(i), y(i));
+                    if (triangulado[j] && d < mejor_dist) { mejor = j; mejor_dist = d; }
+                }
+                t.extra.emplace_back(i, mejor);
+            }
+        }
+    }
+}
+
+namespace DelaunayUtils {
+
+    Triangulacion triangular(const vector<Punto*>& puntos) {
+        vector<double> coords(2 * puntos.size());
+        for (size_t i = 0; i < puntos.size(); ++i) {
+            coords[2 * i] = puntos[i]->getX();
+            coords[2 * i + 1] = puntos[i]->getY();
+        }
+        Triangulacion t;
+        ConstructorDelaunay(coords, t).construir();
+        return t;
+    }
+
+    vector<pair<uint32_t, uint32_t>> getParesDelaunay(const vector<Punto*>& puntos) {
+        Triangulacion t = triangular(puntos);
+        vector<pair<uint32_t, uint32_t>> pares;
+        pares.reserve(t.triangulos.size() / 2 + t.extra.size() + 3);
+
+        // cada arista interior aparece como dos semiaristas gemelas: se toma la de índice mayor
+        for (size_t e = 0; e < t.triangulos.size(); ++e) {
+            if (static_cast<int64_t>(e) > t.opuestas[e]) {
+                size_t siguiente = e % 3 == 2 ? e - 2 : e + 1;
+                pares.emplace_back(t.triangulos[e], t.triangulos[siguiente]);
+            }
+        }
+        pares.insert(pares.end(), t.extra.begin(), t.extra.end());
+        return pares;
+    }
+}
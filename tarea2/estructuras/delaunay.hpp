@@ -0,0 +1,60 @@
+/** \file delaunay.hpp
+ *  \brief Triangulación de Delaunay en el plano y aristas candidatas para el MST euclidiano.
+ *
+ *  La triangulación adapta Delaunator (licencia ISC, ver delaunay.cpp).
+ */
+#ifndef DELAUNAY_HPP
+#define DELAUNAY_HPP
+
+#include "aristas.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ *  \struct Triangulacion
+ *  \brief Triangulación en formato de semiaristas.
+ *
+ *  La semiarista e va del vértice triangulos[e] al vértice del siguiente lado del mismo
+ *  triángulo (e + 1, o e - 2 al final del triángulo). opuestas[e] es la semiarista
+ *  gemela del triángulo vecino, o -1 si e está en la envoltura convexa.
+ */
+struct Triangulacion {
+    vector<uint32_t> triangulos;            ///< Tres índices de punto por triángulo
+    vector<int32_t> opuestas;               ///< Semiarista gemela de cada semiarista (-1 en el borde)
+    vector<pair<uint32_t, uint32_t>> extra; ///< Aristas fuera de los triángulos: puntos repetidos u omitidos, o entrada colineal
+
+    /** \brief Cantidad de triángulos. */
+    size_t num_triangulos() const { return triangulos.size() / 3; }
+};
+
+namespace DelaunayUtils
+{
+    /**
+     *  \brief Triangula los puntos con el algoritmo de barrido radial (sweep-hull).
+     *
+     *  Los puntos se insertan en orden de distancia al circuncentro de un triángulo
+     *  semilla; cada uno queda fuera de la envoltura actual, así que basta con unirlo
+     *  a las aristas visibles (encontradas con una tabla hash por ángulo) y legalizar
+     *  con flips. Tiempo esperado O(n log n), memoria O(n).
+     *
+     *  Los puntos repetidos no entran a la triangulación: se conectan al punto que
+     *  repiten con una arista en extra. Si todos son colineales no hay triángulos y extra
+     *  es la cadena de puntos ordenados sobre la recta.
+     *
+     *  \param puntos Vector de punteros a puntos.
+     *  \return Triangulación con índices sobre puntos.
+     */
+    Triangulacion triangular(const vector<Punto*>& puntos);
+
+    /**
+     *  \brief Aristas de la triangulación de Delaunay (más las extra) como pares de índices, sin ordenar.
+     *  \param puntos Vector de punteros a puntos.
+     *  \return Pares de índices sobre puntos, cada arista una vez.
+     */
+    vector<pair<uint32_t, uint32_t>> getParesDelaunay(const vector<Punto*>& puntos);
+}
+
+#endif
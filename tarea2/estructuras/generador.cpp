@@ -0,0 +1,132 @@
+#include "generador.hpp"
+#include "paralelo.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace {
+
+    const size_t TAM_BLOQUE = 4096;   ///< Puntos por bloque (cada bloque tiene su propio generador)
+    const double PI = 3.14159265358979323846;
+
+    /** \brief Generador del bloque b: depende solo de la semilla, la distribución y b. */
+    mt19937_64 motor(const ConfigGenerador& config, uint64_t bloque) {
+        seed_seq semillas{static_cast<uint32_t>(config.semilla), static_cast<uint32_t>(config.semilla >> 32),
+                          static_cast<uint32_t>(config.distribucion),
+                          static_cast<uint32_t>(bloque), static_cast<uint32_t>(bloque >> 32)};
+        return mt19937_64(semillas);
+    }
+
+    /** \brief Posición en la curva c para el parámetro t en [0, 1). */
+    pair<double, double> punto_en_curva(unsigned c, double t) {
+        switch (c % 3) {
+            case 0: { // círculo
+                double radio = 0.1 + 0.05 * (c % 4);
+                double cx = 0.25 + 0.5 * ((c / 3) % 2);
+                double cy = 0.25 + 0.5 * ((c / 6) % 2);
+                return {cx + radio * cos(2 * PI * t), cy + radio * sin(2 * PI * t)};
+            }
+            case 1: { // sinusoide de lado a lado
+                double base = 0.2 + 0.6 * ((c * 37) % 11) / 10.0;
+                return {t, base + 0.08 * sin(2 * PI * (2 + c % 3) * t)};
+            }
+            default: { // espiral de Arquímedes
+                double angulo = 6 * PI * t;
+                return {0.5 + 0.4 * t * cos(angulo + c), 0.5 + 0.4 * t * sin(angulo + c)};
+            }
+        }
+    }
+}
+
+namespace GeneradorPuntos {
+
+    void generar_coordenadas(size_t n, const ConfigGenerador& config, vector<double>& xs, vector<double>& ys) {
+        xs.resize(n);
+        ys.resize(n);
+        unsigned hilos = max(1u, config.hilos);
+
+        // datos compartidos por todos los bloques, sacados del bloque "-1"
+        vector<pair<double, double>> centros;
+        if (config.distribucion == Distribucion::CLUSTERS || config.distribucion == Distribucion::DUPLICADOS) {
+            size_t cantidad = config.distribucion == Distribucion::CLUSTERS
+                ? max<size_t>(1, config.clusters)
+                : max<size_t>(1, static_cast<size_t>(config.fraccion_sitios * n));
+            mt19937_64 gen = motor(config, numeric_limits<uint64_t>::max());
+            double margen = config.distribucion == Distribucion::CLUSTERS ? 0.1 : 0;
+            uniform_real_distribution<double> unif(margen, 1 - margen);
+            centros.resize(cantidad);
+            for (auto& [cx, cy] : centros) {
+                cx = unif(gen);
+                cy = unif(gen);
+            }
+        }
+        size_t lado = max<size_t>(1, static_cast<size_t>(ceil(sqrt(static_cast<double>(n)))));
+
+        size_t bloques = (n + TAM_BLOQUE - 1) / TAM_BLOQUE;
+        Paralelo::en_paralelo(hilos, [&](unsigned k) {
+            for (size_t b = k; b < bloques; b += hilos) {
+                mt19937_64 gen = motor(config, b);
+                uniform_real_distribution<double> unif(0.0, 1.0);
+                size_t fin = min(n, (b + 1) * TAM_BLOQUE);
+
+                for (size_t i = b * TAM_BLOQUE; i < fin; ++i) {
+                    switch (config.distribucion) {
+                        case Distribucion::UNIFORME:
+                            xs[i] = unif(gen);
+                            ys[i] = unif(gen);
+                            break;
+                        case Distribucion::CLUSTERS: {
+                            normal_distribution<double> normal(0.0, config.sigma);
+                            const auto& [cx, cy] = centros[gen() % centros.size()];
+                            xs[i] = cx + normal(gen);
+                            ys[i] = cy + normal(gen);
+                            break;
+                        }
+                        case Distribucion::CURVAS: {
+                            normal_distribution<double> normal(0.0, config.ruido);
+                            auto [x, y] = punto_en_curva(static_cast<unsigned>(gen() % max(1u, config.curvas)), unif(gen));
+                            xs[i] = x + normal(gen);
+                            ys[i] = y + normal(gen);
+                            break;
+                        }
+                        case Distribucion::GRILLA: {
+                            uniform_real_distribution<double> desplazamiento(-config.perturbacion, config.perturbacion);
+                            xs[i] = ((i % lado) + 0.5 + desplazamiento(gen)) / lado;
+                            ys[i] = ((i / lado) + 0.5 + desplazamiento(gen)) / lado;
+                            break;
+                        }
+                        case Distribucion::DUPLICADOS: {
+                            const auto& [cx, cy] = centros[gen() % centros.size()];
+                            xs[i] = cx;
+                            ys[i] = cy;
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    vector<Punto> generar(size_t n, const ConfigGenerador& config) {
+        vector<double> xs, ys;
+        generar_coordenadas(n, config, xs, ys);
+        vector<Punto> puntos;
+        puntos.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            puntos.emplace_back(xs[i], ys[i]);
+        }
+        return puntos;
+    }
+
+    const char* nombre(Distribucion distribucion) {
+        switch (distribucion) {
+            case Distribucion::UNIFORME: return "Uniforme";
+            case Distribucion::CLUSTERS: return "Clusters";
+            case Distribucion::CURVAS: return "Curvas";
+            case Distribucion::GRILLA: return "Grilla";
+            case Distribucion::DUPLICADOS: return "Duplicados";
+        }
+        return "";
+    }
+}
@@ -0,0 +1,69 @@
+/** \file generador.hpp
+ *  \brief Generación masiva y reproducible de puntos (semilla) con varias distribuciones.
+ */
+#ifndef GENERADOR_HPP
+#define GENERADOR_HPP
+
+#include "puntos.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ *  \enum Distribucion
+ *  \brief Distribución de los puntos generados.
+ */
+enum class Distribucion {
+    UNIFORME,   ///< Uniforme en el cuadrado unitario
+    CLUSTERS,   ///< Mezcla de gaussianas alrededor de centros uniformes
+    CURVAS,     ///< Sobre círculos, sinusoides y espirales, con ruido pequeño
+    GRILLA,     ///< Grilla regular con perturbación (muchos empates de peso)
+    DUPLICADOS  ///< Pocos sitios distintos, cada punto repite uno (~90% repetidos)
+};
+
+/**
+ *  \struct ConfigGenerador
+ *  \brief Parámetros del generador; con la misma configuración y n se obtienen los mismos puntos.
+ */
+struct ConfigGenerador {
+    Distribucion distribucion = Distribucion::UNIFORME; ///< Distribución
+    uint64_t semilla = 1;                               ///< Semilla
+    unsigned hilos = 1;                                 ///< Hilos (no cambia el resultado)
+    unsigned clusters = 16;                             ///< CLUSTERS: cantidad de centros
+    double sigma = 0.02;                                ///< CLUSTERS: desviación de cada gaussiana
+    unsigned curvas = 6;                                ///< CURVAS: cantidad de curvas
+    double ruido = 1e-4;                                ///< CURVAS: desviación del ruido gaussiano sobre la curva
+    double perturbacion = 0.1;                          ///< GRILLA: desplazamiento máximo, en fracciones de celda
+    double fraccion_sitios = 0.1;                       ///< DUPLICADOS: sitios distintos / n
+};
+
+namespace GeneradorPuntos
+{
+    /**
+     *  \brief Llena xs e ys con n puntos.
+     *
+     *  Los puntos se generan en bloques de tamaño fijo, cada uno con su propio mt19937_64
+     *  sembrado con (semilla, distribución, bloque); los hilos se reparten los bloques,
+     *  así que el resultado no depende de la cantidad de hilos.
+     *  \param n Cantidad de puntos.
+     *  \param config Distribución, semilla, hilos y parámetros.
+     *  \param xs Coordenadas X (se redimensiona a n).
+     *  \param ys Coordenadas Y (se redimensiona a n).
+     */
+    void generar_coordenadas(size_t n, const ConfigGenerador& config, vector<double>& xs, vector<double>& ys);
+
+    /**
+     *  \brief Genera n puntos (ver generar_coordenadas).
+     *  \param n Cantidad de puntos.
+     *  \param config Distribución, semilla, hilos y parámetros.
+     *  \return Vector de n puntos.
+     */
+    vector<Punto> generar(size_t n, const ConfigGenerador& config);
+
+    /** \brief Nombre de la distribución, para consola y CSV. */
+    const char* nombre(Distribucion distribucion);
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include "indice_espacial.hpp"
+#include <numeric>
+
+ArbolKD::ArbolKD(const vector<Punto*>& puntos) {
+    size_t n = puntos.size();
+    if (n == 0) return;
+    // se construye sobre copias de las coordenadas (sin saltar por Punto*) y al final se permutan
+    vector<double> x(n), y(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = puntos[i]->getX();
+        y[i] = puntos[i]->getY();
+    }
+    vector<uint32_t> orden(n);
+    iota(orden.begin(), orden.end(), 0);
+    nodos.reserve(n / (HOJA / 2) + 1);
+    nodos.emplace_back();
+    construir(orden, x, y, 0, 0, static_cast<uint32_t>(n));
+
+    xs.resize(n);
+    ys.resize(n);
+    for (size_t pos = 0; pos < n; ++pos) {
+        xs[pos] = x[orden[pos]];
+        ys[pos] = y[orden[pos]];
+    }
+    original_ = move(orden);
+    etiquetas.resize(n);
+    iota(etiquetas.begin(), etiquetas.end(), 0);
+}
+
+void ArbolKD::construir(vector<uint32_t>& orden, const vector<double>& x, const vector<double>& y, uint32_t id, uint32_t inicio, uint32_t fin) {
+    Nodo nodo;
+    nodo.xmin = nodo.ymin = numeric_limits<double>::infinity();
+    nodo.xmax = nodo.ymax = -numeric_limits<double>::infinity();
+    for (uint32_t pos = inicio; pos < fin; ++pos) {
+        nodo.xmin = min(nodo.xmin, x[orden[pos]]);
+        nodo.xmax = max(nodo.xmax, x[orden[pos]]);
+        nodo.ymin = min(nodo.ymin, y[orden[pos]]);
+        nodo.ymax = max(nodo.ymax, y[orden[pos]]);
+    }
+    nodo.inicio = inicio;
+    nodo.fin = fin;
+    nodo.hijo = SIN_HIJOS;
+    nodo.etiqueta = fin - inicio == 1 ? inicio : IndiceEspacial::SIN_ETIQUETA;
+
+    if (fin - inicio > HOJA) {
+        // mediana de la dimensión más ancha (la misma que usa vecinos para elegir el hijo cercano)
+        const vector<double>& coordenada = nodo.xmax - nodo.xmin >= nodo.ymax - nodo.ymin ? x : y;
+        uint32_t medio = inicio + (fin - inicio) / 2;
+        nth_element(orden.begin() + inicio, orden.begin() + medio, orden.begin() + fin,
+                    [&](uint32_t a, uint32_t b) { return coordenada[a] < coordenada[b]; });
+        // los dos hijos quedan contiguos; sus descendientes van después
+        nodo.hijo = static_cast<uint32_t>(nodos.size());
+        nodos.resize(nodos.size() + 2);
+        construir(orden, x, y, nodo.hijo, inicio, medio);
+        construir(orden, x, y, nodo.hijo + 1, medio, fin);
+    }
+    nodos[id] = nodo;
+}
+
+void ArbolKD::etiquetar(const vector<uint32_t>& etiqueta) {
+    etiquetas = etiqueta;
+    // los hijos siempre tienen índice mayor que el padre: de atrás hacia adelante
+    for (size_t id = nodos.size(); id-- > 0;) {
+        Nodo& nodo = nodos[id];
+        if (nodo.hijo == SIN_HIJOS) {
+            nodo.etiqueta = etiquetas[nodo.inicio];
+            for (uint32_t pos = nodo.inicio + 1; pos < nodo.fin; ++pos) {
+                if (etiquetas[pos] != nodo.etiqueta) {
+                    nodo.etiqueta = IndiceEspacial::SIN_ETIQUETA;
+                    break;
+                }
+            }
+        } else {
+            uint32_t a = nodos[nodo.hijo].etiqueta;
+            nodo.etiqueta = a == nodos[nodo.hijo + 1].etiqueta ? a : IndiceEspacial::SIN_ETIQUETA;
+        }
+    }
+}
+
+size_t ArbolKD::bytes() const {
+    return nodos.capacity() * sizeof(Nodo) + (xs.capacity() + ys.capacity()) * sizeof(double)
+           + (original_.capacity() + etiquetas.capacity()) * sizeof(uint32_t);
+}
+
+GrillaUniforme::GrillaUniforme(const vector<Punto*>& puntos, double puntos_por_celda) {
+    size_t n = puntos.size();
+    if (n == 0) {
+        inicio_celda.assign(2, 0);
+        etiqueta_celda.assign(1, IndiceEspacial::SIN_ETIQUETA);
+        return;
+    }
+    double xmax = -numeric_limits<double>::infinity(), ymax = xmax;
+    x0 = y0 = numeric_limits<double>::infinity();
+    for (const Punto* p : puntos) {
+        x0 = min(x0, p->getX());
+        y0 = min(y0, p->getY());
+        xmax = max(xmax, p->getX());
+        ymax = max(ymax, p->getY());
+    }
+    double ancho = xmax - x0, alto = ymax - y0;
+    double extension = max(ancho, alto);
+    if (extension > 0) {
+        // celdas cuadradas de área puntos_por_celda / densidad (sobre la caja, con lado no nulo)
+        lado = sqrt(max(ancho, extension * 1e-3) * max(alto, extension * 1e-3) * puntos_por_celda / n);
+        columnas = max<size_t>(1, static_cast<size_t>(ceil(ancho / lado)));
+        filas = max<size_t>(1, static_cast<size_t>(ceil(alto / lado)));
+        margen = 1e-9 * lado;
+    }
+
+    // orden por celda (counting sort)
+    size_t celdas = columnas * filas;
+    vector<uint32_t> celda(n);
+    inicio_celda.assign(celdas + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        celda[i] = static_cast<uint32_t>(celda_y(puntos[i]->getY()) * columnas + celda_x(puntos[i]->getX()));
+        ++inicio_celda[celda[i] + 1];
+    }
+    partial_sum(inicio_celda.begin(), inicio_celda.end(), inicio_celda.begin());
+    vector<uint32_t> siguiente(inicio_celda.begin(), inicio_celda.end() - 1);
+    xs.resize(n);
+    ys.resize(n);
+    original_.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t pos = siguiente[celda[i]]++;
+        xs[pos] = puntos[i]->getX();
+        ys[pos] = puntos[i]->getY();
+        original_[pos] = static_cast<uint32_t>(i);
+    }
+    etiquetas.resize(n);
+    iota(etiquetas.begin(), etiquetas.end(), 0);
+    etiqueta_celda.resize(celdas);
+    etiquetar_celdas();
+}
+
+void GrillaUniforme::etiquetar(const vector<uint32_t>& etiqueta) {
+    etiquetas = etiqueta;
+    etiquetar_celdas();
+}
+
+void GrillaUniforme::etiquetar_celdas() {
+    for (size_t c = 0; c + 1 < inicio_celda.size(); ++c) {
+        uint32_t comun = IndiceEspacial::SIN_ETIQUETA;
+        for (uint32_t pos = inicio_celda[c]; pos < inicio_celda[c + 1]; ++pos) {
+            if (pos == inicio_celda[c]) {
+                comun = etiquetas[pos];
+            } else if (etiquetas[pos] != comun) {
+                comun = IndiceEspacial::SIN_ETIQUETA;
+                break;
+            }
+        }
+        etiqueta_celda[c] = comun;
+    }
+}
+
+size_t GrillaUniforme::bytes() const {
+    return (inicio_celda.capacity() + etiqueta_celda.capacity() + original_.capacity() + etiquetas.capacity()) * sizeof(uint32_t)
+           + (xs.capacity() + ys.capacity()) * sizeof(double);
+}
@@ -0,0 +1,296 @@
+/** \file indice_espacial.hpp
+ *  \brief Índices espaciales (árbol k-d y grilla uniforme) para consultas de k vecinos más cercanos.
+ */
+#ifndef INDICE_ESPACIAL_HPP
+#define INDICE_ESPACIAL_HPP
+
+#include "puntos.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+/**
+ *  \struct Vecino
+ *  \brief Candidato de una consulta: peso (distancia al cuadrado) y posición del punto en el índice.
+ *
+ *  Se ordena por (peso, posición): es un orden total aunque haya puntos repetidos o a la
+ *  misma distancia, así que "los k siguientes después de uno dado" siempre avanza.
+ */
+struct Vecino {
+    double peso;     ///< Distancia al cuadrado al punto consultado
+    uint32_t posicion; ///< Posición del punto en el índice (ver original)
+};
+
+inline bool operator<(const Vecino& a, const Vecino& b) {
+    return a.peso < b.peso || (a.peso == b.peso && a.posicion < b.posicion);
+}
+
+namespace IndiceEspacial
+{
+    const uint32_t SIN_ETIQUETA = numeric_limits<uint32_t>::max(); ///< Nodo o celda con puntos de varias etiquetas
+
+    /** \brief Antes de cualquier Vecino: para pedir los k más cercanos. */
+    const Vecino DESDE_INICIO = {-1.0, 0};
+
+    /**
+     *  \brief Agrega c a los k mejores, guardados como max-heap en mejores[0..encontrados).
+     *  \return Nueva cantidad de encontrados.
+     */
+    inline size_t agregar_mejor(Vecino* mejores, size_t encontrados, size_t k, Vecino c) {
+        if (encontrados < k) {
+            mejores[encontrados++] = c;
+            push_heap(mejores, mejores + encontrados);
+        } else if (c < mejores[0]) {
+            pop_heap(mejores, mejores + k);
+            mejores[k - 1] = c;
+            push_heap(mejores, mejores + k);
+        }
+        return encontrados;
+    }
+}
+
+/**
+ *  \class ArbolKD
+ *  \brief Árbol k-d sobre los puntos, con coordenadas copiadas en el orden de las hojas.
+ *
+ *  Cada nodo parte sus puntos por la mediana de la dimensión más ancha de su caja, hasta
+ *  hojas de a lo más HOJA puntos. Cada punto y cada nodo llevan una etiqueta (la componente
+ *  del punto, o SIN_ETIQUETA si el nodo mezcla varias), que permite descartar subárboles
+ *  enteros en las consultas.
+ */
+class ArbolKD {
+private:
+    static const size_t HOJA = 8;                       ///< Máximo de puntos por hoja
+    static const uint32_t SIN_HIJOS = numeric_limits<uint32_t>::max();
+
+    struct Nodo {
+        double xmin, xmax, ymin, ymax; ///< Caja de los puntos del nodo
+        uint32_t inicio, fin;          ///< Posiciones [inicio, fin) de sus puntos
+        uint32_t hijo;                 ///< Hijo izquierdo (el derecho es hijo + 1); SIN_HIJOS en hojas
+        uint32_t etiqueta;             ///< Etiqueta común de sus puntos, o SIN_ETIQUETA
+    };
+
+    vector<Nodo> nodos;          ///< nodos[0] es la raíz
+    vector<double> xs;           ///< Coordenada X, en orden de hojas
+    vector<double> ys;           ///< Coordenada Y, en orden de hojas
+    vector<uint32_t> original_;  ///< Índice original del punto en cada posición
+    vector<uint32_t> etiquetas;  ///< Etiqueta del punto en cada posición
+
+    /** \brief Llena el nodo id con los puntos orden[inicio, fin) (coordenadas x, y) y, si no es hoja, sus descendientes. */
+    void construir(vector<uint32_t>& orden, const vector<double>& x, const vector<double>& y, uint32_t id, uint32_t inicio, uint32_t fin);
+
+public:
+    /**
+     *  \brief Construye el árbol; la etiqueta inicial de cada punto es su posición.
+     *  \param puntos Vector de punteros a puntos.
+     */
+    explicit ArbolKD(const vector<Punto*>& puntos);
+
+    /** \brief Cantidad de puntos. */
+    size_t size() const { return original_.size(); }
+
+    /** \brief Índice en el vector original del punto en la posición pos. */
+    uint32_t original(uint32_t pos) const { return original_[pos]; }
+
+    /** \brief Peso (distancia al cuadrado) entre las posiciones a y b; igual a PuntoUtils::getWeight. */
+    double distancia(uint32_t a, uint32_t b) const {
+        double dx = xs[a] - xs[b];
+        double dy = ys[a] - ys[b];
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     *  \brief Reemplaza las etiquetas y recalcula las de los nodos, en O(n).
+     *  \param etiqueta Etiqueta de cada punto, por posición.
+     */
+    void etiquetar(const vector<uint32_t>& etiqueta);
+
+    /** \brief Bytes de memoria del índice. */
+    size_t bytes() const;
+
+    /**
+     *  \brief Los k vecinos de la posición propio siguientes a desde, en orden (peso, posición).
+     *
+     *  Considera los puntos distintos de propio, con (peso, posición) mayor que desde, peso
+     *  a lo más limite y cuya etiqueta e cumple fuera(e). Los nodos con etiqueta común que
+     *  no cumple fuera se descartan enteros, igual que los que están más lejos que el
+     *  k-ésimo encontrado (o que limite) o completamente más cerca que desde.
+     *  \param propio Posición del punto consultado (se excluye).
+     *  \param k Cantidad pedida.
+     *  \param desde Cota inferior exclusiva (IndiceEspacial::DESDE_INICIO para los k más cercanos).
+     *  \param limite Peso máximo (infinito para no acotar).
+     *  \param fuera Función bool(uint32_t etiqueta).
+     *  \param salida Arreglo de al menos k vecinos; queda ordenado.
+     *  \return Cantidad encontrada (menos de k si no hay más puntos que cumplan).
+     */
+    template <class Fuera>
+    size_t vecinos(uint32_t propio, size_t k, Vecino desde, double limite, Fuera&& fuera, Vecino* salida) const {
+        size_t encontrados = 0;
+        if (k == 0 || nodos.empty()) return 0;
+        double px = xs[propio], py = ys[propio];
+        auto peor = [&] { return encontrados < k ? limite : salida[0].peso; };
+
+        uint32_t pila[128];
+        size_t tope = 0;
+        pila[tope++] = 0;
+        while (tope > 0) {
+            const Nodo& nodo = nodos[pila[--tope]];
+            double cx = px < nodo.xmin ? nodo.xmin - px : (px > nodo.xmax ? px - nodo.xmax : 0);
+            double cy = py < nodo.ymin ? nodo.ymin - py : (py > nodo.ymax ? py - nodo.ymax : 0);
+            if (cx * cx + cy * cy > peor()) continue;
+            double lx = max(px - nodo.xmin, nodo.xmax - px);
+            double ly = max(py - nodo.ymin, nodo.ymax - py);
+            if (lx * lx + ly * ly < desde.peso) continue;
+            if (nodo.etiqueta != IndiceEspacial::SIN_ETIQUETA && !fuera(nodo.etiqueta)) continue;
+
+            if (nodo.hijo == SIN_HIJOS) {
+                for (uint32_t pos = nodo.inicio; pos < nodo.fin; ++pos) {
+                    double dx = xs[pos] - px;
+                    double dy = ys[pos] - py;
+                    Vecino c = {dx * dx + dy * dy, pos};
+                    if (c.posicion == propio || !(desde < c) || c.peso > limite || (encontrados == k && !(c < salida[0]))) continue;
+                    if (!fuera(etiquetas[pos])) continue;
+                    encontrados = IndiceEspacial::agregar_mejor(salida, encontrados, k, c);
+                }
+                continue;
+            }
+            // primero el hijo del lado del punto: se apila último
+            const Nodo& izquierdo = nodos[nodo.hijo];
+            bool izquierdo_cerca = nodo.xmax - nodo.xmin >= nodo.ymax - nodo.ymin ? px <= izquierdo.xmax : py <= izquierdo.ymax;
+            pila[tope++] = izquierdo_cerca ? nodo.hijo + 1 : nodo.hijo;
+            pila[tope++] = izquierdo_cerca ? nodo.hijo : nodo.hijo + 1;
+        }
+        sort_heap(salida, salida + encontrados);
+        return encontrados;
+    }
+};
+
+/**
+ *  \class GrillaUniforme
+ *  \brief Grilla de celdas cuadradas sobre la caja de los puntos, con los puntos ordenados por celda.
+ *
+ *  El lado de la celda se elige para que haya unos pocos puntos por celda si la
+ *  distribución es uniforme. Las consultas recorren anillos de celdas alrededor del
+ *  punto hasta que el anillo siguiente queda más lejos que el k-ésimo encontrado; con
+ *  distribuciones muy concentradas las celdas quedan desbalanceadas y conviene ArbolKD.
+ */
+class GrillaUniforme {
+private:
+    double x0 = 0, y0 = 0;          ///< Esquina inferior izquierda
+    double lado = 1;                ///< Lado de cada celda
+    double margen = 0;              ///< Holgura de las cotas por redondeo al asignar celdas
+    size_t columnas = 1, filas = 1; ///< Dimensiones de la grilla
+    vector<uint32_t> inicio_celda;  ///< Puntos de la celda c: posiciones [inicio_celda[c], inicio_celda[c + 1])
+    vector<uint32_t> etiqueta_celda;///< Etiqueta común de los puntos de cada celda, o SIN_ETIQUETA
+    vector<double> xs;              ///< Coordenada X, en orden de celdas
+    vector<double> ys;              ///< Coordenada Y, en orden de celdas
+    vector<uint32_t> original_;     ///< Índice original del punto en cada posición
+    vector<uint32_t> etiquetas;     ///< Etiqueta del punto en cada posición
+
+    size_t celda_x(double x) const { return min(columnas - 1, static_cast<size_t>(max(0.0, (x - x0) / lado))); }
+    size_t celda_y(double y) const { return min(filas - 1, static_cast<size_t>(max(0.0, (y - y0) / lado))); }
+
+    /** \brief Recalcula etiqueta_celda a partir de etiquetas. */
+    void etiquetar_celdas();
+
+public:
+    /**
+     *  \brief Construye la grilla; la etiqueta inicial de cada punto es su posición.
+     *  \param puntos Vector de punteros a puntos.
+     *  \param puntos_por_celda Promedio buscado de puntos por celda.
+     */
+    explicit GrillaUniforme(const vector<Punto*>& puntos, double puntos_por_celda = 2);
+
+    /** \brief Cantidad de puntos. */
+    size_t size() const { return original_.size(); }
+
+    /** \brief Índice en el vector original del punto en la posición pos. */
+    uint32_t original(uint32_t pos) const { return original_[pos]; }
+
+    /** \brief Peso (distancia al cuadrado) entre las posiciones a y b; igual a PuntoUtils::getWeight. */
+    double distancia(uint32_t a, uint32_t b) const {
+        double dx = xs[a] - xs[b];
+        double dy = ys[a] - ys[b];
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     *  \brief Reemplaza las etiquetas y recalcula las de las celdas, en O(n + celdas).
+     *  \param etiqueta Etiqueta de cada punto, por posición.
+     */
+    void etiquetar(const vector<uint32_t>& etiqueta);
+
+    /** \brief Bytes de memoria del índice. */
+    size_t bytes() const;
+
+    /**
+     *  \brief Los k vecinos de la posición propio siguientes a desde; mismo contrato que ArbolKD::vecinos.
+     *
+     *  Los anillos que quedan completamente más cerca que desde no se recorren.
+     */
+    template <class Fuera>
+    size_t vecinos(uint32_t propio, size_t k, Vecino desde, double limite, Fuera&& fuera, Vecino* salida) const {
+        size_t encontrados = 0;
+        if (k == 0 || original_.empty()) return 0;
+        double px = xs[propio], py = ys[propio];
+        auto peor = [&] { return encontrados < k ? limite : salida[0].peso; };
+
+        long cx = static_cast<long>(celda_x(px));
+        long cy = static_cast<long>(celda_y(py));
+        long r_fin = max(max(cx, static_cast<long>(columnas) - 1 - cx), max(cy, static_cast<long>(filas) - 1 - cy));
+
+        // distancia mínima a las celdas fuera del cuadrado de anillos < r, y máxima a las de anillos <= r
+        auto minima_anillo = [&](long r) {
+            double dx = min(px - (x0 + (cx - r + 1) * lado), x0 + (cx + r) * lado - px);
+            double dy = min(py - (y0 + (cy - r + 1) * lado), y0 + (cy + r) * lado - py);
+            double d = max(0.0, min(dx, dy) - margen);
+            return d * d;
+        };
+        auto maxima_anillo = [&](long r) {
+            double dx = max(px - (x0 + (cx - r) * lado), x0 + (cx + r + 1) * lado - px) + margen;
+            double dy = max(py - (y0 + (cy - r) * lado), y0 + (cy + r + 1) * lado - py) + margen;
+            return dx * dx + dy * dy;
+        };
+
+        auto visitar = [&](long ix, long iy) {
+            if (ix < 0 || iy < 0 || ix >= static_cast<long>(columnas) || iy >= static_cast<long>(filas)) return;
+            size_t c = static_cast<size_t>(iy) * columnas + static_cast<size_t>(ix);
+            if (inicio_celda[c] == inicio_celda[c + 1]) return;
+            double bx = max(0.0, max(x0 + ix * lado - px, px - (x0 + (ix + 1) * lado)) - margen);
+            double by = max(0.0, max(y0 + iy * lado - py, py - (y0 + (iy + 1) * lado)) - margen);
+            if (bx * bx + by * by > peor()) return;
+            if (etiqueta_celda[c] != IndiceEspacial::SIN_ETIQUETA && !fuera(etiqueta_celda[c])) return;
+            for (uint32_t pos = inicio_celda[c]; pos < inicio_celda[c + 1]; ++pos) {
+                double dx = xs[pos] - px;
+                double dy = ys[pos] - py;
+                Vecino v = {dx * dx + dy * dy, pos};
+                if (v.posicion == propio || !(desde < v) || v.peso > limite || (encontrados == k && !(v < salida[0]))) continue;
+                if (!fuera(etiquetas[pos])) continue;
+                encontrados = IndiceEspacial::agregar_mejor(salida, encontrados, k, v);
+            }
+        };
+
+        long r = 0;
+        while (r <= r_fin && maxima_anillo(r) < desde.peso) ++r;
+        for (; r <= r_fin; ++r) {
+            if (r > 0 && minima_anillo(r) > peor()) break;
+            for (long dy = -r; dy <= r; ++dy) {
+                if (dy == -r || dy == r) {
+                    for (long dx = -r; dx <= r; ++dx) visitar(cx + dx, cy + dy);
+                } else {
+                    visitar(cx - r, cy + dy);
+                    if (r > 0) visitar(cx + r, cy + dy);
+                }
+            }
+        }
+        sort_heap(salida, salida + encontrados);
+        return encontrados;
+    }
+};
+
+#endif
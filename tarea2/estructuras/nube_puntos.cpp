@@ -0,0 +1,69 @@
+#include "nube_puntos.hpp"
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    void fila_escalar(const double* xs, const double* ys, size_t m, double px, double py, double* salida) {
+        for (size_t k = 0; k < m; ++k) {
+            double dx = xs[k] - px;
+            double dy = ys[k] - py;
+            salida[k] = dx * dx + dy * dy;
+        }
+    }
+
+#ifdef SIMD_X86
+    // multiplicación y suma separadas (sin FMA, ver -ffp-contract=off en el Makefile): mismo redondeo que PuntoUtils::getWeight
+    __attribute__((target("avx2")))
+    void fila_avx2(const double* xs, const double* ys, size_t m, double px, double py, double* salida) {
+        const __m256d vx = _mm256_set1_pd(px);
+        const __m256d vy = _mm256_set1_pd(py);
+        size_t k = 0;
+        for (; k + 4 <= m; k += 4) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + k), vx);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + k), vy);
+            _mm256_storeu_pd(salida + k, _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+        }
+        fila_escalar(xs + k, ys + k, m - k, px, py, salida + k);
+    }
+
+    __attribute__((target("avx512f")))
+    void fila_avx512(const double* xs, const double* ys, size_t m, double px, double py, double* salida) {
+        const __m512d vx = _mm512_set1_pd(px);
+        const __m512d vy = _mm512_set1_pd(py);
+        size_t k = 0;
+        for (; k + 8 <= m; k += 8) {
+            __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(xs + k), vx);
+            __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(ys + k), vy);
+            _mm512_storeu_pd(salida + k, _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+        }
+        if (k < m) { // cola con máscara, sin código escalar
+            __mmask8 mascara = static_cast<__mmask8>((1u << (m - k)) - 1);
+            __m512d dx = _mm512_sub_pd(_mm512_maskz_loadu_pd(mascara, xs + k), vx);
+            __m512d dy = _mm512_sub_pd(_mm512_maskz_loadu_pd(mascara, ys + k), vy);
+            _mm512_mask_storeu_pd(salida + k, mascara, _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+        }
+    }
+#endif
+}
+
+NubePuntos::NubePuntos(const vector<Punto*>& puntos, KernelSimd kernel)
+    : xs(puntos.size()), ys(puntos.size()), kernel_(Simd::resolver(kernel)) {
+    for (size_t i = 0; i < puntos.size(); ++i) {
+        xs[i] = puntos[i]->getX();
+        ys[i] = puntos[i]->getY();
+    }
+}
+
+void NubePuntos::fila_distancias(size_t i, size_t desde, size_t hasta, double* salida) const {
+    if (desde >= hasta) return;
+    const double* bx = xs.data() + desde;
+    const double* by = ys.data() + desde;
+    size_t m = hasta - desde;
+#ifdef SIMD_X86
+    if (kernel_ == KernelSimd::AVX512) return fila_avx512(bx, by, m, xs[i], ys[i], salida);
+    if (kernel_ == KernelSimd::AVX2) return fila_avx2(bx, by, m, xs[i], ys[i], salida);
+#endif
+    fila_escalar(bx, by, m, xs[i], ys[i], salida);
+}
@@ -0,0 +1,88 @@
+/** \file nube_puntos.hpp
+ *  \brief Nube de puntos en layout SoA (x[] e y[] contiguos) con kernels vectorizados de distancias.
+ */
+#ifndef NUBE_PUNTOS_HPP
+#define NUBE_PUNTOS_HPP
+
+#include "aristas.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ *  \class NubePuntos
+ *  \brief Coordenadas de un conjunto de puntos en dos arreglos contiguos.
+ *
+ *  Punto guarda x, y y un puntero en el mismo objeto, y las distancias se calculan de a
+ *  una a través de Punto*. Aquí una fila de distancias (un punto contra un bloque de
+ *  puntos) se calcula con un kernel escalar, AVX2 (4 por instrucción) o AVX-512 (8),
+ *  leyendo memoria secuencial. Los pesos son idénticos a los de PuntoUtils::getWeight.
+ */
+class NubePuntos {
+private:
+    vector<double> xs;  ///< Coordenada X de cada punto
+    vector<double> ys;  ///< Coordenada Y de cada punto
+    KernelSimd kernel_; ///< Kernel resuelto (nunca AUTO)
+
+public:
+    /**
+     *  \brief Copia las coordenadas de los puntos, en el mismo orden.
+     *  \param puntos Vector de punteros a puntos.
+     *  \param kernel Kernel pedido (AUTO: el mejor que soporte la CPU).
+     */
+    explicit NubePuntos(const vector<Punto*>& puntos, KernelSimd kernel = KernelSimd::AUTO);
+
+    /** \brief Cantidad de puntos. */
+    size_t size() const { return xs.size(); }
+
+    /** \brief Kernel que se usa para las filas de distancias. */
+    KernelSimd kernel() const { return kernel_; }
+
+    /** \brief Peso (distancia al cuadrado) entre los puntos i y j. */
+    double distancia(size_t i, size_t j) const {
+        double dx = xs[i] - xs[j];
+        double dy = ys[i] - ys[j];
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     *  \brief Fila de distancias: salida[k] = peso(i, desde + k) para k en [0, hasta - desde).
+     *  \param i Punto de referencia.
+     *  \param desde Primer punto del bloque.
+     *  \param hasta Punto siguiente al último del bloque.
+     *  \param salida Arreglo de al menos hasta - desde doubles.
+     */
+    void fila_distancias(size_t i, size_t desde, size_t hasta, double* salida) const;
+
+    /**
+     *  \brief Recorre las aristas del grafo completo en las posiciones [inicio, fin) de la lista,
+     *  en el orden de AristaUtils::getAristas, con su peso calculado por filas.
+     *  \param inicio Primera posición (ver AristaUtils::desplazamientoFila).
+     *  \param fin Posición siguiente a la última.
+     *  \param f Función void(size_t posicion, uint32_t i, uint32_t j, double peso).
+     */
+    template <class F>
+    void recorrer_aristas(size_t inicio, size_t fin, F&& f) const {
+        if (inicio >= fin) return;
+        size_t n = size();
+        vector<double> fila(min(n, fin - inicio));
+        size_t i = AristaUtils::filaDeArista(inicio, n);
+        size_t j = i + 1 + (inicio - AristaUtils::desplazamientoFila(i, n));
+        size_t e = inicio;
+        while (e < fin) {
+            size_t hasta = min(n, j + (fin - e));
+            fila_distancias(i, j, hasta, fila.data());
+            for (size_t k = j; k < hasta; ++k) {
+                f(e++, static_cast<uint32_t>(i), static_cast<uint32_t>(k), fila[k - j]);
+            }
+            ++i;
+            j = i + 1;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,50 @@
+/** \file paralelo.hpp
+ *  \brief Utilidades mínimas para repartir trabajo entre hilos.
+ */
+#ifndef PARALELO_HPP
+#define PARALELO_HPP
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace Paralelo
+{
+    /**
+     *  \brief Ejecuta f(k) para k = 0..hilos-1, cada uno en su propio hilo, y espera a que terminen.
+     *
+     *  f(0) corre en el hilo que llama, así que con hilos = 1 no se crea ningún hilo.
+     *  \param hilos Cantidad de hilos (0 se toma como 1).
+     *  \param f Función void(unsigned k).
+     */
+    template <class F>
+    void en_paralelo(unsigned hilos, F&& f) {
+        if (hilos <= 1) {
+            f(0u);
+            return;
+        }
+        vector<thread> trabajadores;
+        trabajadores.reserve(hilos - 1);
+        for (unsigned k = 1; k < hilos; ++k) {
+            trabajadores.emplace_back([&f, k] { f(k); });
+        }
+        f(0u);
+        for (thread& t : trabajadores) {
+            t.join();
+        }
+    }
+
+    /**
+     *  \brief Inicio del tramo k al dividir m elementos en partes casi iguales.
+     *  \param m Cantidad de elementos.
+     *  \param k Tramo (0..partes).
+     *  \param partes Cantidad de tramos.
+     */
+    inline size_t inicio_tramo(size_t m, size_t k, size_t partes) {
+        return static_cast<size_t>(static_cast<unsigned __int128>(m) * k / partes);
+    }
+}
+
+#endif
@@ -14,6 +14,8 @@ Punto::Punto():
 	}()),
 	padre(this) {}
 
+Punto::Punto(double x, double y): x(x), y(y), padre(this) {}
+
 /*
 Punto* Punto::find_rep() {
 	if (padre != this) {
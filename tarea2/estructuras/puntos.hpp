@@ -27,36 +27,27 @@ class Punto {
          *  \brief Construye un punto vacío con coordenadas (0,0) y padre nullptr.
          */
         Punto();
+
+        /**
+         *  \brief Construye un punto con coordenadas dadas (para generadores con semilla).
+         *  \param x Coordenada X.
+         *  \param y Coordenada Y.
+         */
+        Punto(double x, double y);
         
         /** \brief Obtiene la coordenada X.
          *  \return Valor de la coordenada X.
          */
         double getX() const { return x; };
 
-<<<<<<< HEAD
-//            Punto* find_rep();
-
-//            void set_padre(Punto* nuevo_padre);
-=======
         /** \brief Obtiene la coordenada Y.
          *  \return Valor de la coordenada Y.
          */
         double getY() const { return y; };
 
-        /**
-         *  \brief Encuentra el representante del conjunto al que pertenece este punto.
-         *
-         *  Realiza búsqueda sin compresión de camino.
-         *  \return Puntero al representante del conjunto.
-         */
-        Punto* find_rep();
+//            Punto* find_rep();
 
-        /**
-         *  \brief Asigna un nuevo padre para la estructura Union-Find.
-         *  \param nuevo_padre Puntero al elemento que se convertirá en padre.
-         */
-        void set_padre(Punto* nuevo_padre);
->>>>>>> 64c8a31 (Update readme and add documentation)
+//            void set_padre(Punto* nuevo_padre);
 };
 
 namespace PuntoUtils 
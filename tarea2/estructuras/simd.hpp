@@ -0,0 +1,66 @@
+/** \file simd.hpp
+ *  \brief Selección en tiempo de ejecución del juego de instrucciones para los kernels vectorizados.
+ */
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#endif
+
+/**
+ *  \enum KernelSimd
+ *  \brief Implementación de un kernel vectorizado.
+ *
+ *  Los kernels AVX2 y AVX-512 se compilan con atributos target, así que el binario
+ *  no necesita -march: se elige el mejor disponible al ejecutar.
+ */
+enum class KernelSimd {
+    AUTO,    ///< El mejor soportado por la CPU
+    ESCALAR, ///< Un elemento a la vez (sin intrínsecos)
+    AVX2,    ///< 4 doubles por instrucción
+    AVX512   ///< 8 doubles por instrucción (AVX-512F y VL)
+};
+
+namespace Simd
+{
+    /** \brief true si la CPU puede ejecutar el kernel. */
+    inline bool soportado(KernelSimd kernel) {
+        switch (kernel) {
+#ifdef SIMD_X86
+            case KernelSimd::AVX512:
+                return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl");
+            case KernelSimd::AVX2:
+                return __builtin_cpu_supports("avx2");
+#endif
+            case KernelSimd::AUTO:
+            case KernelSimd::ESCALAR:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     *  \brief Kernel que efectivamente se usa: AUTO o uno no soportado bajan al mejor disponible.
+     *  \param pedido Kernel pedido.
+     */
+    inline KernelSimd resolver(KernelSimd pedido) {
+        if (pedido == KernelSimd::ESCALAR) return pedido;
+        if (pedido != KernelSimd::AVX2 && soportado(KernelSimd::AVX512)) return KernelSimd::AVX512;
+        if (soportado(KernelSimd::AVX2)) return KernelSimd::AVX2;
+        return KernelSimd::ESCALAR;
+    }
+
+    /** \brief Nombre del kernel, para consola y CSV. */
+    inline const char* nombre(KernelSimd kernel) {
+        switch (kernel) {
+            case KernelSimd::ESCALAR: return "Escalar";
+            case KernelSimd::AVX2: return "AVX2";
+            case KernelSimd::AVX512: return "AVX512";
+            default: return "Auto";
+        }
+    }
+}
+
+#endif
@@ -33,3 +33,86 @@ void UnionFind::union_eq_class(Punto* a, Punto* b) {
     }
 }
 
+void UnionFindIndices::reserve(size_t n) {
+    padre.reserve(n);
+    rango.reserve(n);
+}
+
+uint32_t UnionFindIndices::make_set() {
+    uint32_t i = static_cast<uint32_t>(padre.size());
+    padre.push_back(i);
+    rango.push_back(0);
+    return i;
+}
+
+void UnionFindIndices::make_sets(size_t n) {
+    size_t inicio = padre.size();
+    padre.resize(inicio + n);
+    rango.resize(inicio + n, 0);
+    for (size_t i = inicio; i < padre.size(); ++i) {
+        padre[i] = static_cast<uint32_t>(i);
+    }
+}
+
+uint32_t UnionFindIndices::find_rep_compresion(uint32_t p) {
+    uint32_t raiz = find_rep(p);
+    while (padre[p] != raiz) {  // segunda pasada: todo el camino apunta a la raíz
+        uint32_t siguiente = padre[p];
+        padre[p] = raiz;
+        p = siguiente;
+    }
+    return raiz;
+}
+
+bool UnionFindIndices::union_eq_class(uint32_t a, uint32_t b) {
+    uint32_t ra = find_rep_opt(a);
+    uint32_t rb = find_rep_opt(b);
+    if (ra == rb) {
+        return false;
+    }
+    if (rango[ra] < rango[rb]) {
+        swap(ra, rb);
+    }
+    padre[rb] = ra;
+    if (rango[ra] == rango[rb]) {
+        ++rango[ra];
+    }
+    return true;
+}
+
+UnionFindConcurrente::UnionFindConcurrente(size_t n) : padre(n) {
+    for (size_t i = 0; i < n; ++i) {
+        padre[i].store(static_cast<uint32_t>(i), memory_order_relaxed);
+    }
+}
+
+uint32_t UnionFindConcurrente::find_rep(uint32_t p) {
+    while (true) {
+        uint32_t q = padre[p].load();
+        if (q == p) {
+            return p;
+        }
+        uint32_t r = padre[q].load();
+        if (q != r) {
+            padre[p].compare_exchange_weak(q, r); // si falla, otro hilo ya lo acortó
+        }
+        p = r;
+    }
+}
+
+bool UnionFindConcurrente::union_eq_class(uint32_t a, uint32_t b) {
+    while (true) {
+        a = find_rep(a);
+        b = find_rep(b);
+        if (a == b) {
+            return false;
+        }
+        if (a < b) {
+            swap(a, b);
+        }
+        uint32_t esperado = a;
+        if (padre[a].compare_exchange_strong(esperado, b)) { // a sigue siendo raíz: se cuelga de b
+            return true;
+        }
+    }
+}
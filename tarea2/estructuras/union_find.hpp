@@ -5,8 +5,12 @@
 #define UNION_FIND_HPP
 
 #include "puntos.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 #include <map>
+#include <vector>
 
 using namespace std;
 
@@ -49,4 +53,121 @@ public:
     void union_eq_class(Punto* a, Punto* b);
 };
 
+/** \class UnionFindIndices
+ *  \brief Conjuntos Disjuntos sobre índices densos 0..n-1 guardados en arreglos contiguos.
+ *
+ *  A diferencia de UnionFind, cada salto de find_rep es un acceso a un arreglo de 32 bits
+ *  (sin hash ni árbol), y las uniones son por rango, en O(1).
+ */
+class UnionFindIndices {
+private:
+    vector<uint32_t> padre; ///< Padre de cada elemento (raíz: padre[i] == i)
+    vector<uint8_t> rango;  ///< Cota superior de la altura de cada árbol (para union by rank)
+
+public:
+    /**
+     *  \brief Reserva memoria para n elementos.
+     *  \param n Cantidad de elementos esperada.
+     */
+    void reserve(size_t n);
+
+    /**
+     *  \brief Agrega un conjunto con un solo elemento.
+     *  \return Índice del nuevo elemento.
+     */
+    uint32_t make_set();
+
+    /**
+     *  \brief Agrega n conjuntos de un elemento (índices size()..size()+n-1).
+     *  \param n Cantidad de conjuntos.
+     */
+    void make_sets(size_t n);
+
+    /** \brief Cantidad de elementos. */
+    size_t size() const { return padre.size(); }
+
+    /**
+     *  \brief Encuentra el representante sin modificar los árboles.
+     *  \param p Índice del elemento.
+     *  \return Índice del representante.
+     */
+    uint32_t find_rep(uint32_t p) const {
+        while (padre[p] != p) {
+            p = padre[p];
+        }
+        return p;
+    }
+
+    /**
+     *  \brief Encuentra el representante con path halving.
+     *
+     *  Cada nodo del camino pasa a apuntar a su abuelo: una sola pasada, sin pila,
+     *  y el camino queda a la mitad.
+     *  \param p Índice del elemento.
+     *  \return Índice del representante.
+     */
+    uint32_t find_rep_opt(uint32_t p) {
+        while (padre[p] != p) {
+            padre[p] = padre[padre[p]];
+            p = padre[p];
+        }
+        return p;
+    }
+
+    /**
+     *  \brief Encuentra el representante con compresión completa (todo el camino apunta a la raíz).
+     *  \param p Índice del elemento.
+     *  \return Índice del representante.
+     */
+    uint32_t find_rep_compresion(uint32_t p);
+
+    /**
+     *  \brief Une los conjuntos de a y b por rango.
+     *  \param a Primer elemento.
+     *  \param b Segundo elemento.
+     *  \return true si estaban en conjuntos distintos.
+     */
+    bool union_eq_class(uint32_t a, uint32_t b);
+};
+
+/** \class UnionFindConcurrente
+ *  \brief Conjuntos Disjuntos sobre índices 0..n-1 que admite find y union desde varios hilos a la vez.
+ *
+ *  Sin locks: cada padre es un atomic. Una raíz se cuelga de otra con compare-exchange
+ *  (si otro hilo la colgó antes, se reintenta desde las nuevas raíces), y siempre la
+ *  de índice mayor bajo la de índice menor, así que no se pueden formar ciclos.
+ *  find_rep hace path halving, también con compare-exchange.
+ */
+class UnionFindConcurrente {
+private:
+    vector<atomic<uint32_t>> padre; ///< Padre de cada elemento (raíz: padre[i] == i)
+
+public:
+    /**
+     *  \brief Crea n conjuntos de un elemento.
+     *  \param n Cantidad de elementos.
+     */
+    explicit UnionFindConcurrente(size_t n);
+
+    /** \brief Cantidad de elementos. */
+    size_t size() const { return padre.size(); }
+
+    /**
+     *  \brief Encuentra el representante con path halving.
+     *  \param p Índice del elemento.
+     *  \return Índice del representante (el menor índice del conjunto no está garantizado).
+     */
+    uint32_t find_rep(uint32_t p);
+
+    /**
+     *  \brief Une los conjuntos de a y b.
+     *
+     *  Si varios hilos unen los mismos dos conjuntos, solo uno recibe true.
+     *  \param a Primer elemento.
+     *  \param b Segundo elemento.
+     *  \return true si estaban en conjuntos distintos y esta llamada los unió.
+     */
+    bool union_eq_class(uint32_t a, uint32_t b);
+};
+
 #endif
\ No newline at end of file
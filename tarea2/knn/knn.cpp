@@ -0,0 +1,217 @@
+#include "knn.hpp"
+#include "../estructuras/indice_espacial.hpp"
+#include "../estructuras/paralelo.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+    /**
+     *  \class ColaRadix
+     *  \brief Cola de prioridad monótona (radix heap): las claves que entran nunca son menores que la última que salió.
+     *
+     *  Kruskal saca las aristas en orden creciente y cada punto solo encola pesos mayores o
+     *  iguales al que acaba de salir, así que alcanza con esta cola: un balde por bit más alto
+     *  en que la clave difiere de la última sacada. Encolar es O(1) y cada elemento baja de
+     *  balde a lo más 64 veces, recorriendo los baldes en secuencia en vez de saltar por un heap.
+     *  Las claves son el patrón de bits del peso, que para doubles no negativos respeta el orden.
+     */
+    class ColaRadix {
+    private:
+        struct Elemento {
+            uint64_t clave;
+            uint32_t punto;
+        };
+        vector<Elemento> baldes[65];
+        uint64_t ultima = 0;
+        size_t cantidad = 0;
+
+        static uint64_t clave_de(double peso) {
+            uint64_t clave;
+            memcpy(&clave, &peso, sizeof(clave));
+            return clave;
+        }
+        size_t balde(uint64_t clave) const {
+            return clave == ultima ? 0 : 64 - static_cast<size_t>(__builtin_clzll(clave ^ ultima));
+        }
+
+    public:
+        bool empty() const { return cantidad == 0; }
+
+        void push(double peso, uint32_t punto) {
+            uint64_t clave = clave_de(peso);
+            baldes[balde(clave)].push_back({clave, punto});
+            ++cantidad;
+        }
+
+        /** \brief Saca un elemento de peso mínimo y devuelve su punto. */
+        uint32_t pop() {
+            if (baldes[0].empty()) {
+                size_t i = 1;
+                while (baldes[i].empty()) ++i;
+                ultima = min_element(baldes[i].begin(), baldes[i].end(),
+                                     [](const Elemento& a, const Elemento& b) { return a.clave < b.clave; })->clave;
+                for (const Elemento& e : baldes[i]) {
+                    baldes[balde(e.clave)].push_back(e);
+                }
+                vector<Elemento>().swap(baldes[i]); // sin retener su capacidad: la memoria queda en O(cantidad)
+            }
+            uint32_t punto = baldes[0].back().punto;
+            baldes[0].pop_back();
+            --cantidad;
+            return punto;
+        }
+
+        /** \brief Peso de la última clave sacada. */
+        double peso_ultimo() const {
+            double peso;
+            memcpy(&peso, &ultima, sizeof(peso));
+            return peso;
+        }
+
+        /** \brief Bytes reservados por los baldes. */
+        size_t bytes() const {
+            size_t total = 0;
+            for (const auto& b : baldes) total += b.capacity() * sizeof(Elemento);
+            return total;
+        }
+    };
+
+    template <class Indice>
+    vector<Arista> kruskal_knn_con(vector<Punto*>& puntos, EstadisticasKnn& estadisticas, PerfilHW* perfil, const ConfigKruskal& config) {
+        size_t n = puntos.size();
+        vector<Arista> mst;
+        estadisticas = EstadisticasKnn();
+        if (n < 2) return mst;
+        size_t k = max<size_t>(1, min<size_t>(config.vecinos, n - 1));
+        unsigned hilos = max(1u, config.hilos);
+
+        UnionFindIndices uf = [&] {
+            RegionHW region(perfil, "conjuntos");
+            UnionFindIndices conjuntos;
+            conjuntos.make_sets(n);
+            return conjuntos;
+        }();
+        Indice indice = [&] {
+            RegionHW region(perfil, "indice");
+            return Indice(puntos);
+        }();
+
+        // todo se indexa por la posición en el índice espacial (puntos cercanos quedan cerca en memoria).
+        // Candidatos de u, ordenados: lista[u k + pos[u]] .. lista[u k + cuenta[u] - 1]; frontera[u]: todos
+        // los puntos fuera de la componente de u con (peso, posición) hasta frontera[u] ya pasaron por su lista
+        vector<uint32_t> lista(n * k);
+        vector<uint32_t> cuenta(n);
+        vector<uint32_t> pos(n, 0);
+        vector<Vecino> frontera(n);
+        const double INFINITO = numeric_limits<double>::infinity();
+        {
+            RegionHW region(perfil, "vecinos");
+            Paralelo::en_paralelo(hilos, [&](unsigned h) {
+                vector<Vecino> salida(k);
+                size_t fin = Paralelo::inicio_tramo(n, h + 1, hilos);
+                for (size_t u = Paralelo::inicio_tramo(n, h, hilos); u < fin; ++u) {
+                    size_t m = indice.vecinos(static_cast<uint32_t>(u), k, IndiceEspacial::DESDE_INICIO, INFINITO,
+                                              [](uint32_t) { return true; }, salida.data());
+                    for (size_t j = 0; j < m; ++j) {
+                        lista[u * k + j] = salida[j].posicion;
+                    }
+                    cuenta[u] = static_cast<uint32_t>(m);
+                    frontera[u] = m == k ? salida[k - 1] : Vecino{INFINITO, 0};
+                }
+            });
+            estadisticas.candidatas = n * k;
+        }
+
+        RegionHW region(perfil, "mst");
+        // radio mínimo de las recargas (solo importa si la frontera tiene peso 0, con puntos repetidos)
+        double escala = 0;
+        for (const Vecino& f : frontera) {
+            escala += f.peso / n;
+        }
+        escala = max(escala, numeric_limits<double>::min());
+
+        vector<Vecino> salida(k);
+        vector<uint32_t> etiqueta(n);
+        size_t componentes_etiquetadas = n;
+        ColaRadix cola;
+
+        // encola la próxima arista de u que sale de su componente o, si se le acabaron los
+        // candidatos, una marca con el peso de su frontera: al sacarla hay que recargar
+        auto empujar = [&](uint32_t u) {
+            uint32_t* candidatos = lista.data() + static_cast<size_t>(u) * k;
+            uint32_t propia = uf.find_rep_opt(u);
+            while (pos[u] < cuenta[u] && uf.find_rep_opt(candidatos[pos[u]]) == propia) {
+                ++pos[u];
+            }
+            if (pos[u] < cuenta[u]) {
+                cola.push(indice.distancia(u, candidatos[pos[u]]), u);
+            } else if (frontera[u].peso < INFINITO) {
+                cola.push(frontera[u].peso, u);
+            }
+        };
+
+        // pide al índice los k vecinos siguientes a la frontera de u fuera de su componente, hasta
+        // el doble de radio: los puntos del interior de una componente grande no buscan lejos
+        auto recargar = [&](uint32_t u) {
+            // las etiquetas se recalculan cada vez que las componentes bajan a la mitad: O(n log n) en total
+            size_t componentes = n - mst.size();
+            if (componentes <= componentes_etiquetadas / 2) {
+                for (size_t i = 0; i < n; ++i) {
+                    etiqueta[i] = uf.find_rep_opt(static_cast<uint32_t>(i));
+                }
+                indice.etiquetar(etiqueta);
+                componentes_etiquetadas = componentes;
+            }
+
+            // una etiqueta vieja sigue en la misma componente que el punto que la tenía
+            uint32_t propia = uf.find_rep_opt(u);
+            double limite = 4 * max(frontera[u].peso, escala);
+            size_t m = indice.vecinos(u, k, frontera[u], limite, [&](uint32_t e) { return uf.find_rep_opt(e) != propia; }, salida.data());
+            uint32_t* candidatos = lista.data() + static_cast<size_t>(u) * k;
+            for (size_t j = 0; j < m; ++j) {
+                candidatos[j] = salida[j].posicion;
+            }
+            cuenta[u] = static_cast<uint32_t>(m);
+            pos[u] = 0;
+            frontera[u] = m == k ? salida[k - 1] : Vecino{limite, numeric_limits<uint32_t>::max()};
+            ++estadisticas.recargas;
+            estadisticas.reparadas += m;
+        };
+
+        for (size_t u = 0; u < n; ++u) {
+            empujar(static_cast<uint32_t>(u));
+        }
+        while (!cola.empty() && mst.size() + 1 < n) {
+            uint32_t u = cola.pop();
+
+            if (pos[u] == cuenta[u]) {
+                recargar(u); // era la marca de la frontera
+            } else {
+                uint32_t v = lista[static_cast<size_t>(u) * k + pos[u]++];
+                if (uf.union_eq_class(u, v)) {
+                    mst.emplace_back(puntos[indice.original(u)], puntos[indice.original(v)], cola.peso_ultimo());
+                }
+            }
+            empujar(u);
+        }
+
+        estadisticas.bytes = indice.bytes() + (lista.capacity() + cuenta.capacity() + pos.capacity() + etiqueta.capacity()) * sizeof(uint32_t)
+                             + (frontera.capacity() + salida.capacity()) * sizeof(Vecino) + cola.bytes()
+                             + n * (sizeof(uint32_t) + sizeof(uint8_t)); // Union-Find: padre y rango
+        return mst;
+    }
+}
+
+vector<Arista> kruskal_knn_estadisticas(vector<Punto*>& puntos, EstadisticasKnn& estadisticas, PerfilHW* perfil, const ConfigKruskal& config) {
+    if (config.indice == TipoIndice::GRILLA) {
+        return kruskal_knn_con<GrillaUniforme>(puntos, estadisticas, perfil, config);
+    }
+    return kruskal_knn_con<ArbolKD>(puntos, estadisticas, perfil, config);
+}
+
+vector<Arista> kruskal_knn(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config) {
+    EstadisticasKnn estadisticas;
+    return kruskal_knn_estadisticas(puntos, estadisticas, perfil, config);
+}
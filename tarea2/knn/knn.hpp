@@ -0,0 +1,50 @@
+/** \file knn.hpp
+ *  \brief Kruskal sobre un grafo de k vecinos más cercanos, con reparación hasta el MST exacto.
+ */
+#ifndef KNN_HPP
+#define KNN_HPP
+
+#include "../kruskal/kruskal.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ *  \struct EstadisticasKnn
+ *  \brief Tamaño del grafo de candidatos y trabajo de reparación de una corrida de kruskal_knn.
+ */
+struct EstadisticasKnn {
+    size_t candidatas = 0; ///< Aristas candidatas iniciales (k por punto)
+    size_t reparadas = 0;  ///< Aristas agregadas por las recargas
+    size_t recargas = 0;   ///< Consultas de recarga al índice
+    size_t bytes = 0;      ///< Memoria extra (índice, listas de vecinos, cola y Union-Find)
+};
+
+/**
+ *  \brief Kruskal sobre los k vecinos más cercanos de cada punto, exacto.
+ *
+ *  Cada punto tiene una lista ordenada de candidatos, al principio sus k vecinos más
+ *  cercanos, sacados de un índice espacial (config.indice), y una frontera: hasta ese peso
+ *  todos sus vecinos de otras componentes ya pasaron por la lista. Una cola monótona con la
+ *  próxima arista de cada punto las entrega en orden creciente de peso, como Kruskal con
+ *  heap sobre el grafo de candidatos. Cuando la lista de un punto se acaba, la cola guarda
+ *  una marca con el peso de su frontera; si Kruskal llega a ese peso, faltarían aristas que
+ *  el grafo kNN no tiene, y se piden al índice los k vecinos siguientes fuera de la
+ *  componente del punto (descartando nodos o celdas enteras de la misma componente), hasta
+ *  el doble de radio. Así ninguna arista entre componentes se pierde y el resultado es el
+ *  MST exacto, con el mismo peso que kruskal_w_sort_opt; los puntos del interior de una
+ *  componente grande no buscan lejos. Memoria O(n k).
+ *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("conjuntos", "indice", "vecinos", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (indice, vecinos e hilos para los vecinos iniciales).
+ *  \return Vector de aristas que forman el MST.
+ */
+vector<Arista> kruskal_knn(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
+
+/**
+ *  \brief kruskal_knn que además devuelve el tamaño del grafo de candidatos y la memoria usada.
+ *  \param estadisticas Salida.
+ */
+vector<Arista> kruskal_knn_estadisticas(vector<Punto*>& puntos, EstadisticasKnn& estadisticas, PerfilHW* perfil = nullptr,
+                                        const ConfigKruskal& config = ConfigKruskal());
+
+#endif
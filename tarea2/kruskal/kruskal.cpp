@@ -1,114 +1,377 @@
 #include "kruskal.hpp"
+#include "../estructuras/paralelo.hpp"
+#include <unordered_map>
 
-vector<Arista> kruskal_w_sort_opt(vector<Punto*>& puntos){
-    UnionFind uf;
-    for (Punto* p : puntos) {
-        uf.make_set(p);
-    }
+namespace {
+
+    /** \brief Origen de las aristas que recorre Kruskal. */
+    enum class FuenteAristas { SORT, HEAP, DELAUNAY, FILTRO };
+
+    /**
+     *  \class IndicePuntos
+     *  \brief Posición de cada punto en el vector de entrada, para pasar de Punto* a índice.
+     *
+     *  Si los punteros apuntan a un arreglo contiguo en el mismo orden (el caso de
+     *  punterosDesdeVector) el índice es una resta; si no, se usa una tabla hash.
+     */
+    class IndicePuntos {
+    private:
+        const Punto* base = nullptr;
+        bool contiguos = true;
+        unordered_map<const Punto*, uint32_t> posiciones;
+
+    public:
+        explicit IndicePuntos(const vector<Punto*>& puntos) {
+            if (!puntos.empty()) base = puntos[0];
+            for (size_t i = 0; i < puntos.size() && contiguos; ++i) {
+                contiguos = puntos[i] == base + i;
+            }
+            if (!contiguos) {
+                posiciones.reserve(puntos.size());
+                for (size_t i = 0; i < puntos.size(); ++i) {
+                    posiciones[puntos[i]] = static_cast<uint32_t>(i);
+                }
+            }
+        }
+
+        uint32_t operator()(const Punto* p) const {
+            return contiguos ? static_cast<uint32_t>(p - base) : posiciones.at(p);
+        }
+    };
 
-    vector<Arista> aristas = AristaUtils::getAristasSort(puntos);
+    /** \brief UnionFind por mapas (baseline) con la interfaz de recorrido de Kruskal. */
+    class ConjuntosMapa {
+    private:
+        UnionFind uf;
+        const vector<Punto*>& puntos;
+        bool opt;
 
-    vector<Arista> mst;
+    public:
+        /** \brief UnionFind::find_rep usa operator[] del mapa: no se consulta desde varios hilos. */
+        static constexpr bool CONSULTA_CONCURRENTE = false;
 
-    for (const Arista& arista : aristas) {
-        Punto* u = arista.p1;
-        Punto* v = arista.p2;
+        ConjuntosMapa(const vector<Punto*>& puntos, bool opt, const ConfigKruskal&) : puntos(puntos), opt(opt) {
+            for (Punto* p : puntos) {
+                uf.make_set(p);
+            }
+        }
 
-        if (uf.find_rep_opt(u) != uf.find_rep_opt(v)) {
+        /** \brief Une los conjuntos de u y v; false si ya estaban juntos (la arista formaría un ciclo). */
+        bool unir(Punto* u, Punto* v) {
+            if (conectados(u, v)) {
+                return false;
+            }
             uf.union_eq_class(u, v);
-            mst.push_back(arista);
+            return true;
+        }
+
+        /** \brief Como unir, con los extremos dados por su posición en puntos. */
+        bool unir_indices(uint32_t u, uint32_t v) {
+            return unir(puntos[u], puntos[v]);
+        }
+
+        /** \brief true si u y v ya están en el mismo conjunto. */
+        bool conectados(Punto* u, Punto* v) {
+            return opt ? uf.find_rep_opt(u) == uf.find_rep_opt(v) : uf.find_rep(u) == uf.find_rep(v);
+        }
+    };
+
+    /** \brief UnionFindIndices con la interfaz de recorrido de Kruskal. */
+    class ConjuntosIndices {
+    private:
+        UnionFindIndices uf;
+        IndicePuntos indice;
+        bool opt;
+        bool compresion_completa;
 
-            if (mst.size() == puntos.size() - 1) {
-                break;
+        uint32_t find(uint32_t p) {
+            if (!opt) return uf.find_rep(p);
+            return compresion_completa ? uf.find_rep_compresion(p) : uf.find_rep_opt(p);
+        }
+
+    public:
+        /** \brief conectados_concurrente solo lee los arreglos: se puede llamar desde varios hilos. */
+        static constexpr bool CONSULTA_CONCURRENTE = true;
+
+        ConjuntosIndices(const vector<Punto*>& puntos, bool opt, const ConfigKruskal& config)
+            : indice(puntos), opt(opt), compresion_completa(config.compresion_completa) {
+            uf.reserve(puntos.size());
+            uf.make_sets(puntos.size());
+        }
+
+        /** \brief Une los conjuntos de u y v; false si ya estaban juntos (la arista formaría un ciclo). */
+        bool unir(Punto* u, Punto* v) {
+            return unir_indices(indice(u), indice(v));
+        }
+
+        /** \brief Como unir, con los extremos dados por su posición en puntos. */
+        bool unir_indices(uint32_t u, uint32_t v) {
+            uint32_t ru = find(u);
+            uint32_t rv = find(v);
+            if (ru == rv) {
+                return false;
             }
+            return uf.union_eq_class(ru, rv);
         }
-    }
 
-    return mst;
-}
+        /** \brief true si u y v ya están en el mismo conjunto. */
+        bool conectados(Punto* u, Punto* v) {
+            return find(indice(u)) == find(indice(v));
+        }
+
+        /** \brief Como conectados, sin comprimir caminos (no modifica la estructura). */
+        bool conectados_concurrente(const Punto* u, const Punto* v) const {
+            return uf.find_rep(indice(u)) == uf.find_rep(indice(v));
+        }
+    };
 
-vector<Arista> kruskal_w_sort_no_opt(vector<Punto*>& puntos){
-    UnionFind uf;
-    for (Punto* p : puntos) {
-        uf.make_set(p);
+    const size_t UMBRAL_FILTRO = 1024; ///< Tramos de a lo más este tamaño se ordenan y recorren directamente
+    const size_t MUESTRA_PIVOTE = 31;  ///< Aristas muestreadas para elegir el pivote
+
+    bool por_peso(const Arista& a, const Arista& b) {
+        return a.peso < b.peso;
     }
 
-    vector<Arista> aristas = AristaUtils::getAristasSort(puntos);
+    /** \brief Recorre aristas[a, b), ya ordenadas, agregando al mst las que unen conjuntos distintos. */
+    template <class Conjuntos>
+    void recorrer_ordenadas(vector<Arista>& aristas, size_t a, size_t b, Conjuntos& conjuntos,
+                            vector<Arista>& mst, size_t n) {
+        for (size_t e = a; e < b && mst.size() + 1 < n; ++e) {
+            if (conjuntos.unir(aristas[e].p1, aristas[e].p2)) {
+                mst.push_back(aristas[e]);
+            }
+        }
+    }
 
-    vector<Arista> mst;
+    /**
+     *  \brief Deja al inicio de aristas[a, b) las que unen conjuntos distintos (en el mismo orden).
+     *
+     *  Con varios hilos y una estructura que admite consultas concurrentes, cada hilo filtra
+     *  un tramo y después los tramos sobrevivientes se corren hacia la izquierda.
+     *  \return Nuevo fin del rango.
+     */
+    template <class Conjuntos>
+    size_t filtrar(vector<Arista>& aristas, size_t a, size_t b, Conjuntos& conjuntos, unsigned hilos) {
+        auto inicio = aristas.begin();
+        if constexpr (Conjuntos::CONSULTA_CONCURRENTE) {
+            if (hilos > 1 && b - a >= UMBRAL_FILTRO * hilos) {
+                vector<size_t> fines(hilos);
+                Paralelo::en_paralelo(hilos, [&](unsigned k) {
+                    auto desde = inicio + a + Paralelo::inicio_tramo(b - a, k, hilos);
+                    auto hasta = inicio + a + Paralelo::inicio_tramo(b - a, k + 1, hilos);
+                    fines[k] = remove_if(desde, hasta, [&](const Arista& x) {
+                        return conjuntos.conectados_concurrente(x.p1, x.p2);
+                    }) - inicio;
+                });
+                size_t escritura = fines[0];
+                for (unsigned k = 1; k < hilos; ++k) {
+                    auto desde = inicio + a + Paralelo::inicio_tramo(b - a, k, hilos);
+                    escritura = move(desde, inicio + fines[k], inicio + escritura) - inicio;
+                }
+                return escritura;
+            }
+        }
+        return remove_if(inicio + a, inicio + b, [&](const Arista& x) {
+            return conjuntos.conectados(x.p1, x.p2);
+        }) - inicio;
+    }
 
-    for (const Arista& arista : aristas) {
-        Punto* u = arista.p1;
-        Punto* v = arista.p2;
+    /** \brief Mediana del peso de MUESTRA_PIVOTE aristas equiespaciadas de aristas[a, b). */
+    double pivote_muestra(const vector<Arista>& aristas, size_t a, size_t b) {
+        vector<double> muestra;
+        muestra.reserve(MUESTRA_PIVOTE);
+        for (size_t i = 0; i < MUESTRA_PIVOTE; ++i) {
+            muestra.push_back(aristas[a + (b - a) * i / MUESTRA_PIVOTE].peso);
+        }
+        nth_element(muestra.begin(), muestra.begin() + MUESTRA_PIVOTE / 2, muestra.end());
+        return muestra[MUESTRA_PIVOTE / 2];
+    }
 
-        if (uf.find_rep(u) != uf.find_rep(v)) {
-            uf.union_eq_class(u, v);
-            mst.push_back(arista);
+    /**
+     *  \brief Filter-Kruskal sobre aristas[a, b).
+     *
+     *  Parte el rango alrededor de un pivote muestreado, resuelve primero el lado liviano
+     *  y, antes de seguir con el pesado, descarta de él las aristas cuyos extremos ya
+     *  quedaron conectados. Los tramos chicos se ordenan y recorren como en Kruskal.
+     */
+    template <class Conjuntos>
+    void filter_kruskal(vector<Arista>& aristas, size_t a, size_t b, Conjuntos& conjuntos,
+                        vector<Arista>& mst, size_t n, unsigned hilos) {
+        auto inicio = aristas.begin();
+        while (a < b && mst.size() + 1 < n) {
+            if (b - a <= UMBRAL_FILTRO) {
+                sort(inicio + a, inicio + b, por_peso);
+                recorrer_ordenadas(aristas, a, b, conjuntos, mst, n);
+                return;
+            }
 
-            if (mst.size() == puntos.size() - 1) {
-                break;
+            double pivote = pivote_muestra(aristas, a, b);
+            auto medio = partition(inicio + a, inicio + b, [&](const Arista& x) { return x.peso < pivote; });
+            if (medio == inicio + a) { // el pivote es el mínimo del rango
+                medio = partition(inicio + a, inicio + b, [&](const Arista& x) { return x.peso <= pivote; });
+                if (medio == inicio + b) { // todas pesan lo mismo: cualquier orden sirve
+                    recorrer_ordenadas(aristas, a, b, conjuntos, mst, n);
+                    return;
+                }
             }
+
+            size_t m = medio - inicio;
+            filter_kruskal(aristas, a, m, conjuntos, mst, n, hilos);
+            b = filtrar(aristas, m, b, conjuntos, hilos);
+            a = m;
         }
     }
 
-    return mst;
-}
+    /**
+     *  \brief Kruskal con una fuente de aristas y una estructura de conjuntos.
+     *
+     *  Fases medidas: "conjuntos" (make_set), "aristas" (generación, o triangulación),
+     *  "orden" (sort o armado del heap; con PUNTEROS, heap y un hilo va en "aristas",
+     *  porque construirHeapAristas inserta de a una) y "mst" (recorrido hasta tener n-1 aristas).
+     *  Con config.hilos > 1 las aristas del grafo completo se generan en paralelo y, con
+     *  PUNTEROS, se ordenan con merge sort paralelo (el heap se arma de una vez, en O(m)).
+     *  FILTRO siempre usa Arista; partición, orden y recorrido quedan juntos en "mst".
+     */
+    template <class Conjuntos>
+    vector<Arista> kruskal_con(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config,
+                               FuenteAristas fuente, bool opt) {
+        Conjuntos conjuntos = [&] {
+            RegionHW region(perfil, "conjuntos");
+            return Conjuntos(puntos, opt, config);
+        }();
 
-vector<Arista> kruskal_w_heap_opt(vector<Punto*>& puntos) {
-    UnionFind uf;
-    for (Punto* p : puntos) {
-        uf.make_set(p);
-    }
+        vector<Arista> mst;
 
-    priority_queue<Arista, vector<Arista>, ComparadorAristas> aristas = AristaUtils::construirHeapAristas(puntos);
+        if (config.aristas == TipoAristas::COMPACTAS && fuente != FuenteAristas::FILTRO) {
+            ListaAristasCompacta lista(config.peso_32, config.soa);
+            {
+                RegionHW region(perfil, "aristas");
+                if (fuente == FuenteAristas::DELAUNAY) {
+                    lista.agregar_pares(puntos, DelaunayUtils::getParesDelaunay(puntos));
+                } else {
+                    lista.agregar_completas(puntos, config.hilos);
+                }
+            }
+            {
+                RegionHW region(perfil, "orden");
+                if (fuente == FuenteAristas::HEAP) {
+                    lista.armar_heap();
+                } else if (config.radix) {
+                    lista.ordenar_radix(config.hilos);
+                } else {
+                    lista.ordenar();
+                }
+            }
 
-    vector<Arista> mst;
+            RegionHW region(perfil, "mst");
+            if (puntos.size() < 2) return mst;
+            lista.recorrer([&](uint32_t u, uint32_t v) {
+                if (conjuntos.unir_indices(u, v)) {
+                    mst.emplace_back(puntos[u], puntos[v]);
+                }
+                return mst.size() + 1 < puntos.size();
+            });
+            return mst;
+        }
 
-    while (!aristas.empty()) {
-        Arista arista = aristas.top();
-        aristas.pop();
+        if (fuente == FuenteAristas::HEAP) {
+            priority_queue<Arista, vector<Arista>, ComparadorAristas> aristas;
+            if (config.hilos > 1) {
+                vector<Arista> lista;
+                {
+                    RegionHW region(perfil, "aristas");
+                    lista = AristaUtils::getAristasParalelo(puntos, config.hilos);
+                }
+                RegionHW region(perfil, "orden");
+                aristas = priority_queue<Arista, vector<Arista>, ComparadorAristas>(ComparadorAristas(), move(lista));
+            } else {
+                RegionHW region(perfil, "aristas");
+                aristas = AristaUtils::construirHeapAristas(puntos);
+            }
 
-        Punto* u = arista.p1;
-        Punto* v = arista.p2;
+            RegionHW region(perfil, "mst");
+            while (!aristas.empty() && mst.size() + 1 < puntos.size()) {
+                Arista arista = aristas.top();
+                aristas.pop();
 
-        if (uf.find_rep_opt(u) != uf.find_rep_opt(v)) {
-            uf.union_eq_class(u, v);
-            mst.push_back(arista);
+                if (conjuntos.unir(arista.p1, arista.p2)) {
+                    mst.push_back(arista);
+                }
+            }
+            return mst;
+        }
 
-            if (mst.size() == puntos.size() - 1) {
-                break;
+        vector<Arista> aristas;
+        {
+            RegionHW region(perfil, "aristas");
+            if (fuente != FuenteAristas::DELAUNAY) {
+                aristas = config.hilos > 1 ? AristaUtils::getAristasParalelo(puntos, config.hilos)
+                                           : AristaUtils::getAristas(puntos);
+            } else {
+                for (const auto& [u, v] : DelaunayUtils::getParesDelaunay(puntos)) {
+                    aristas.emplace_back(puntos[u], puntos[v]);
+                }
             }
         }
+        if (fuente == FuenteAristas::FILTRO) {
+            RegionHW region(perfil, "mst");
+            filter_kruskal(aristas, 0, aristas.size(), conjuntos, mst, puntos.size(), config.hilos);
+            return mst;
+        }
+        {
+            RegionHW region(perfil, "orden");
+            AristaUtils::ordenarAristasParalelo(aristas, config.hilos);
+        }
+
+        RegionHW region(perfil, "mst");
+        for (const Arista& arista : aristas) {
+            if (conjuntos.unir(arista.p1, arista.p2)) {
+                mst.push_back(arista);
+
+                if (mst.size() + 1 == puntos.size()) {
+                    break;
+                }
+            }
+        }
+        return mst;
     }
-    return mst;
-}
 
-vector<Arista> kruskal_w_heap_no_opt(vector<Punto*>& puntos) {
-    UnionFind uf;
-    for (Punto* p : puntos) {
-        uf.make_set(p);
+    vector<Arista> kruskal(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config,
+                           FuenteAristas fuente, bool opt) {
+        if (config.union_find == TipoUnionFind::INDICES) {
+            return kruskal_con<ConjuntosIndices>(puntos, perfil, config, fuente, opt);
+        }
+        return kruskal_con<ConjuntosMapa>(puntos, perfil, config, fuente, opt);
     }
+}
 
-    priority_queue<Arista, vector<Arista>, ComparadorAristas> aristas = AristaUtils::construirHeapAristas(puntos);
+size_t bytes_por_arista(const ConfigKruskal& config) {
+    if (config.aristas == TipoAristas::COMPACTAS) {
+        return ListaAristasCompacta::bytes_por_arista(config.peso_32, config.soa);
+    }
+    return sizeof(Arista);
+}
 
-    vector<Arista> mst;
+vector<Arista> kruskal_w_sort_opt(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config){
+    return kruskal(puntos, perfil, config, FuenteAristas::SORT, true);
+}
 
-    while (!aristas.empty()) {
-        Arista arista = aristas.top();
-        aristas.pop();
+vector<Arista> kruskal_w_sort_no_opt(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config){
+    return kruskal(puntos, perfil, config, FuenteAristas::SORT, false);
+}
 
-        Punto* u = arista.p1;
-        Punto* v = arista.p2;
+vector<Arista> kruskal_w_heap_opt(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config) {
+    return kruskal(puntos, perfil, config, FuenteAristas::HEAP, true);
+}
 
-        if (uf.find_rep(u) != uf.find_rep(v)) {
-            uf.union_eq_class(u, v);
-            mst.push_back(arista);
+vector<Arista> kruskal_w_heap_no_opt(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config) {
+    return kruskal(puntos, perfil, config, FuenteAristas::HEAP, false);
+}
 
-            if (mst.size() == puntos.size() - 1) {
-                break;
-            }
-        }
-    }
-    return mst;
+vector<Arista> kruskal_delaunay(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config) {
+    return kruskal(puntos, perfil, config, FuenteAristas::DELAUNAY, true);
 }
 
+vector<Arista> kruskal_filter(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config) {
+    return kruskal(puntos, perfil, config, FuenteAristas::FILTRO, true);
+}
@@ -7,33 +7,123 @@
 #include "../estructuras/aristas.hpp"
 #include <vector>
 #include "../estructuras/union_find.hpp"
+#include "../estructuras/delaunay.hpp"
+#include "../estructuras/aristas_compactas.hpp"
+#include "../estructuras/simd.hpp"
+#include "../medicion/contadores.hpp"
+
+/**
+ *  \enum TipoUnionFind
+ *  \brief Estructura de conjuntos disjuntos que usa Kruskal.
+ */
+enum class TipoUnionFind {
+    MAPA,     ///< UnionFind: mapas indexados por Punto* (baseline)
+    INDICES   ///< UnionFindIndices: arreglos contiguos indexados por la posición del punto
+};
+
+/**
+ *  \enum TipoAristas
+ *  \brief Representación de la lista de aristas.
+ */
+enum class TipoAristas {
+    PUNTEROS,   ///< Arista: dos Punto* y peso double (24 B)
+    COMPACTAS   ///< ListaAristasCompacta: índices de 32 bits y peso codificado como entero
+};
+
+/**
+ *  \enum TipoIndice
+ *  \brief Índice espacial para buscar vecinos cercanos (kruskal_knn).
+ */
+enum class TipoIndice {
+    ARBOL_KD,   ///< ArbolKD: se adapta a cualquier distribución
+    GRILLA      ///< GrillaUniforme: celdas fijas, rápida con puntos uniformes
+};
+
+/**
+ *  \struct ConfigKruskal
+ *  \brief Opciones de implementación comunes a todas las variantes de Kruskal.
+ */
+struct ConfigKruskal {
+    TipoUnionFind union_find = TipoUnionFind::MAPA; ///< Estructura de conjuntos disjuntos
+    bool compresion_completa = false;               ///< Con INDICES, las variantes "opt" usan compresión completa en vez de path halving
+    TipoAristas aristas = TipoAristas::PUNTEROS;    ///< Representación de las aristas
+    bool peso_32 = false;                           ///< Con COMPACTAS, peso en 32 bits (float): menos memoria, orden aproximado
+    bool soa = false;                               ///< Con COMPACTAS, extremos en arreglos aparte: se ordenan solo las claves (peso, id)
+    unsigned hilos = 1;                             ///< Hilos para generar las aristas y ordenarlas (merge sort paralelo con PUNTEROS) o filtrarlas (Filter-Kruskal con INDICES)
+    bool radix = false;                             ///< Con COMPACTAS, ordenar con radix sort paralelo sobre las claves en vez de sort
+    KernelSimd simd = KernelSimd::AUTO;             ///< Kernel vectorizado de las variantes que calculan distancias al vuelo (prim_dense)
+    TipoIndice indice = TipoIndice::ARBOL_KD;       ///< Índice espacial de kruskal_knn
+    unsigned vecinos = 8;                           ///< Vecinos candidatos por punto en kruskal_knn (y por cada recarga)
+};
+
+/**
+ *  \brief Bytes por arista de la representación elegida en config.
+ *  \param config Opciones de implementación.
+ */
+size_t bytes_por_arista(const ConfigKruskal& config);
 
 /**
  *  \brief Kruskal usando arreglo ordenado y optimización Union-Find.
  *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("conjuntos", "aristas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (estructura Union-Find, representación de aristas).
  *  \return Vector de aristas que forman el MST.
  */
-vector<Arista> kruskal_w_sort_opt(vector<Punto*>& puntos);
+vector<Arista> kruskal_w_sort_opt(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
 
 /**
  *  \brief Kruskal usando arreglo ordenado sin optimización Union-Find.
  *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("conjuntos", "aristas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (estructura Union-Find, representación de aristas).
  *  \return Vector de aristas que forman el MST.
  */
-vector<Arista> kruskal_w_sort_no_opt(vector<Punto*>& puntos);
+vector<Arista> kruskal_w_sort_no_opt(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
 
 /**
  *  \brief Kruskal usando heap y optimización Union-Find.
  *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("conjuntos", "aristas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (estructura Union-Find, representación de aristas).
  *  \return Vector de aristas que forman el MST.
  */
-vector<Arista> kruskal_w_heap_opt(vector<Punto*>& puntos);
+vector<Arista> kruskal_w_heap_opt(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
 
 /**
  *  \brief Kruskal usando heap sin optimización Union-Find.
  *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("conjuntos", "aristas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (estructura Union-Find, representación de aristas).
+ *  \return Vector de aristas que forman el MST.
+ */
+vector<Arista> kruskal_w_heap_no_opt(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
+
+/**
+ *  \brief Kruskal sobre las aristas de la triangulación de Delaunay, con optimización Union-Find.
+ *
+ *  El MST euclidiano está contenido en la triangulación de Delaunay, así que basta
+ *  con sus a lo más 3n - 6 aristas en vez de las n(n-1)/2 del grafo completo:
+ *  O(n log n) en tiempo y O(n) en memoria, con el mismo peso total que kruskal_w_sort_opt.
+ *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("conjuntos", "aristas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (estructura Union-Find, representación de aristas).
+ *  \return Vector de aristas que forman el MST.
+ */
+vector<Arista> kruskal_delaunay(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
+
+/**
+ *  \brief Filter-Kruskal: quicksort parcial de las aristas que descarta las que ya forman ciclo.
+ *
+ *  Parte las aristas alrededor de un pivote (mediana de una muestra), resuelve primero
+ *  el lado liviano y filtra el pesado con el Union-Find antes de partirlo: las aristas
+ *  que quedan después de tener n-1 en el MST nunca se ordenan. Con config.hilos > 1 y
+ *  Union-Find por índices el filtro se hace en paralelo. Usa siempre Arista (ignora
+ *  config.aristas).
+ *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("conjuntos", "aristas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (estructura Union-Find, hilos).
  *  \return Vector de aristas que forman el MST.
  */
-vector<Arista> kruskal_w_heap_no_opt(vector<Punto*>& puntos);
+vector<Arista> kruskal_filter(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
 
 #endif
\ No newline at end of file
@@ -5,10 +5,18 @@
 #include <vector>
 #include <chrono>
 #include "kruskal/kruskal.hpp"
+#include "boruvka/boruvka.hpp"
+#include "prim/prim.hpp"
+#include "knn/knn.hpp"
+#include "estructuras/nube_puntos.hpp"
+#include "estructuras/generador.hpp"
+#include "medicion/contadores.hpp"
 #include <numeric>
 #include <fstream>
 #include <filesystem>
 #include <regex>
+#include <map>
+#include <thread>
 
 using namespace std;
 using namespace AristaUtils;
@@ -36,6 +44,26 @@ string generarNombreArchivo(const string& carpeta) {
     return carpeta + "/res" + to_string(maxN + 1) + ".csv";
 }
 
+/**
+ *  \struct Variante
+ *  \brief Variante de Kruskal medida en el benchmark.
+ */
+struct Variante {
+    string nombre;      ///< Columna del CSV
+    string descripcion; ///< Texto en consola
+    vector<Arista> (*kruskal)(vector<Punto*>&, PerfilHW*, const ConfigKruskal&);
+    ConfigKruskal config;
+};
+
+// Funcion auxiliar
+double pesoTotal(const vector<Arista>& mst) {
+    double suma = 0;
+    for (const Arista& arista : mst) {
+        suma += arista.peso;
+    }
+    return suma;
+}
+
 // Funcion auxiliar
 std::string formatNumber(double num) {
     std::ostringstream stream;
@@ -52,77 +80,329 @@ std::string formatNumber(double num) {
     return str;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+
+    // semilla opcional como primer argumento: con la misma semilla se repiten exactamente los mismos puntos
+    const uint64_t semilla = argc > 1 ? stoull(argv[1]) : 12345;
+    uint64_t generacion = 0; // cada conjunto de puntos usa la semilla siguiente
+    auto generarPuntos = [&](int size, Distribucion distribucion = Distribucion::UNIFORME) {
+        ConfigGenerador config;
+        config.distribucion = distribucion;
+        config.semilla = semilla + generacion++;
+        config.hilos = max(1u, thread::hardware_concurrency());
+        return GeneradorPuntos::generar(size, config);
+    };
 
     cout << '\n' <<"Test para probrar eficiencia del Algoritmo de Kruskal en distintos contextos. "  << '\n' << endl;
+    cout << "Semilla: " << semilla << '\n' << endl;
 
     const array<int, 8> N = {32,64,128,256,512,1024,2048,4096}; // Sizes
-    vector<tuple<int, double, double, double, double>> resultados; 
+    const array<int, 4> N_GRANDES = {16384, 65536, 262144, 1048576}; // Tamaños solo para Delaunay
+    const array<int, 3> N_PRIM = {16384, 65536, 131072}; // Tamaños para Prim denso (O(n²) tiempo, O(n) memoria)
+    const array<KernelSimd, 3> KERNELS = {KernelSimd::ESCALAR, KernelSimd::AVX2, KernelSimd::AVX512};
+    const ConfigKruskal MAPA = {TipoUnionFind::MAPA};
+    const ConfigKruskal INDICES = {TipoUnionFind::INDICES};
+    const ConfigKruskal INDICES_COMPRESION = {TipoUnionFind::INDICES, true};
+    const ConfigKruskal COMPACTA = {TipoUnionFind::INDICES, false, TipoAristas::COMPACTAS, false, false};
+    const ConfigKruskal COMPACTA_SOA = {TipoUnionFind::INDICES, false, TipoAristas::COMPACTAS, false, true};
+    const ConfigKruskal COMPACTA_32 = {TipoUnionFind::INDICES, false, TipoAristas::COMPACTAS, true, false};
+    const ConfigKruskal COMPACTA_SOA_32 = {TipoUnionFind::INDICES, false, TipoAristas::COMPACTAS, true, true};
+    const ConfigKruskal COMPACTA_SOA_32_RADIX = {TipoUnionFind::INDICES, false, TipoAristas::COMPACTAS, true, true, 1, true};
+    const ConfigKruskal KNN_KD = {TipoUnionFind::INDICES, false, TipoAristas::PUNTEROS, false, false, 1, false, KernelSimd::AUTO, TipoIndice::ARBOL_KD};
+    const ConfigKruskal KNN_GRILLA = {TipoUnionFind::INDICES, false, TipoAristas::PUNTEROS, false, false, 1, false, KernelSimd::AUTO, TipoIndice::GRILLA};
+    const array<unsigned, 4> HILOS = {1, 2, 4, 8}; // hilos para medir el escalamiento
+
+    // la primera es la referencia con la que se compara el peso de los demás MST
+    const vector<Variante> VARIANTES = {
+        {"KruskalSortOpt", "Kruskal con Sort (con optimización de find)", kruskal_w_sort_opt, MAPA},
+        {"KruskalHeapOpt", "Kruskal con Heap (con optimización de find)", kruskal_w_heap_opt, MAPA},
+        {"KruskalSortNoOpt", "Kruskal con Sort (sin optimización de find)", kruskal_w_sort_no_opt, MAPA},
+        {"KruskalHeapNoOpt", "Kruskal con Heap (sin optimización de find)", kruskal_w_heap_no_opt, MAPA},
+        {"KruskalDelaunay", "Kruskal sobre triangulación de Delaunay", kruskal_delaunay, MAPA},
+        {"KruskalFilter", "Filter-Kruskal", kruskal_filter, MAPA},
+        {"KruskalSortOptIdx", "Kruskal con Sort (con optimización de find, Union-Find por índices)", kruskal_w_sort_opt, INDICES},
+        {"KruskalHeapOptIdx", "Kruskal con Heap (con optimización de find, Union-Find por índices)", kruskal_w_heap_opt, INDICES},
+        {"KruskalSortNoOptIdx", "Kruskal con Sort (sin optimización de find, Union-Find por índices)", kruskal_w_sort_no_opt, INDICES},
+        {"KruskalHeapNoOptIdx", "Kruskal con Heap (sin optimización de find, Union-Find por índices)", kruskal_w_heap_no_opt, INDICES},
+        {"KruskalDelaunayIdx", "Kruskal sobre triangulación de Delaunay (Union-Find por índices)", kruskal_delaunay, INDICES},
+        {"KruskalFilterIdx", "Filter-Kruskal (Union-Find por índices)", kruskal_filter, INDICES},
+        {"KruskalSortOptIdxCompresion", "Kruskal con Sort (compresión completa, Union-Find por índices)", kruskal_w_sort_opt, INDICES_COMPRESION},
+        {"KruskalHeapOptIdxCompresion", "Kruskal con Heap (compresión completa, Union-Find por índices)", kruskal_w_heap_opt, INDICES_COMPRESION},
+        {"KruskalDelaunayIdxCompresion", "Kruskal sobre triangulación de Delaunay (compresión completa, Union-Find por índices)", kruskal_delaunay, INDICES_COMPRESION},
+        {"KruskalSortOptCompacta", "Kruskal con Sort (aristas compactas AoS, peso 64 bits)", kruskal_w_sort_opt, COMPACTA},
+        {"KruskalSortOptCompactaSoA", "Kruskal con Sort (aristas compactas SoA, peso 64 bits)", kruskal_w_sort_opt, COMPACTA_SOA},
+        {"KruskalSortOptCompacta32", "Kruskal con Sort (aristas compactas AoS, peso 32 bits)", kruskal_w_sort_opt, COMPACTA_32},
+        {"KruskalSortOptCompactaSoA32", "Kruskal con Sort (aristas compactas SoA, peso 32 bits)", kruskal_w_sort_opt, COMPACTA_SOA_32},
+        {"KruskalSortOptCompactaSoA32Radix", "Kruskal con radix sort (aristas compactas SoA, peso 32 bits)", kruskal_w_sort_opt, COMPACTA_SOA_32_RADIX},
+        {"KruskalHeapOptCompacta", "Kruskal con Heap (aristas compactas AoS, peso 64 bits)", kruskal_w_heap_opt, COMPACTA},
+        {"KruskalDelaunayCompacta", "Kruskal sobre triangulación de Delaunay (aristas compactas)", kruskal_delaunay, COMPACTA},
+        {"BoruvkaCompleto", "Borůvka sobre el grafo completo implícito", boruvka_completo, MAPA},
+        {"BoruvkaDelaunay", "Borůvka sobre triangulación de Delaunay", boruvka_delaunay, MAPA},
+        {"PrimDense", "Prim denso (sin lista de aristas)", prim_dense, MAPA},
+        {"KruskalKnnKD", "Kruskal sobre k vecinos con reparación (árbol k-d)", kruskal_knn, KNN_KD},
+        {"KruskalKnnGrilla", "Kruskal sobre k vecinos con reparación (grilla uniforme)", kruskal_knn, KNN_GRILLA},
+    };
+    vector<pair<int, vector<double>>> resultados; // tiempo promedio de cada variante, por tamaño
+    map<int, PerfilHW> perfiles; // contadores de hardware por fase, para cada tamaño
 
     for (int size : N) {
-        double suma_time_sort_opt = 0;
-        double suma_time_heap_opt = 0;
-        double suma_time_sort_no_opt = 0;
-        double suma_time_heap_no_opt = 0;
+        vector<double> suma_time(VARIANTES.size(), 0);
+
+        PerfilHW& perfil = perfiles[size];
 
         cout << "Iterando ... " << endl;
         
         for (int i= 1; i<=5; ++i) { // 5 generaciones
             
-            vector<Punto> puntos(size); // crea 'size' puntos aleatorios
+            vector<Punto> puntos = generarPuntos(size); // crea 'size' puntos aleatorios
             vector<Punto*> puntos_ptrs = punterosDesdeVector(puntos);
-                
-            // kruskal con sort [opt]
-            auto inicio1 = chrono::high_resolution_clock::now();
-            vector<Arista> mst1 = kruskal_w_sort_opt(puntos_ptrs);
-            auto fin1 = chrono::high_resolution_clock::now();
-            chrono::duration<double> duracion1 = fin1 - inicio1;
-            double time1 = duracion1.count();
-            suma_time_sort_opt += time1;
-            
-            // kruskal con heap [opt]
-            auto inicio2 = chrono::high_resolution_clock::now();
-            vector<Arista> mst2 = kruskal_w_heap_opt(puntos_ptrs);
-            auto fin2 = chrono::high_resolution_clock::now();
-            chrono::duration<double> duracion2 = fin2 - inicio2;
-            double time2 = duracion2.count();
-            suma_time_heap_opt += time2;
-
-            // kruskal con sort [no-opt]
-            auto inicio3 = chrono::high_resolution_clock::now();
-            vector<Arista> mst3 = kruskal_w_sort_no_opt(puntos_ptrs);
-            auto fin3 = chrono::high_resolution_clock::now();
-            chrono::duration<double> duracion3 = fin3 - inicio3;
-            double time3 = duracion3.count();
-            suma_time_sort_no_opt += time3;
-
-            // kruskal con heap [no-opt]
-            auto inicio4 = chrono::high_resolution_clock::now();
-            vector<Arista> mst4 = kruskal_w_heap_no_opt(puntos_ptrs);
-            auto fin4 = chrono::high_resolution_clock::now();
-            chrono::duration<double> duracion4 = fin4 - inicio4;
-            double time4 = duracion4.count();
-            suma_time_heap_no_opt += time4;
+            double peso_referencia = 0;
+
+            for (size_t v = 0; v < VARIANTES.size(); ++v) {
+                const Variante& variante = VARIANTES[v];
+
+                perfil.fijar_prefijo(variante.nombre + "/");
+                auto inicio = chrono::high_resolution_clock::now();
+                vector<Arista> mst = variante.kruskal(puntos_ptrs, &perfil, variante.config);
+                auto fin = chrono::high_resolution_clock::now();
+                chrono::duration<double> duracion = fin - inicio;
+                suma_time[v] += duracion.count();
+
+                // con peso de 32 bits el orden es aproximado: se acepta un error relativo chico;
+                // Borůvka suma las mismas aristas en otro orden, lo que cambia los últimos bits
+                double peso = pesoTotal(mst);
+                double tolerancia = (variante.config.peso_32 ? 1e-5 : 1e-12) * peso_referencia;
+                if (v == 0) {
+                    peso_referencia = peso;
+                } else if (mst.size() != puntos.size() - 1 || abs(peso - peso_referencia) > tolerancia) {
+                    cout << "   [!] El MST de " << variante.nombre << " no coincide con el de " << VARIANTES[0].nombre
+                         << ": " << peso << " vs " << peso_referencia << endl;
+                }
+            }
         }
 
         cout << "Finalizada la iteración" << '\n' << endl;
 
-        double avg1 = suma_time_sort_opt / 5.0;
-        double avg2 = suma_time_heap_opt / 5.0;
-        double avg3 = suma_time_sort_no_opt / 5.0;
-        double avg4 = suma_time_heap_no_opt / 5.0;
-
-        resultados.emplace_back(size, avg1, avg2, avg3, avg4);
+        vector<double> promedios;
+        for (double suma : suma_time) {
+            promedios.push_back(suma / 5.0);
+        }
+        resultados.emplace_back(size, promedios);
 
         cout << "Resultados promedio para " << size << " puntos: " << '\n' <<endl;
-        cout << "   Algoritmo de Kruskal con Sort (con optimización de find): " << avg1 << endl;
-        cout << "   Algoritmo de Kruskal con Heap (con optimización de find): " << avg2 << endl;
-        cout << "   Algoritmo de Kruskal con Sort (sin optimización de find): " << avg3 << endl;
-        cout << "   Algoritmo de Kruskal con Heap (sin optimización de find): " << avg4 << endl;        
+        for (size_t v = 0; v < VARIANTES.size(); ++v) {
+            cout << "   Algoritmo de " << VARIANTES[v].descripcion << ": " << promedios[v] << endl;
+        }
     
         cout << '\n' << endl;
     }
 
+    // mismas variantes sobre distribuciones no uniformes: clusters, curvas, grilla (empates) y duplicados (aristas de peso 0)
+    const int N_DISTRIBUCION = N.back();
+    const array<Distribucion, 5> DISTRIBUCIONES = {Distribucion::UNIFORME, Distribucion::CLUSTERS, Distribucion::CURVAS,
+                                                   Distribucion::GRILLA, Distribucion::DUPLICADOS};
+    vector<tuple<Distribucion, string, double>> resultados_distribucion; // distribución, variante, segundos
+    for (Distribucion distribucion : DISTRIBUCIONES) {
+        vector<Punto> puntos = generarPuntos(N_DISTRIBUCION, distribucion);
+        vector<Punto*> puntos_ptrs = punterosDesdeVector(puntos);
+        double peso_referencia = 0;
+
+        cout << "Distribución " << GeneradorPuntos::nombre(distribucion) << " (" << N_DISTRIBUCION << " puntos):" << endl;
+        for (size_t v = 0; v < VARIANTES.size(); ++v) {
+            const Variante& variante = VARIANTES[v];
+            auto inicio = chrono::high_resolution_clock::now();
+            vector<Arista> mst = variante.kruskal(puntos_ptrs, nullptr, variante.config);
+            auto fin = chrono::high_resolution_clock::now();
+            double segundos = chrono::duration<double>(fin - inicio).count();
+            resultados_distribucion.emplace_back(distribucion, variante.nombre, segundos);
+
+            double peso = pesoTotal(mst);
+            double tolerancia = (variante.config.peso_32 ? 1e-5 : 1e-12) * peso_referencia;
+            if (v == 0) {
+                peso_referencia = peso;
+            } else if (mst.size() != puntos.size() - 1 || abs(peso - peso_referencia) > tolerancia) {
+                cout << "   [!] El MST de " << variante.nombre << " no coincide con el de " << VARIANTES[0].nombre
+                     << ": " << peso << " vs " << peso_referencia << endl;
+            }
+            cout << "   " << variante.nombre << ": " << segundos << endl;
+        }
+    }
+
+    // Delaunay tiene O(n) aristas, así que se mide también en tamaños donde el grafo completo no cabe en memoria
+    vector<tuple<int, double, double>> resultados_delaunay;
+    for (int size : N_GRANDES) {
+        vector<Punto> puntos = generarPuntos(size);
+        vector<Punto*> puntos_ptrs = punterosDesdeVector(puntos);
+
+        auto inicio = chrono::high_resolution_clock::now();
+        vector<Arista> mst_mapa = kruskal_delaunay(puntos_ptrs, nullptr, MAPA);
+        auto medio = chrono::high_resolution_clock::now();
+        vector<Arista> mst_indices = kruskal_delaunay(puntos_ptrs, nullptr, INDICES);
+        auto fin = chrono::high_resolution_clock::now();
+        chrono::duration<double> duracion_mapa = medio - inicio;
+        chrono::duration<double> duracion_indices = fin - medio;
+        resultados_delaunay.emplace_back(size, duracion_mapa.count(), duracion_indices.count());
+
+        cout << "Kruskal sobre Delaunay para " << size << " puntos: " << duracion_mapa.count()
+             << " (Union-Find por índices: " << duracion_indices.count() << ")" << endl;
+    }
+
+    // throughput de distancias: todas las filas de una nube de N_DISTANCIAS puntos (cabe en caché), por kernel,
+    // contra PuntoUtils::getWeight de a una a través de Punto*
+    const int N_DISTANCIAS = 4096;
+    const int REPETICIONES_DISTANCIAS = 20;
+    vector<pair<string, double>> resultados_distancias; // kernel, segundos por pasada completa
+    {
+        vector<Punto> puntos = generarPuntos(N_DISTANCIAS);
+        vector<Punto*> puntos_ptrs = punterosDesdeVector(puntos);
+        vector<double> fila(N_DISTANCIAS);
+        double sumidero = 0; // evita que el compilador descarte el cálculo
+
+        auto inicio = chrono::high_resolution_clock::now();
+        for (int r = 0; r < REPETICIONES_DISTANCIAS; ++r) {
+            for (int i = 0; i < N_DISTANCIAS; ++i) {
+                for (int j = 0; j < N_DISTANCIAS; ++j) {
+                    fila[j] = getWeight(*puntos_ptrs[i], *puntos_ptrs[j]);
+                }
+                sumidero += fila[i ^ 1];
+            }
+        }
+        auto fin = chrono::high_resolution_clock::now();
+        resultados_distancias.emplace_back("getWeight", chrono::duration<double>(fin - inicio).count() / REPETICIONES_DISTANCIAS);
+
+        for (KernelSimd kernel : KERNELS) {
+            if (!Simd::soportado(kernel)) continue;
+            NubePuntos nube(puntos_ptrs, kernel);
+            inicio = chrono::high_resolution_clock::now();
+            for (int r = 0; r < REPETICIONES_DISTANCIAS; ++r) {
+                for (int i = 0; i < N_DISTANCIAS; ++i) {
+                    nube.fila_distancias(i, 0, N_DISTANCIAS, fila.data());
+                    sumidero += fila[i ^ 1];
+                }
+            }
+            fin = chrono::high_resolution_clock::now();
+            resultados_distancias.emplace_back(Simd::nombre(kernel), chrono::duration<double>(fin - inicio).count() / REPETICIONES_DISTANCIAS);
+
+            // los pesos deben ser idénticos a los de getWeight
+            nube.fila_distancias(N_DISTANCIAS / 2, 0, N_DISTANCIAS, fila.data());
+            for (int j = 0; j < N_DISTANCIAS; ++j) {
+                if (fila[j] != getWeight(*puntos_ptrs[N_DISTANCIAS / 2], *puntos_ptrs[j])) {
+                    cout << "   [!] El kernel " << Simd::nombre(kernel) << " no coincide con getWeight" << endl;
+                    break;
+                }
+            }
+        }
+
+        cout << '\n' << "Distancias por segundo (" << N_DISTANCIAS << " x " << N_DISTANCIAS << ", suma " << sumidero << "):" << endl;
+        for (const auto& [kernel, segundos] : resultados_distancias) {
+            cout << "   " << kernel << ": " << static_cast<double>(N_DISTANCIAS) * N_DISTANCIAS / segundos / 1e6 << " M distancias/s" << endl;
+        }
+    }
+
+    // Prim denso no guarda aristas: se mide en tamaños donde el grafo completo no cabe en memoria
+    vector<tuple<int, KernelSimd, double>> resultados_prim;
+    for (int size : N_PRIM) {
+        vector<Punto> puntos = generarPuntos(size);
+        vector<Punto*> puntos_ptrs = punterosDesdeVector(puntos);
+        double peso_referencia = pesoTotal(kruskal_delaunay(puntos_ptrs, nullptr, INDICES));
+
+        for (KernelSimd kernel : KERNELS) {
+            if (!Simd::soportado(kernel)) continue;
+            ConfigKruskal config;
+            config.simd = kernel;
+
+            auto inicio = chrono::high_resolution_clock::now();
+            vector<Arista> mst = prim_dense(puntos_ptrs, nullptr, config);
+            auto fin = chrono::high_resolution_clock::now();
+            double segundos = chrono::duration<double>(fin - inicio).count();
+            resultados_prim.emplace_back(size, kernel, segundos);
+
+            if (abs(pesoTotal(mst) - peso_referencia) > 1e-12 * peso_referencia) {
+                cout << "   [!] El MST de PrimDense (" << Simd::nombre(kernel) << ") no coincide con el de KruskalDelaunayIdx" << endl;
+            }
+            cout << "Prim denso (" << Simd::nombre(kernel) << ") para " << size << " puntos: " << segundos << " s, "
+                 << static_cast<double>(size) * (size - 1) / 2 / segundos / 1e6 << " M distancias/s" << endl;
+        }
+    }
+
+    // Kruskal sobre k vecinos: tiempo y memoria contra el grafo completo (kruskal_w_sort_opt solo donde cabe en memoria)
+    const array<int, 5> N_KNN = {4096, 16384, 65536, 262144, 1048576};
+    const array<pair<const char*, const ConfigKruskal*>, 2> INDICES_KNN = {{{"ArbolKD", &KNN_KD}, {"Grilla", &KNN_GRILLA}}};
+    vector<tuple<int, string, double, EstadisticasKnn, double>> resultados_knn; // n, índice, segundos, estadísticas, segundos de sort (o -1)
+    for (int size : N_KNN) {
+        vector<Punto> puntos = generarPuntos(size);
+        vector<Punto*> puntos_ptrs = punterosDesdeVector(puntos);
+        double peso_referencia = pesoTotal(kruskal_delaunay(puntos_ptrs, nullptr, INDICES));
+
+        double segundos_sort = -1;
+        if (size <= N.back()) {
+            auto inicio = chrono::high_resolution_clock::now();
+            kruskal_w_sort_opt(puntos_ptrs, nullptr, INDICES);
+            auto fin = chrono::high_resolution_clock::now();
+            segundos_sort = chrono::duration<double>(fin - inicio).count();
+        }
+
+        for (const auto& [nombre, config] : INDICES_KNN) {
+            EstadisticasKnn estadisticas;
+            auto inicio = chrono::high_resolution_clock::now();
+            vector<Arista> mst = kruskal_knn_estadisticas(puntos_ptrs, estadisticas, nullptr, *config);
+            auto fin = chrono::high_resolution_clock::now();
+            double segundos = chrono::duration<double>(fin - inicio).count();
+            resultados_knn.emplace_back(size, nombre, segundos, estadisticas, segundos_sort);
+
+            if (mst.size() != puntos.size() - 1 || abs(pesoTotal(mst) - peso_referencia) > 1e-12 * peso_referencia) {
+                cout << "   [!] El MST de KruskalKnn (" << nombre << ") no coincide con el de KruskalDelaunayIdx" << endl;
+            }
+            cout << "Kruskal sobre k vecinos (" << nombre << ") para " << size << " puntos: " << segundos << " s, "
+                 << estadisticas.bytes / 1e6 << " MB, " << estadisticas.reparadas << " aristas reparadas";
+            if (segundos_sort >= 0) cout << " (KruskalSortOptIdx: " << segundos_sort << " s)";
+            cout << endl;
+        }
+    }
+
+    // escalamiento con hilos en el tamaño mayor: generación de aristas y orden en paralelo
+    const vector<Variante> PARALELAS = {
+        {"KruskalSortOptIdx", "merge sort paralelo", kruskal_w_sort_opt, INDICES},
+        {"KruskalSortOptCompactaSoA32Radix", "radix sort paralelo", kruskal_w_sort_opt, COMPACTA_SOA_32_RADIX},
+        {"KruskalFilterIdx", "filtro paralelo", kruskal_filter, INDICES},
+        {"BoruvkaCompleto", "Borůvka paralelo", boruvka_completo, MAPA},
+    };
+    const int N_PARALELO = N.back();
+    cout << '\n' << "Escalamiento con hilos para " << N_PARALELO << " puntos (" << thread::hardware_concurrency()
+         << " núcleos disponibles):" << endl;
+
+    vector<tuple<unsigned, string, double, double, double>> resultados_paralelo; // hilos, variante, aristas, orden, total
+    for (const Variante& variante : PARALELAS) {
+        for (unsigned hilos : HILOS) {
+            ConfigKruskal config = variante.config;
+            config.hilos = hilos;
+            PerfilHW perfil;
+            double suma = 0;
+            for (int i = 1; i <= 3; ++i) { // 3 generaciones
+                vector<Punto> puntos = generarPuntos(N_PARALELO);
+                vector<Punto*> puntos_ptrs = punterosDesdeVector(puntos);
+                auto inicio = chrono::high_resolution_clock::now();
+                variante.kruskal(puntos_ptrs, &perfil, config);
+                auto fin = chrono::high_resolution_clock::now();
+                suma += chrono::duration<double>(fin - inicio).count();
+            }
+            // Filter-Kruskal no tiene fase de orden aparte y Borůvka no materializa aristas
+            auto segundos_fase = [&](const string& fase) {
+                auto it = perfil.fases().find(fase);
+                return it == perfil.fases().end() ? 0.0 : it->second.segundos / 3.0;
+            };
+            double t_aristas = segundos_fase("aristas");
+            double t_orden = segundos_fase("orden");
+            resultados_paralelo.emplace_back(hilos, variante.nombre, t_aristas, t_orden, suma / 3.0);
+
+            double base = get<4>(*find_if(resultados_paralelo.begin(), resultados_paralelo.end(),
+                                          [&](const auto& r) { return get<1>(r) == variante.nombre; }));
+            cout << "   " << variante.nombre << " (" << variante.descripcion << "), " << hilos << " hilos: "
+                 << suma / 3.0 << " s (aristas " << t_aristas << ", orden " << t_orden << "), speedup "
+                 << base / (suma / 3.0) << endl;
+        }
+    }
+
     cout << "Finalizado el programa." << endl;
 
     // guarda csv
@@ -130,11 +410,141 @@ int main() {
     string nombreArchivo = generarNombreArchivo("build/resultado");
 
     ofstream archivo(nombreArchivo);
-    archivo << "N;KruskalSortOpt;KruskalHeapOpt;KruskalSortNoOpt;KruskalHeapNoOpt\n";
-    for (const auto& [n, t1, t2, t3, t4] : resultados) {
-        archivo << n << ";" << formatNumber(t1) << ";" << formatNumber(t2) << ";" << formatNumber(t3) << ";" << formatNumber(t4) << "\n";
+    archivo << "N";
+    for (const Variante& variante : VARIANTES) {
+        archivo << ";" << variante.nombre;
+    }
+    for (const Variante& variante : VARIANTES) {
+        archivo << ";" << MuestraHW::encabezado_csv(variante.nombre + "_");
+    }
+    archivo << "\n";
+    for (const auto& [n, promedios] : resultados) {
+        archivo << n;
+        for (double t : promedios) {
+            archivo << ";" << formatNumber(t);
+        }
+        for (const Variante& variante : VARIANTES) {
+            archivo << ";" << perfiles[n].total(variante.nombre + "/").fila_csv(5); // promedio de las 5 generaciones
+        }
+        archivo << "\n";
     }
     archivo.close();
 
     cout << "Resultados exportados a: " << nombreArchivo << endl;
+
+    string nombreDelaunay = regex_replace(nombreArchivo, regex("res(\\d+)\\.csv$"), "delaunay$1.csv");
+    ofstream delaunay(nombreDelaunay);
+    delaunay << "N;KruskalDelaunay;KruskalDelaunayIdx\n";
+    for (const auto& [n, t_mapa, t_indices] : resultados_delaunay) {
+        delaunay << n << ";" << formatNumber(t_mapa) << ";" << formatNumber(t_indices) << "\n";
+    }
+    delaunay.close();
+
+    cout << "Resultados de Delaunay en tamaños grandes exportados a: " << nombreDelaunay << endl;
+
+    string nombreDistribuciones = regex_replace(nombreArchivo, regex("res(\\d+)\\.csv$"), "distribuciones$1.csv");
+    ofstream distribuciones(nombreDistribuciones);
+    distribuciones << "N;Distribucion;Variante;Tiempo\n";
+    for (const auto& [distribucion, nombre, segundos] : resultados_distribucion) {
+        distribuciones << N_DISTRIBUCION << ";" << GeneradorPuntos::nombre(distribucion) << ";" << nombre << ";" << formatNumber(segundos) << "\n";
+    }
+    distribuciones.close();
+
+    cout << "Resultados por distribución exportados a: " << nombreDistribuciones << endl;
+
+    // memoria de la lista de aristas del grafo completo y tiempo de ordenarla, por representación
+    string nombreAristas = regex_replace(nombreArchivo, regex("res(\\d+)\\.csv$"), "aristas$1.csv");
+    ofstream aristas(nombreAristas);
+    aristas << "N;Variante;BytesPorArista;MBAristas;Orden\n";
+    for (int n : N) {
+        for (const Variante& variante : VARIANTES) {
+            if (variante.kruskal == kruskal_delaunay || variante.kruskal == boruvka_completo || variante.kruskal == boruvka_delaunay
+                || variante.kruskal == prim_dense || variante.kruskal == kruskal_knn) continue;
+
+            size_t bytes = bytes_por_arista(variante.config);
+            double mb = static_cast<double>(bytes) * n * (n - 1) / 2 / 1e6;
+            auto fase = perfiles[n].fases().find(variante.nombre + "/orden");
+            string orden = fase == perfiles[n].fases().end() ? "NA" : formatNumber(fase->second.segundos / 5.0);
+            aristas << n << ";" << variante.nombre << ";" << bytes << ";" << formatNumber(mb) << ";" << orden << "\n";
+
+            if (n == N.back()) {
+                cout << "   " << variante.nombre << ": " << bytes << " B/arista, " << mb << " MB, orden " << orden << (orden == "NA" ? "" : " s") << endl;
+            }
+        }
+    }
+    aristas.close();
+
+    cout << "Memoria y tiempo de orden de las aristas exportados a: " << nombreAristas << endl;
+
+    // Prim denso: tiempo, distancias por segundo y memoria extra contra la lista de aristas del grafo completo
+    string nombrePrim = regex_replace(nombreArchivo, regex("res(\\d+)\\.csv$"), "prim$1.csv");
+    ofstream prim(nombrePrim);
+    prim << "N;Kernel;Tiempo;DistanciasPorSegundo;MBExtra;MBAristas\n";
+    for (const auto& [n, kernel, segundos] : resultados_prim) {
+        double distancias = static_cast<double>(n) * (n - 1) / 2;
+        prim << n << ";" << Simd::nombre(kernel) << ";" << formatNumber(segundos) << ";" << formatNumber(distancias / segundos) << ";"
+             << formatNumber(static_cast<double>(prim_bytes_por_punto()) * n / 1e6) << ";"
+             << formatNumber(sizeof(Arista) * distancias / 1e6) << "\n";
+    }
+    prim.close();
+
+    cout << "Resultados de Prim denso exportados a: " << nombrePrim << endl;
+
+    // Kruskal sobre k vecinos contra el grafo completo
+    string nombreKnn = regex_replace(nombreArchivo, regex("res(\\d+)\\.csv$"), "knn$1.csv");
+    ofstream knn(nombreKnn);
+    knn << "N;Indice;Tiempo;MBExtra;Candidatas;Reparadas;Recargas;TiempoSortOpt;MBAristasCompleto\n";
+    for (const auto& [n, nombre, segundos, estadisticas, segundos_sort] : resultados_knn) {
+        knn << n << ";" << nombre << ";" << formatNumber(segundos) << ";" << formatNumber(estadisticas.bytes / 1e6) << ";"
+            << estadisticas.candidatas << ";" << estadisticas.reparadas << ";" << estadisticas.recargas << ";"
+            << (segundos_sort < 0 ? "NA" : formatNumber(segundos_sort)) << ";"
+            << formatNumber(sizeof(Arista) * (static_cast<double>(n) * (n - 1) / 2) / 1e6) << "\n";
+    }
+    knn.close();
+
+    cout << "Resultados de Kruskal sobre k vecinos exportados a: " << nombreKnn << endl;
+
+    // throughput de los kernels de distancias
+    string nombreDistancias = regex_replace(nombreArchivo, regex("res(\\d+)\\.csv$"), "distancias$1.csv");
+    ofstream distancias(nombreDistancias);
+    distancias << "N;Kernel;Tiempo;DistanciasPorSegundo\n";
+    for (const auto& [kernel, segundos] : resultados_distancias) {
+        distancias << N_DISTANCIAS << ";" << kernel << ";" << formatNumber(segundos) << ";"
+                   << formatNumber(static_cast<double>(N_DISTANCIAS) * N_DISTANCIAS / segundos) << "\n";
+    }
+    distancias.close();
+
+    cout << "Throughput de distancias exportado a: " << nombreDistancias << endl;
+
+    // tiempo por fase y speedup respecto de un hilo, por cantidad de hilos
+    string nombreParalelo = regex_replace(nombreArchivo, regex("res(\\d+)\\.csv$"), "paralelo$1.csv");
+    ofstream paralelo(nombreParalelo);
+    paralelo << "N;Variante;Hilos;Aristas;Orden;Total;Speedup\n";
+    map<string, double> base_paralelo;
+    for (const auto& [hilos, nombre, t_aristas, t_orden, total] : resultados_paralelo) {
+        if (hilos == 1) base_paralelo[nombre] = total;
+        paralelo << N_PARALELO << ";" << nombre << ";" << hilos << ";" << formatNumber(t_aristas) << ";"
+                 << formatNumber(t_orden) << ";" << formatNumber(total) << ";" << formatNumber(base_paralelo[nombre] / total) << "\n";
+    }
+    paralelo.close();
+
+    cout << "Escalamiento con hilos exportado a: " << nombreParalelo << endl;
+
+    // guarda csv con los contadores de cada fase (conjuntos, aristas, mst), junto al de resultados
+    string nombreFases = regex_replace(nombreArchivo, regex("res(\\d+)\\.csv$"), "fases$1.csv");
+    ofstream fases(nombreFases);
+    fases << "N;Variante;Fase;Tiempo;" << MuestraHW::encabezado_csv("") << "\n";
+    for (const auto& [n, perfil] : perfiles) {
+        for (const auto& [nombre, muestra] : perfil.fases()) {
+            size_t barra = nombre.find('/');
+            fases << n << ";" << nombre.substr(0, barra) << ";" << nombre.substr(barra + 1) << ";"
+                  << formatNumber(muestra.segundos / 5.0) << ";" << muestra.fila_csv(5) << "\n";
+        }
+    }
+    fases.close();
+
+    cout << "Contadores por fase exportados a: " << nombreFases << endl;
+    if (!perfiles.empty() && !perfiles.begin()->second.contadores().hardware_disponible()) {
+        cout << "Contadores de hardware no disponibles (sin PMU o perf_event_paranoid alto): sus columnas quedan en NA." << endl;
+    }
 }
@@ -0,0 +1,159 @@
+#include "contadores.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <linux/perf_event.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+    /** \brief Segundos del reloj monótono. */
+    double ahora() {
+        return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /** \brief Fallos de página menores y mayores del proceso según getrusage. */
+    uint64_t fallos_pagina_rusage() {
+        struct rusage uso;
+        if (getrusage(RUSAGE_SELF, &uso) != 0) return 0;
+        return static_cast<uint64_t>(uso.ru_minflt + uso.ru_majflt);
+    }
+
+    /**
+     *  \brief Abre un contador del proceso, solo en espacio de usuario (-1 si no está disponible).
+     *
+     *  Con inherit el contador incluye los hilos creados después de abrirlo (los trabajadores
+     *  de Paralelo::en_paralelo), igual que getrusage cuenta todo el proceso.
+     */
+    int abrir_contador(uint32_t tipo, uint64_t config) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = tipo;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    const char* NOMBRES[NUM_EVENTOS_HW] = {"Ciclos", "Instrucciones", "FallosLLC", "FallosSalto", "FallosPagina"};
+}
+
+void MuestraHW::sumar(const MuestraHW& otra) {
+    bool primera = segundos == 0;
+    for (size_t i = 0; i < NUM_EVENTOS_HW; ++i) {
+        valores[i] += otra.valores[i];
+        disponible[i] = (primera || disponible[i]) && otra.disponible[i];
+    }
+    segundos += otra.segundos;
+}
+
+string MuestraHW::encabezado_csv(const string& prefijo, char separador) {
+    string encabezado;
+    for (size_t i = 0; i < NUM_EVENTOS_HW; ++i) {
+        if (i > 0) encabezado += separador;
+        encabezado += prefijo + NOMBRES[i];
+    }
+    return encabezado;
+}
+
+string MuestraHW::fila_csv(size_t repeticiones, char separador) const {
+    ostringstream fila;
+    for (size_t i = 0; i < NUM_EVENTOS_HW; ++i) {
+        if (i > 0) fila << separador;
+        if (disponible[i]) {
+            fila << valores[i] / max<size_t>(repeticiones, 1);
+        } else {
+            fila << "NA";
+        }
+    }
+    return fila.str();
+}
+
+ContadoresHW::ContadoresHW() {
+    const pair<uint32_t, uint64_t> eventos[NUM_EVENTOS_HW] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    };
+    for (size_t i = 0; i < NUM_EVENTOS_HW; ++i) {
+        fds[i] = abrir_contador(eventos[i].first, eventos[i].second);
+    }
+    fallos_rusage = fds[static_cast<size_t>(EventoHW::FALLOS_PAGINA)] < 0;
+    inicio = ahora();
+}
+
+ContadoresHW::~ContadoresHW() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+bool ContadoresHW::disponible(EventoHW evento) const {
+    return fds[static_cast<size_t>(evento)] >= 0 || (evento == EventoHW::FALLOS_PAGINA && fallos_rusage);
+}
+
+bool ContadoresHW::hardware_disponible() const {
+    return disponible(EventoHW::CICLOS) && disponible(EventoHW::INSTRUCCIONES);
+}
+
+MuestraHW ContadoresHW::leer() const {
+    MuestraHW muestra;
+    for (size_t i = 0; i < NUM_EVENTOS_HW; ++i) {
+        if (fds[i] < 0) continue;
+
+        uint64_t datos[3];  // valor, tiempo habilitado, tiempo corriendo
+        if (read(fds[i], datos, sizeof(datos)) != static_cast<ssize_t>(sizeof(datos))) continue;
+        double escala = datos[2] > 0 && datos[2] < datos[1] ? static_cast<double>(datos[1]) / datos[2] : 1.0;
+        muestra.valores[i] = static_cast<uint64_t>(datos[0] * escala);
+        muestra.disponible[i] = true;
+    }
+    if (fallos_rusage) {
+        size_t fallos = static_cast<size_t>(EventoHW::FALLOS_PAGINA);
+        muestra.valores[fallos] = fallos_pagina_rusage();
+        muestra.disponible[fallos] = true;
+    }
+    muestra.segundos = ahora() - inicio;
+    return muestra;
+}
+
+void PerfilHW::iniciar(const string& fase) {
+    terminar();
+    actual_ = prefijo_ + fase;
+    abierta_ = contadores_.leer();
+}
+
+void PerfilHW::terminar() {
+    if (actual_.empty()) return;
+
+    MuestraHW ahora_ = contadores_.leer();
+    MuestraHW delta;
+    for (size_t i = 0; i < NUM_EVENTOS_HW; ++i) {
+        delta.valores[i] = ahora_.valores[i] - abierta_.valores[i];
+        delta.disponible[i] = ahora_.disponible[i] && abierta_.disponible[i];
+    }
+    delta.segundos = ahora_.segundos - abierta_.segundos;
+    fases_[actual_].sumar(delta);
+    actual_.clear();
+}
+
+void PerfilHW::limpiar() {
+    fases_.clear();
+    actual_.clear();
+}
+
+MuestraHW PerfilHW::total(const string& prefijo) const {
+    MuestraHW suma;
+    for (const auto& [nombre, muestra] : fases_) {
+        if (nombre.compare(0, prefijo.size(), prefijo) == 0) {
+            suma.sumar(muestra);
+        }
+    }
+    return suma;
+}
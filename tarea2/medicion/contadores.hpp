@@ -0,0 +1,177 @@
+/** \file contadores.hpp
+ *  \brief Contadores de hardware (perf_event_open) por fase de un benchmark.
+ */
+#ifndef CONTADORES_HPP
+#define CONTADORES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+using namespace std;
+
+/**
+ *  \enum EventoHW
+ *  \brief Contadores que se miden en cada fase.
+ */
+enum class EventoHW {
+    CICLOS,         ///< Ciclos de CPU
+    INSTRUCCIONES,  ///< Instrucciones retiradas
+    FALLOS_LLC,     ///< Fallos de la caché de último nivel
+    FALLOS_SALTO,   ///< Saltos mal predichos
+    FALLOS_PAGINA   ///< Fallos de página (con getrusage si perf_event_open no está disponible)
+};
+
+/** \brief Cantidad de contadores. */
+constexpr size_t NUM_EVENTOS_HW = static_cast<size_t>(EventoHW::FALLOS_PAGINA) + 1;
+
+/**
+ *  \struct MuestraHW
+ *  \brief Valores de los contadores en una fase (o acumulados en varias).
+ */
+struct MuestraHW {
+    uint64_t valores[NUM_EVENTOS_HW] = {};  ///< Valor de cada contador
+    bool disponible[NUM_EVENTOS_HW] = {};   ///< false si el contador no se pudo abrir
+    double segundos = 0;                    ///< Tiempo de pared
+
+    /**
+     *  \brief Valor de un contador.
+     *  \param evento Contador.
+     */
+    uint64_t valor(EventoHW evento) const { return valores[static_cast<size_t>(evento)]; }
+
+    /**
+     *  \brief Acumula otra muestra (un contador queda disponible solo si lo estaba en ambas).
+     *  \param otra Muestra a sumar.
+     */
+    void sumar(const MuestraHW& otra);
+
+    /**
+     *  \brief Encabezado CSV de los contadores.
+     *  \param prefijo Prefijo de cada columna (p. ej. "KruskalSortOpt_").
+     *  \param separador Separador de columnas.
+     */
+    static string encabezado_csv(const string& prefijo, char separador = ';');
+
+    /**
+     *  \brief Valores CSV de los contadores; "NA" si no se midieron.
+     *  \param repeticiones Divide cada valor (para promediar).
+     *  \param separador Separador de columnas.
+     */
+    string fila_csv(size_t repeticiones = 1, char separador = ';') const;
+};
+
+/**
+ *  \class ContadoresHW
+ *  \brief Contadores del proceso leídos con perf_event_open.
+ *
+ *  Se abren solo en espacio de usuario (basta perf_event_paranoid <= 2). Los que no
+ *  se pueden abrir (VM sin PMU, perf_event_paranoid = 3) quedan como no disponibles;
+ *  los fallos de página se toman entonces de getrusage. Los contadores se heredan, así que
+ *  incluyen los hilos que se creen mientras están abiertos.
+ */
+class ContadoresHW {
+private:
+    int fds[NUM_EVENTOS_HW];   ///< Descriptor de cada contador (-1: no disponible)
+    bool fallos_rusage;        ///< Fallos de página desde getrusage
+    double inicio;             ///< Instante de apertura
+
+public:
+    /** \brief Abre los contadores. */
+    ContadoresHW();
+
+    /** \brief Cierra los contadores. */
+    ~ContadoresHW();
+
+    ContadoresHW(const ContadoresHW&) = delete;
+    ContadoresHW& operator=(const ContadoresHW&) = delete;
+
+    /**
+     *  \brief Indica si un contador se puede medir.
+     *  \param evento Contador.
+     */
+    bool disponible(EventoHW evento) const;
+
+    /** \brief true si ciclos e instrucciones se pueden medir. */
+    bool hardware_disponible() const;
+
+    /**
+     *  \brief Valores acumulados desde la apertura (escalados si el kernel multiplexó).
+     *  \return Muestra con los valores actuales.
+     */
+    MuestraHW leer() const;
+};
+
+/**
+ *  \class PerfilHW
+ *  \brief Contadores separados por fase.
+ *
+ *  iniciar(fase) cierra la fase abierta y abre otra; las fases con el mismo nombre
+ *  se acumulan. El prefijo se antepone a cada nombre (p. ej. la variante de Kruskal).
+ */
+class PerfilHW {
+private:
+    ContadoresHW contadores_;
+    map<string, MuestraHW> fases_;
+    string prefijo_;
+    string actual_;
+    MuestraHW abierta_;
+
+public:
+    /**
+     *  \brief Fija el prefijo de las fases siguientes.
+     *  \param prefijo Prefijo (p. ej. "KruskalSortOpt/").
+     */
+    void fijar_prefijo(const string& prefijo) { prefijo_ = prefijo; }
+
+    /**
+     *  \brief Cierra la fase abierta (si hay) y abre una nueva.
+     *  \param fase Nombre de la fase (sin prefijo).
+     */
+    void iniciar(const string& fase);
+
+    /** \brief Cierra la fase abierta. */
+    void terminar();
+
+    /** \brief Olvida las fases medidas. */
+    void limpiar();
+
+    /** \brief Fases medidas, por nombre completo (prefijo + fase). */
+    const map<string, MuestraHW>& fases() const { return fases_; }
+
+    /**
+     *  \brief Suma de las fases cuyo nombre empieza con prefijo.
+     *  \param prefijo Prefijo (vacío: todas).
+     */
+    MuestraHW total(const string& prefijo = "") const;
+
+    /** \brief Contadores usados (para consultar disponibilidad). */
+    const ContadoresHW& contadores() const { return contadores_; }
+};
+
+/**
+ *  \class RegionHW
+ *  \brief Fase medida mientras el objeto existe; no hace nada si el perfil es nulo.
+ */
+class RegionHW {
+private:
+    PerfilHW* perfil;
+
+public:
+    /**
+     *  \param perfil Perfil donde se acumula (puede ser nullptr).
+     *  \param fase Nombre de la fase.
+     */
+    RegionHW(PerfilHW* perfil, const string& fase) : perfil(perfil) {
+        if (perfil) perfil->iniciar(fase);
+    }
+    ~RegionHW() {
+        if (perfil) perfil->terminar();
+    }
+
+    RegionHW(const RegionHW&) = delete;
+    RegionHW& operator=(const RegionHW&) = delete;
+};
+
+#endif
@@ -0,0 +1,224 @@
+#include "prim.hpp"
+#include <limits>
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    /**
+     *  \struct FueraDelArbol
+     *  \brief Puntos que aún no están en el árbol, en arreglos paralelos de largo restantes.
+     */
+    struct FueraDelArbol {
+        vector<double> x;       ///< Coordenada X
+        vector<double> y;       ///< Coordenada Y
+        vector<double> minima;  ///< Distancia (al cuadrado) mínima al árbol
+        vector<uint32_t> padre; ///< Punto del árbol a esa distancia
+        vector<uint32_t> id;    ///< Posición del punto en el vector de entrada
+        size_t restantes = 0;
+
+        /** \brief Saca el punto k cambiándolo por el último. */
+        void quitar(size_t k) {
+            --restantes;
+            x[k] = x[restantes];
+            y[k] = y[restantes];
+            minima[k] = minima[restantes];
+            padre[k] = padre[restantes];
+            id[k] = id[restantes];
+        }
+    };
+
+    /**
+     *  \brief Actualiza minima/padre con la distancia a (ux, uy) y devuelve la posición de la mínima.
+     *
+     *  Todas las versiones calculan (x - ux)² + (y - uy)² como PuntoUtils::getWeight; los
+     *  vectoriales con multiplicación y suma separadas (el Makefile compila con
+     *  -ffp-contract=off para que no se fusionen en FMA), así que el redondeo no cambia.
+     */
+    size_t actualizar_escalar(FueraDelArbol& f, double ux, double uy, uint32_t u) {
+        size_t mejor = 0;
+        double mejor_distancia = numeric_limits<double>::infinity();
+        for (size_t j = 0; j < f.restantes; ++j) {
+            double dx = f.x[j] - ux;
+            double dy = f.y[j] - uy;
+            double d = dx * dx + dy * dy;
+            if (d < f.minima[j]) {
+                f.minima[j] = d;
+                f.padre[j] = u;
+            }
+            if (f.minima[j] < mejor_distancia) {
+                mejor_distancia = f.minima[j];
+                mejor = j;
+            }
+        }
+        return mejor;
+    }
+
+#ifdef SIMD_X86
+    /** \brief Junta el mínimo de cada carril con el de la cola ya actualizada [cola, restantes). */
+    size_t combinar(const double* valores, const int64_t* indices, int carriles, FueraDelArbol& f, size_t cola) {
+        size_t mejor = f.restantes;
+        double mejor_distancia = numeric_limits<double>::infinity();
+        for (int c = 0; c < carriles; ++c) {
+            size_t i = static_cast<size_t>(indices[c]);
+            if (valores[c] < mejor_distancia || (valores[c] == mejor_distancia && i < mejor)) {
+                mejor_distancia = valores[c];
+                mejor = i;
+            }
+        }
+        for (size_t k = cola; k < f.restantes; ++k) {
+            if (f.minima[k] < mejor_distancia) {
+                mejor_distancia = f.minima[k];
+                mejor = k;
+            }
+        }
+        return mejor == f.restantes ? 0 : mejor;
+    }
+
+    __attribute__((target("avx2")))
+    size_t actualizar_avx2(FueraDelArbol& f, double ux, double uy, uint32_t u) {
+        const __m256d vux = _mm256_set1_pd(ux);
+        const __m256d vuy = _mm256_set1_pd(uy);
+        const __m128i vu = _mm_set1_epi32(static_cast<int>(u));
+        const __m256i pares = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0); // máscara de 64 a 32 bits por carril
+        __m256d mejor = _mm256_set1_pd(numeric_limits<double>::infinity());
+        __m256i mejor_indice = _mm256_setzero_si256();
+        __m256i indice = _mm256_setr_epi64x(0, 1, 2, 3);
+        const __m256i paso = _mm256_set1_epi64x(4);
+
+        size_t j = 0;
+        for (; j + 4 <= f.restantes; j += 4) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(&f.x[j]), vux);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(&f.y[j]), vuy);
+            __m256d d = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+
+            __m256d minima = _mm256_loadu_pd(&f.minima[j]);
+            __m256d menor = _mm256_cmp_pd(d, minima, _CMP_LT_OQ);
+            minima = _mm256_blendv_pd(minima, d, menor);
+            _mm256_storeu_pd(&f.minima[j], minima);
+
+            __m128i menor32 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(menor), pares));
+            __m128i padre = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&f.padre[j]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&f.padre[j]), _mm_blendv_epi8(padre, vu, menor32));
+
+            __m256d mejora = _mm256_cmp_pd(minima, mejor, _CMP_LT_OQ);
+            mejor = _mm256_blendv_pd(mejor, minima, mejora);
+            mejor_indice = _mm256_blendv_epi8(mejor_indice, indice, _mm256_castpd_si256(mejora));
+            indice = _mm256_add_epi64(indice, paso);
+        }
+        for (size_t k = j; k < f.restantes; ++k) {
+            double dx = f.x[k] - ux;
+            double dy = f.y[k] - uy;
+            double d = dx * dx + dy * dy;
+            if (d < f.minima[k]) {
+                f.minima[k] = d;
+                f.padre[k] = u;
+            }
+        }
+
+        alignas(32) double valores[4];
+        alignas(32) int64_t indices[4];
+        _mm256_store_pd(valores, mejor);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(indices), mejor_indice);
+        return combinar(valores, indices, 4, f, j);
+    }
+
+    __attribute__((target("avx512f,avx512vl")))
+    size_t actualizar_avx512(FueraDelArbol& f, double ux, double uy, uint32_t u) {
+        const __m512d vux = _mm512_set1_pd(ux);
+        const __m512d vuy = _mm512_set1_pd(uy);
+        const __m256i vu = _mm256_set1_epi32(static_cast<int>(u));
+        __m512d mejor = _mm512_set1_pd(numeric_limits<double>::infinity());
+        __m512i mejor_indice = _mm512_setzero_si512();
+        __m512i indice = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m512i paso = _mm512_set1_epi64(8);
+
+        size_t j = 0;
+        for (; j + 8 <= f.restantes; j += 8) {
+            __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(&f.x[j]), vux);
+            __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(&f.y[j]), vuy);
+            __m512d d = _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy));
+
+            __m512d minima = _mm512_loadu_pd(&f.minima[j]);
+            __mmask8 menor = _mm512_cmp_pd_mask(d, minima, _CMP_LT_OQ);
+            minima = _mm512_mask_blend_pd(menor, minima, d);
+            _mm512_storeu_pd(&f.minima[j], minima);
+
+            __m256i padre = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&f.padre[j]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&f.padre[j]), _mm256_mask_blend_epi32(menor, padre, vu));
+
+            __mmask8 mejora = _mm512_cmp_pd_mask(minima, mejor, _CMP_LT_OQ);
+            mejor = _mm512_mask_blend_pd(mejora, mejor, minima);
+            mejor_indice = _mm512_mask_blend_epi64(mejora, mejor_indice, indice);
+            indice = _mm512_add_epi64(indice, paso);
+        }
+        for (size_t k = j; k < f.restantes; ++k) {
+            double dx = f.x[k] - ux;
+            double dy = f.y[k] - uy;
+            double d = dx * dx + dy * dy;
+            if (d < f.minima[k]) {
+                f.minima[k] = d;
+                f.padre[k] = u;
+            }
+        }
+
+        alignas(64) double valores[8];
+        alignas(64) int64_t indices[8];
+        _mm512_store_pd(valores, mejor);
+        _mm512_store_si512(indices, mejor_indice);
+        return combinar(valores, indices, 8, f, j);
+    }
+#endif
+
+    size_t actualizar(KernelSimd kernel, FueraDelArbol& f, double ux, double uy, uint32_t u) {
+#ifdef SIMD_X86
+        if (kernel == KernelSimd::AVX512) return actualizar_avx512(f, ux, uy, u);
+        if (kernel == KernelSimd::AVX2) return actualizar_avx2(f, ux, uy, u);
+#endif
+        return actualizar_escalar(f, ux, uy, u);
+    }
+}
+
+vector<Arista> prim_dense(vector<Punto*>& puntos, PerfilHW* perfil, const ConfigKruskal& config) {
+    KernelSimd kernel = Simd::resolver(config.simd);
+    size_t n = puntos.size();
+    vector<Arista> mst;
+    if (n < 2) return mst;
+
+    // el punto 0 empieza en el árbol; el resto queda afuera con distancia infinita
+    FueraDelArbol fuera;
+    {
+        RegionHW region(perfil, "coordenadas");
+        fuera.restantes = n - 1;
+        fuera.x.resize(n - 1);
+        fuera.y.resize(n - 1);
+        fuera.minima.assign(n - 1, numeric_limits<double>::infinity());
+        fuera.padre.assign(n - 1, 0);
+        fuera.id.resize(n - 1);
+        for (size_t i = 1; i < n; ++i) {
+            fuera.x[i - 1] = puntos[i]->getX();
+            fuera.y[i - 1] = puntos[i]->getY();
+            fuera.id[i - 1] = static_cast<uint32_t>(i);
+        }
+    }
+
+    RegionHW region(perfil, "mst");
+    mst.reserve(n - 1);
+    uint32_t u = 0;
+    double ux = puntos[0]->getX();
+    double uy = puntos[0]->getY();
+    while (fuera.restantes > 0) {
+        size_t k = actualizar(kernel, fuera, ux, uy, u);
+        u = fuera.id[k];
+        ux = fuera.x[k];
+        uy = fuera.y[k];
+        mst.emplace_back(puntos[fuera.padre[k]], puntos[u]);
+        fuera.quitar(k);
+    }
+    return mst;
+}
+
+size_t prim_bytes_por_punto() {
+    return 3 * sizeof(double) + 2 * sizeof(uint32_t);
+}
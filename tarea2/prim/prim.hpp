@@ -0,0 +1,30 @@
+/** \file prim.hpp
+ *  \brief Algoritmo de Prim denso para el grafo euclidiano completo, sin lista de aristas.
+ */
+#ifndef PRIM_HPP
+#define PRIM_HPP
+
+#include "../kruskal/kruskal.hpp"
+#include <vector>
+
+/**
+ *  \brief Prim con arreglo de distancias mínimas: O(n²) tiempo, O(n) memoria.
+ *
+ *  Los puntos fuera del árbol se guardan compactados al inicio de arreglos contiguos
+ *  (x, y, distancia mínima al árbol, punto del árbol que la da). En cada paso un solo
+ *  recorrido secuencial actualiza las distancias con el último punto agregado y busca
+ *  el mínimo (argmin); el elegido se saca cambiándolo por el último. Las distancias se
+ *  calculan al vuelo, con el kernel vectorizado de config.simd.
+ *
+ *  Memoria extra: 32 bytes por punto, en vez de las n(n-1)/2 aristas de las variantes con sort o heap.
+ *  \param puntos Vector de punteros a puntos del grafo.
+ *  \param perfil Perfil de contadores por fase ("coordenadas", "mst"); nullptr para no medir.
+ *  \param config Opciones de implementación (solo se usa simd).
+ *  \return Vector de aristas que forman el MST, en el orden en que Prim las agrega.
+ */
+vector<Arista> prim_dense(vector<Punto*>& puntos, PerfilHW* perfil = nullptr, const ConfigKruskal& config = ConfigKruskal());
+
+/** \brief Bytes de memoria extra por punto de prim_dense. */
+size_t prim_bytes_por_punto();
+
+#endif